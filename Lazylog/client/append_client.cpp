@@ -1,51 +1,28 @@
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
-#include <grpcpp/grpcpp.h>
-#include "sequencer.grpc.pb.h"
+#include <vector>
+#include "coordinator.h"
+#include "lazylog_client.h"
 #include "sequencer.pb.h"
+#include "uds_target.h"
 
-using grpc::Channel;
-using grpc::ClientContext;
-using grpc::Status;
-using sequencer::SequencerService;
 using sequencer::AppendRequest;
-using sequencer::AppendReply;
 
-class AppendClient {
-public:
-    AppendClient(std::shared_ptr<Channel> channel)
-      : stub_(SequencerService::NewStub(channel)) {}
-
-    void Append(int client_id, int req_id, const std::string &record) 
-    {
-        AppendRequest req;
-        req.set_client_id(client_id);
-        req.set_req_id(req_id);
-        req.set_record(record);
-
-        AppendReply reply;
-        ClientContext ctx;
-
-        Status st = stub_->Append(&ctx, req, &reply);
-
-        if (st.ok()) {
-            std::cout << "Append success=" << reply.success()
-                      << " gp=" << reply.global_pos()
-                      << " msg=" << reply.message() << "\n";
-        } else {
-            std::cerr << "RPC failed: " << st.error_message() << "\n";
-        }
-    }
-
-private:
-    std::unique_ptr<SequencerService::Stub> stub_;
-};
-
-int main(int argc, char** argv) 
+// append_client: one Append, sent to whichever replica leads. Any replica
+// will do as a seed: a follower's rejection names the leader, and with
+// --zk the leader is looked up in /lazylog/election when no seed answers.
+//
+//   append_client --seeds=127.0.0.1:50051,127.0.0.1:50052 --record=hello
+//   append_client --zk=127.0.0.1:2181 --record=hello
+int main(int argc, char** argv)
 {
-    std::string server_addr = "127.0.0.1:50051";
+    std::vector<std::string> seeds;
+    std::string zk_addr;
     int client_id = 1;
+    int req_id = 1;
+    uint64_t log_id = 0;
     std::string record = "default_record";
 
     // Parse CLI flags
@@ -53,20 +30,49 @@ int main(int argc, char** argv)
         std::string a = argv[i];
 
         if (a.rfind("--server_addr=", 0) == 0) {
-            server_addr = a.substr(14);      // OK
+            seeds.push_back(a.substr(14));
+        } else if (a.rfind("--seeds=", 0) == 0) {
+            std::stringstream list(a.substr(8));
+            std::string addr;
+            while (std::getline(list, addr, ',')) {
+                if (!addr.empty()) seeds.push_back(addr);
+            }
+        } else if (a.rfind("--uds=", 0) == 0) {
+            seeds.push_back(uds_target(a.substr(6)));   // same-host sequencer
+        } else if (a.rfind("--zk=", 0) == 0) {
+            zk_addr = a.substr(5);
         } else if (a.rfind("--id=", 0) == 0) {
-            client_id = std::stoi(a.substr(5));   // OK
+            client_id = std::stoi(a.substr(5));
+        } else if (a.rfind("--req_id=", 0) == 0) {
+            req_id = std::stoi(a.substr(9));
+        } else if (a.rfind("--log_id=", 0) == 0) {
+            log_id = std::stoull(a.substr(9));
         } else if (a.rfind("--record=", 0) == 0) {
             record = a.substr(9);
         }
     }
 
-    AppendClient c(
-        grpc::CreateChannel(server_addr, grpc::InsecureChannelCredentials())
-    );
+    std::unique_ptr<Coordinator> coord;
+    if (!zk_addr.empty()) {
+        coord = make_zk_coordinator(zk_addr, 10000);
+        if (!coord) std::cerr << "cannot connect to ZooKeeper at " << zk_addr << "\n";
+    }
+    if (seeds.empty() && !coord) seeds.push_back("127.0.0.1:50051");
 
-    // Single append call
-    c.Append(client_id, 1, record);
+    LazylogClient c(seeds, coord.get());
+    AppendRequest req;
+    req.set_client_id(client_id);
+    req.set_req_id(req_id);
+    req.set_record(record);
+    req.set_log_id(log_id);
 
-    return 0;
+    LazylogClient::Result r = c.Append(req);
+    if (r.ok) {
+        std::cout << "Append success=1 gp=" << r.pos << " leader=" << r.leader
+                  << " redirects=" << r.redirects << " msg=" << r.message << "\n";
+    } else {
+        std::cerr << "Append failed: " << r.message << " (last asked " << r.leader << ")\n";
+    }
+    if (coord) coord->close();
+    return r.ok ? 0 : 1;
 }
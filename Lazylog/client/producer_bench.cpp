@@ -0,0 +1,146 @@
+// producer_bench: append throughput / latency through the Producer library
+// (include/producer.h), i.e. batched and pipelined on one AppendStream per
+// producer.
+//
+// Each producer thread keeps up to --outstanding appends unanswered,
+// closed-loop. Latency is from append() to its future becoming ready, so
+// it includes the linger time.
+//
+//   producer_bench --seeds=127.0.0.1:50051,127.0.0.1:50052 --producers=2 --outstanding=4096
+//                  --linger_ms=2 --batch_records=512 --in_flight=4 --duration_s=10
+#include <chrono>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "hdr_histogram.h"
+#include "producer.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchConfig {
+    std::vector<std::string> seeds{"127.0.0.1:50051"};
+    int producers = 1;
+    int outstanding = 4096;
+    int linger_ms = 2;
+    int batch_records = 512;
+    int in_flight = 4;
+    int duration_s = 10;
+    int warmup_s = 1;
+    int record_size = 64;
+    int client_id_base = 6000;
+    uint64_t log_id = 0;
+};
+
+struct ProducerResult {
+    int64_t ok = 0;
+    int64_t errors = 0;
+    std::string last_error;
+    HdrHistogram latency;
+};
+
+static void run_producer(const BenchConfig &cfg, int id, Clock::time_point measure_from,
+                         Clock::time_point end, ProducerResult *res) {
+    Producer p(cfg.seeds, cfg.client_id_base + id, cfg.log_id);
+    p.linger_ms = cfg.linger_ms;
+    p.batch_records = cfg.batch_records;
+    p.max_in_flight = cfg.in_flight;
+    std::string record(cfg.record_size, 'x');
+    std::deque<std::pair<Clock::time_point, std::future<Producer::Result>>> sent;
+
+    auto complete = [&](std::pair<Clock::time_point, std::future<Producer::Result>> &s) {
+        Producer::Result r = s.second.get();
+        if (s.first < measure_from || s.first >= end) return;
+        if (r.ok) {
+            res->ok++;
+            res->latency.record(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - s.first).count());
+        } else {
+            res->errors++;
+            res->last_error = r.message;
+        }
+    };
+    while (Clock::now() < end) {
+        while ((int)sent.size() < cfg.outstanding) {
+            Clock::time_point now = Clock::now();
+            sent.emplace_back(now, p.append(record));
+        }
+        // answers come back in append order
+        complete(sent.front());
+        sent.pop_front();
+        while (!sent.empty() &&
+               sent.front().second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            complete(sent.front());
+            sent.pop_front();
+        }
+    }
+    for (auto &s : sent) complete(s);
+}
+
+int main(int argc, char **argv) {
+    BenchConfig cfg;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        if (a.rfind("--seeds=", 0) == 0) {
+            cfg.seeds.clear();
+            std::stringstream list(a.substr(8));
+            std::string addr;
+            while (std::getline(list, addr, ',')) {
+                if (!addr.empty()) cfg.seeds.push_back(addr);
+            }
+        }
+        else if (a.rfind("--producers=", 0) == 0) cfg.producers = std::stoi(a.substr(12));
+        else if (a.rfind("--outstanding=", 0) == 0) cfg.outstanding = std::stoi(a.substr(14));
+        else if (a.rfind("--linger_ms=", 0) == 0) cfg.linger_ms = std::stoi(a.substr(12));
+        else if (a.rfind("--batch_records=", 0) == 0) cfg.batch_records = std::stoi(a.substr(16));
+        else if (a.rfind("--in_flight=", 0) == 0) cfg.in_flight = std::stoi(a.substr(12));
+        else if (a.rfind("--duration_s=", 0) == 0) cfg.duration_s = std::stoi(a.substr(13));
+        else if (a.rfind("--warmup_s=", 0) == 0) cfg.warmup_s = std::stoi(a.substr(11));
+        else if (a.rfind("--record_size=", 0) == 0) cfg.record_size = std::stoi(a.substr(14));
+        else if (a.rfind("--client_id_base=", 0) == 0) cfg.client_id_base = std::stoi(a.substr(17));
+        else if (a.rfind("--log_id=", 0) == 0) cfg.log_id = std::stoull(a.substr(9));
+        else {
+            std::cerr << "unknown flag " << a << "\n";
+            return 2;
+        }
+    }
+    if (cfg.seeds.empty() || cfg.producers < 1 || cfg.outstanding < 1 || cfg.batch_records < 1 ||
+        cfg.in_flight < 1 || cfg.record_size < 0) {
+        std::cerr << "invalid configuration\n";
+        return 2;
+    }
+
+    Clock::time_point measure_from = Clock::now() + std::chrono::seconds(cfg.warmup_s);
+    Clock::time_point end = measure_from + std::chrono::seconds(cfg.duration_s);
+    std::vector<ProducerResult> results(cfg.producers);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < cfg.producers; ++i) {
+        threads.emplace_back(run_producer, std::cref(cfg), i, measure_from, end, &results[i]);
+    }
+    for (auto &t : threads) t.join();
+
+    HdrHistogram all;
+    int64_t ok = 0, errors = 0;
+    std::string last_error;
+    for (auto &r : results) {
+        all.merge(r.latency);
+        ok += r.ok;
+        errors += r.errors;
+        if (!r.last_error.empty()) last_error = r.last_error;
+    }
+    double ops = ok / (double)cfg.duration_s;
+    std::cout << "[BENCH] producers=" << cfg.producers << " outstanding=" << cfg.outstanding
+              << " linger_ms=" << cfg.linger_ms << " batch_records=" << cfg.batch_records
+              << " in_flight=" << cfg.in_flight << " record=" << cfg.record_size << "B\n";
+    std::cout << "[BENCH] ops=" << ok << " errors=" << errors << " throughput=" << (int64_t)ops
+              << " ops/s (" << (ops * cfg.record_size / (1024 * 1024)) << " MiB/s)\n";
+    if (!last_error.empty()) std::cout << "[BENCH] last error: " << last_error << "\n";
+    std::cout << "[BENCH] latency_us p50=" << all.value_at_percentile(50)
+              << " p99=" << all.value_at_percentile(99)
+              << " p99.9=" << all.value_at_percentile(99.9)
+              << " max=" << all.max() << " mean=" << (int64_t)all.mean() << "\n";
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,328 @@
+// seq_bench: end-to-end Append throughput / latency benchmark.
+//
+// Drives N connections x M in-flight Appends against one sequencer, either
+// closed-loop (each completion immediately issues the next request) or
+// open-loop (requests are scheduled at a fixed total rate; latency is
+// measured from the scheduled send time so queueing behind a slow server
+// is not hidden). Latencies go into HDR histograms; results are printed
+// and optionally written as one JSON object for tracking across commits.
+//
+//   seq_bench --server_addr=127.0.0.1:50051 --connections=4 --inflight=16
+//             --duration_s=10 --record_size=64-4096 --json=out.json
+//   seq_bench --mode=open --rate=20000 ...
+//   seq_bench --shards=127.0.0.1:50061,127.0.0.1:50071 ...   (records to shards,
+//             metadata-only appends to the sequencer)
+//   seq_bench --logs=1000 ...   (appends spread over named logs 1..1000)
+//   seq_bench --uds=/tmp/lazylog.sock ...   (same-host sequencer started
+//             with --uds; "@name" for an abstract socket)
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <random>
+#include <grpcpp/grpcpp.h>
+#include "sequencer.grpc.pb.h"
+#include "sequencer.pb.h"
+#include "shard.grpc.pb.h"
+#include "hdr_histogram.h"
+#include "uds_target.h"
+
+using grpc::ClientContext;
+using grpc::Status;
+using sequencer::SequencerService;
+using sequencer::AppendRequest;
+using sequencer::AppendReply;
+using Clock = std::chrono::steady_clock;
+
+struct BenchConfig {
+    std::string server_addr = "127.0.0.1:50051";
+    std::string mode = "closed";    // closed | open
+    int connections = 1;
+    int inflight = 1;               // per connection
+    double rate = 1000;             // open-loop: total requests/s
+    int duration_s = 10;
+    int warmup_s = 1;
+    int min_record = 64;            // bytes, drawn uniformly in [min, max]
+    int max_record = 64;
+    int client_id_base = 1000;
+    std::string json_path;          // "-" = stdout
+    std::string label;              // free-form tag, e.g. a commit hash
+    // shard primaries; when set each record is written to one of them
+    // (round robin by req_id) and the sequencer gets only its metadata
+    std::vector<std::string> shards;
+    // > 0: spread appends over named logs 1..logs (round robin by req_id)
+    // instead of the default log
+    int logs = 0;
+};
+
+// One connection: its own channel (no subchannel sharing), stub, and
+// latency histogram. Completions arrive on gRPC threads, hence the mutex.
+struct Connection {
+    int id = 0;
+    std::unique_ptr<SequencerService::Stub> stub;
+    std::vector<std::unique_ptr<shard::ShardService::Stub>> shard_stubs;
+    std::mutex mu;
+    std::condition_variable cv;
+    int outstanding = 0;
+    int64_t next_req_id = 0;
+    HdrHistogram hist;
+    int64_t ok = 0;
+    int64_t errors = 0;
+    int64_t bytes = 0;
+    std::mt19937 rng;
+};
+
+struct Call {
+    ClientContext ctx;
+    AppendRequest req;
+    AppendReply reply;
+    Clock::time_point intended;
+    int size = 0;
+
+    // sharded mode: the record write that precedes the Append
+    ClientContext shard_ctx;
+    shard::WriteRequest write;
+    shard::WriteReply write_reply;
+};
+
+static std::atomic<bool> g_stop{false};
+static Clock::time_point g_measure_from;
+
+static void issue(const BenchConfig &cfg, Connection *c, Clock::time_point intended);
+
+static void on_done(const BenchConfig &cfg, Connection *c, Call *call, Status st) {
+    Clock::time_point now = Clock::now();
+    bool closed = (cfg.mode == "closed");
+    bool again;
+    {
+        std::lock_guard<std::mutex> lk(c->mu);
+        if (call->intended >= g_measure_from) {
+            if (st.ok() && call->reply.success()) {
+                c->hist.record(std::chrono::duration_cast<std::chrono::microseconds>(now - call->intended).count());
+                c->ok++;
+                c->bytes += call->size;
+            } else {
+                c->errors++;
+            }
+        }
+        // closed loop hands the slot straight to the next request
+        again = closed && !g_stop.load();
+        if (!again) c->outstanding--;
+    }
+    delete call;
+    if (again) issue(cfg, c, Clock::now());
+    else c->cv.notify_one();
+}
+
+// the caller has already taken an in-flight slot (outstanding++)
+static void issue(const BenchConfig &cfg, Connection *c, Clock::time_point intended) {
+    Call *call = new Call();
+    call->intended = intended;
+    int size;
+    {
+        std::lock_guard<std::mutex> lk(c->mu);
+        call->req.set_req_id((int)c->next_req_id++);
+        size = std::uniform_int_distribution<int>(cfg.min_record, cfg.max_record)(c->rng);
+    }
+    call->size = size;
+    call->req.set_client_id(cfg.client_id_base + c->id);
+    if (cfg.logs > 0) call->req.set_log_id(1 + call->req.req_id() % cfg.logs);
+    if (c->shard_stubs.empty()) {
+        call->req.set_record(std::string(size, 'x'));
+        c->stub->async()->Append(&call->ctx, &call->req, &call->reply,
+                                 [&cfg, c, call](Status st) { on_done(cfg, c, call, st); });
+        return;
+    }
+
+    // record bytes to a shard first; the Append then carries metadata only
+    int s = call->req.req_id() % (int)c->shard_stubs.size();
+    call->write.set_client_id(call->req.client_id());
+    call->write.set_req_id(call->req.req_id());
+    call->write.set_log_id(call->req.log_id());
+    call->write.set_record(std::string(size, 'x'));
+    c->shard_stubs[s]->async()->Write(&call->shard_ctx, &call->write, &call->write_reply,
+        [&cfg, c, call, s](Status st) {
+            if (st.ok() && !call->write_reply.ok()) {
+                st = Status(grpc::StatusCode::UNAVAILABLE, call->write_reply.message());
+            }
+            if (!st.ok()) {
+                on_done(cfg, c, call, st);
+                return;
+            }
+            call->req.set_shard(s + 1);
+            call->req.set_record_size(call->size);
+            c->stub->async()->Append(&call->ctx, &call->req, &call->reply,
+                                     [&cfg, c, call](Status st) { on_done(cfg, c, call, st); });
+        });
+}
+
+// Open-loop pacer for one connection: its share of the total rate, issued
+// on schedule. When all M slots are busy the request waits for a slot but
+// keeps its scheduled time, so the wait shows up as latency.
+static void pace(const BenchConfig &cfg, Connection *c, Clock::time_point end) {
+    auto interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(cfg.connections / cfg.rate));
+    Clock::time_point next = Clock::now();
+    while (next < end) {
+        std::this_thread::sleep_until(next);
+        {
+            std::unique_lock<std::mutex> lk(c->mu);
+            c->cv.wait(lk, [&] { return c->outstanding < cfg.inflight; });
+            c->outstanding++;
+        }
+        issue(cfg, c, next);
+        next += interval;
+    }
+}
+
+// quotes and backslashes escaped, control characters dropped (as trace.cpp)
+static std::string json_escape(const std::string &s) {
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        if ((unsigned char)c < 0x20) continue;
+        out += c;
+    }
+    return out;
+}
+
+static bool parse_args(int argc, char **argv, BenchConfig &cfg) {
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        if (a.rfind("--server_addr=", 0) == 0) cfg.server_addr = a.substr(14);
+        else if (a.rfind("--uds=", 0) == 0) cfg.server_addr = uds_target(a.substr(6));
+        else if (a.rfind("--mode=", 0) == 0) cfg.mode = a.substr(7);
+        else if (a.rfind("--connections=", 0) == 0) cfg.connections = std::stoi(a.substr(14));
+        else if (a.rfind("--inflight=", 0) == 0) cfg.inflight = std::stoi(a.substr(11));
+        else if (a.rfind("--rate=", 0) == 0) cfg.rate = std::stod(a.substr(7));
+        else if (a.rfind("--duration_s=", 0) == 0) cfg.duration_s = std::stoi(a.substr(13));
+        else if (a.rfind("--warmup_s=", 0) == 0) cfg.warmup_s = std::stoi(a.substr(11));
+        else if (a.rfind("--client_id_base=", 0) == 0) cfg.client_id_base = std::stoi(a.substr(17));
+        else if (a.rfind("--json=", 0) == 0) cfg.json_path = a.substr(7);
+        else if (a.rfind("--label=", 0) == 0) cfg.label = a.substr(8);
+        else if (a.rfind("--logs=", 0) == 0) cfg.logs = std::stoi(a.substr(7));
+        else if (a.rfind("--shards=", 0) == 0) {
+            std::stringstream list(a.substr(9));
+            std::string addr;
+            while (std::getline(list, addr, ',')) {
+                if (!addr.empty()) cfg.shards.push_back(addr);
+            }
+        }
+        else if (a.rfind("--record_size=", 0) == 0) {
+            // N or MIN-MAX
+            std::string v = a.substr(14);
+            size_t dash = v.find('-');
+            cfg.min_record = std::stoi(v.substr(0, dash));
+            cfg.max_record = dash == std::string::npos ? cfg.min_record : std::stoi(v.substr(dash + 1));
+        } else {
+            std::cerr << "unknown flag " << a << "\n";
+            return false;
+        }
+    }
+    if ((cfg.mode != "closed" && cfg.mode != "open") || cfg.connections < 1 || cfg.inflight < 1 ||
+        cfg.min_record < 0 || cfg.max_record < cfg.min_record || cfg.rate <= 0) {
+        std::cerr << "invalid configuration\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    BenchConfig cfg;
+    if (!parse_args(argc, argv, cfg)) return 2;
+
+    std::vector<std::unique_ptr<Connection>> conns;
+    for (int i = 0; i < cfg.connections; ++i) {
+        grpc::ChannelArguments args;
+        args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);   // one connection each
+        auto ch = grpc::CreateCustomChannel(cfg.server_addr, grpc::InsecureChannelCredentials(), args);
+        conns.emplace_back(new Connection());
+        conns.back()->id = i;
+        conns.back()->stub = SequencerService::NewStub(ch);
+        for (const auto &addr : cfg.shards) {
+            conns.back()->shard_stubs.push_back(shard::ShardService::NewStub(
+                grpc::CreateCustomChannel(addr, grpc::InsecureChannelCredentials(), args)));
+        }
+        conns.back()->rng.seed(i + 1);
+    }
+
+    Clock::time_point start = Clock::now();
+    g_measure_from = start + std::chrono::seconds(cfg.warmup_s);
+    Clock::time_point end = g_measure_from + std::chrono::seconds(cfg.duration_s);
+
+    std::vector<std::thread> pacers;
+    if (cfg.mode == "closed") {
+        for (auto &c : conns) {
+            for (int k = 0; k < cfg.inflight; ++k) {
+                {
+                    std::lock_guard<std::mutex> lk(c->mu);
+                    c->outstanding++;
+                }
+                issue(cfg, c.get(), Clock::now());
+            }
+        }
+        std::this_thread::sleep_until(end);
+        g_stop.store(true);
+    } else {
+        for (auto &c : conns) pacers.emplace_back(pace, std::cref(cfg), c.get(), end);
+        for (auto &t : pacers) t.join();
+        g_stop.store(true);
+    }
+
+    // drain; completions after `end` still count (they were sent in time)
+    for (auto &c : conns) {
+        std::unique_lock<std::mutex> lk(c->mu);
+        c->cv.wait(lk, [&] { return c->outstanding == 0; });
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - g_measure_from).count();
+
+    HdrHistogram all;
+    int64_t ok = 0, errors = 0, bytes = 0;
+    for (auto &c : conns) {
+        all.merge(c->hist);
+        ok += c->ok;
+        errors += c->errors;
+        bytes += c->bytes;
+    }
+    double ops = ok / elapsed;
+
+    std::cout << "[BENCH] mode=" << cfg.mode << " connections=" << cfg.connections
+              << " inflight=" << cfg.inflight << " record=" << cfg.min_record << "-" << cfg.max_record << "B"
+              << (cfg.mode == "open" ? " target_rate=" + std::to_string((int64_t)cfg.rate) : "")
+              << (cfg.shards.empty() ? "" : " shards=" + std::to_string(cfg.shards.size()))
+              << (cfg.logs > 0 ? " logs=" + std::to_string(cfg.logs) : "") << "\n";
+    std::cout << "[BENCH] ops=" << ok << " errors=" << errors << " throughput=" << (int64_t)ops
+              << " ops/s (" << (bytes / elapsed / (1024 * 1024)) << " MiB/s)\n";
+    std::cout << "[BENCH] latency_us p50=" << all.value_at_percentile(50)
+              << " p99=" << all.value_at_percentile(99)
+              << " p99.9=" << all.value_at_percentile(99.9)
+              << " max=" << all.max() << " mean=" << (int64_t)all.mean() << "\n";
+
+    if (!cfg.json_path.empty()) {
+        std::ostringstream js;
+        js << "{\"label\":\"" << json_escape(cfg.label) << "\",\"mode\":\"" << cfg.mode << "\""
+           << ",\"connections\":" << cfg.connections << ",\"inflight\":" << cfg.inflight
+           << ",\"target_rate\":" << (cfg.mode == "open" ? cfg.rate : 0)
+           << ",\"shards\":" << cfg.shards.size() << ",\"logs\":" << cfg.logs << ",\"record_min\":" << cfg.min_record << ",\"record_max\":" << cfg.max_record
+           << ",\"duration_s\":" << elapsed << ",\"ops\":" << ok << ",\"errors\":" << errors
+           << ",\"throughput_ops\":" << ops << ",\"throughput_mib\":" << bytes / elapsed / (1024 * 1024)
+           << ",\"p50_us\":" << all.value_at_percentile(50) << ",\"p99_us\":" << all.value_at_percentile(99)
+           << ",\"p999_us\":" << all.value_at_percentile(99.9) << ",\"max_us\":" << all.max()
+           << ",\"mean_us\":" << all.mean() << "}\n";
+        if (cfg.json_path == "-") {
+            std::cout << js.str();
+        } else {
+            std::ofstream f(cfg.json_path);
+            f << js.str();
+        }
+    }
+    return errors > 0 && ok == 0 ? 1 : 0;
+}
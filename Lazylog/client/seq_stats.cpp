@@ -0,0 +1,96 @@
+// seq_stats: print a replica's GetStats counters, latencies and log state.
+//
+//   seq_stats --server_addr=127.0.0.1:50051
+//   seq_stats --server_addr=127.0.0.1:50051 --interval_s=1 --count=30   (rates per second)
+//   seq_stats --json                                                     (one JSON object per sample)
+//
+// Rates are computed by the server over the time since its previous
+// GetStats call, so with --interval_s they are per-interval rates.
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <grpcpp/grpcpp.h>
+#include <google/protobuf/util/json_util.h>
+#include "sequencer.grpc.pb.h"
+#include "sequencer.pb.h"
+
+using grpc::ClientContext;
+using grpc::Status;
+using sequencer::SequencerService;
+using sequencer::StatsRequest;
+using sequencer::StatsReply;
+
+static void print_text(const StatsReply &s) {
+    std::cout << "[STATS] " << s.addr() << (s.is_leader() ? " leader" : " follower")
+              << (s.sealed() ? " sealed" : "") << " view=" << s.view()
+              << " uptime_s=" << s.uptime_s() << "\n";
+    std::cout << "[STATS] appends=" << s.appends_total() << " bytes=" << s.append_bytes_total()
+              << " failures=" << s.append_failures_total() << " | " << (int64_t)s.appends_per_sec()
+              << " appends/s " << (int64_t)s.bytes_per_sec() << " B/s over " << s.window_s() << " s\n";
+    std::cout << "[STATS] in_flight entries=" << s.inflight_entries() << " bytes=" << s.inflight_bytes()
+              << " overload_rejects=" << s.overload_rejects_total()
+              << " quota_rejects=" << s.quota_rejects_total() << " quota_clients=" << s.quota_clients() << "\n";
+    std::cout << "[STATS] next_global_pos=" << s.next_global_pos()
+              << " last_ordered_gp=" << s.last_ordered_gp() << " stable_gp=" << s.stable_gp()
+              << " log_entries=" << s.log_entries() << " log_bytes=" << s.log_bytes()
+              << " local_idx=[" << s.log_first_index() << "," << s.log_last_index() << "]\n";
+    for (const auto &l : s.latency()) {
+        std::cout << "[STATS] latency " << l.stage() << ": n=" << l.count() << " p50=" << l.p50_us()
+                  << " p90=" << l.p90_us() << " p99=" << l.p99_us() << " p99.9=" << l.p999_us()
+                  << " max=" << l.max_us() << " us\n";
+    }
+    std::cout << "[STATS] gc runs=" << s.gc_runs() << " entries=" << s.gc_entries_total() << "\n";
+    for (const auto &f : s.followers()) {
+        std::cout << "[STATS] follower " << f.addr() << ": lag=" << f.lag_entries()
+                  << " rtt_us=" << f.rtt_us() << " rtt_p99_us=" << f.rtt_p99_us()
+                  << " last_ack_age_ms=" << f.last_ack_age_ms() << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string server_addr = "127.0.0.1:50051";
+    int interval_s = 0;
+    int count = 1;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        if (a.rfind("--server_addr=", 0) == 0) server_addr = a.substr(14);
+        else if (a.rfind("--interval_s=", 0) == 0) interval_s = std::stoi(a.substr(13));
+        else if (a.rfind("--count=", 0) == 0) count = std::stoi(a.substr(8));
+        else if (a == "--json") json = true;
+        else {
+            std::cerr << "unknown flag " << a << "\n";
+            return 2;
+        }
+    }
+    if (interval_s > 0 && count == 1) count = 0;   // 0 = until interrupted
+
+    auto stub = SequencerService::NewStub(
+        grpc::CreateChannel(server_addr, grpc::InsecureChannelCredentials()));
+
+    for (int n = 0; count == 0 || n < count; ++n) {
+        if (n > 0) std::this_thread::sleep_for(std::chrono::seconds(interval_s));
+        StatsReply reply;
+        ClientContext ctx;
+        ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+        Status st = stub->GetStats(&ctx, StatsRequest(), &reply);
+        if (!st.ok()) {
+            std::cerr << "GetStats failed: " << st.error_message() << "\n";
+            return 1;
+        }
+        if (json) {
+            std::string out;
+            google::protobuf::util::JsonPrintOptions opts;
+            opts.always_print_primitive_fields = true;
+            google::protobuf::util::MessageToJsonString(reply, &out, opts);
+            std::cout << out << "\n";
+        } else {
+            print_text(reply);
+        }
+        std::cout.flush();
+    }
+    return 0;
+}
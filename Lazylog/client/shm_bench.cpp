@@ -0,0 +1,136 @@
+// shm_bench: append throughput / latency through the shared-memory rings
+// of a sequencer on this host (started with --shm_name=NAME).
+//
+// Each producer thread attaches its own ring and keeps up to --inflight
+// appends outstanding, closed-loop. Latency is from queueing a record to
+// polling its ack.
+//
+//   shm_bench --shm_name=lazylog --producers=2 --inflight=256 --duration_s=10 --record_size=64
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "hdr_histogram.h"
+#include "shm_ring.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchConfig {
+    std::string shm_name;
+    int producers = 1;
+    int inflight = 256;
+    int duration_s = 10;
+    int warmup_s = 1;
+    int record_size = 64;
+    int client_id_base = 5000;
+    uint64_t log_id = 0;
+};
+
+struct ProducerResult {
+    int64_t ok = 0;
+    int64_t errors = 0;
+    int last_status = 0;
+    HdrHistogram latency;
+};
+
+static void run_producer(const BenchConfig &cfg, int id, Clock::time_point measure_from,
+                         Clock::time_point end, ProducerResult *res) {
+    ShmProducer p;
+    if (!p.attach(cfg.shm_name)) {
+        std::cerr << "[BENCH] producer " << id << ": no free ring in " << cfg.shm_name << "\n";
+        res->errors++;
+        return;
+    }
+    std::string record(cfg.record_size, 'x');
+    std::deque<Clock::time_point> sent;   // acks come back in append order
+    std::vector<ShmProducer::Ack> acks(cfg.inflight);
+    int client_id = cfg.client_id_base + id;
+    int req_id = 0;
+
+    while (true) {
+        Clock::time_point now = Clock::now();
+        bool stopping = now >= end;
+        while (!stopping && (int)sent.size() < cfg.inflight &&
+               p.try_append(client_id, req_id, record.data(), record.size(), cfg.log_id)) {
+            req_id++;
+            sent.push_back(now);
+        }
+        if (stopping && sent.empty()) break;
+        size_t n = p.poll(acks.data(), acks.size());
+        if (n == 0) {
+            if (!p.server_up()) break;
+            continue;
+        }
+        now = Clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            bool measured = sent.front() >= measure_from && sent.front() < end;
+            if (measured) {
+                if (acks[i].status == shm_ring::OK || acks[i].status == shm_ring::DUPLICATE) {
+                    res->ok++;
+                    res->latency.record(
+                        std::chrono::duration_cast<std::chrono::microseconds>(now - sent.front()).count());
+                } else {
+                    res->errors++;
+                    res->last_status = acks[i].status;
+                }
+            }
+            sent.pop_front();
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    BenchConfig cfg;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        if (a.rfind("--shm_name=", 0) == 0) cfg.shm_name = a.substr(11);
+        else if (a.rfind("--producers=", 0) == 0) cfg.producers = std::stoi(a.substr(12));
+        else if (a.rfind("--inflight=", 0) == 0) cfg.inflight = std::stoi(a.substr(11));
+        else if (a.rfind("--duration_s=", 0) == 0) cfg.duration_s = std::stoi(a.substr(13));
+        else if (a.rfind("--warmup_s=", 0) == 0) cfg.warmup_s = std::stoi(a.substr(11));
+        else if (a.rfind("--record_size=", 0) == 0) cfg.record_size = std::stoi(a.substr(14));
+        else if (a.rfind("--client_id_base=", 0) == 0) cfg.client_id_base = std::stoi(a.substr(17));
+        else if (a.rfind("--log_id=", 0) == 0) cfg.log_id = std::stoull(a.substr(9));
+        else {
+            std::cerr << "unknown flag " << a << "\n";
+            return 2;
+        }
+    }
+    if (cfg.shm_name.empty() || cfg.producers < 1 || cfg.inflight < 1 || cfg.record_size < 0) {
+        std::cerr << "invalid configuration (--shm_name is required)\n";
+        return 2;
+    }
+
+    Clock::time_point measure_from = Clock::now() + std::chrono::seconds(cfg.warmup_s);
+    Clock::time_point end = measure_from + std::chrono::seconds(cfg.duration_s);
+    std::vector<ProducerResult> results(cfg.producers);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < cfg.producers; ++i) {
+        threads.emplace_back(run_producer, std::cref(cfg), i, measure_from, end, &results[i]);
+    }
+    for (auto &t : threads) t.join();
+
+    HdrHistogram all;
+    int64_t ok = 0, errors = 0;
+    int last_status = 0;
+    for (auto &r : results) {
+        all.merge(r.latency);
+        ok += r.ok;
+        errors += r.errors;
+        if (r.last_status) last_status = r.last_status;
+    }
+    double ops = ok / (double)cfg.duration_s;
+    std::cout << "[BENCH] shm producers=" << cfg.producers << " inflight=" << cfg.inflight
+              << " record=" << cfg.record_size << "B\n";
+    std::cout << "[BENCH] ops=" << ok << " errors=" << errors << " throughput=" << (int64_t)ops
+              << " ops/s (" << (ops * cfg.record_size / (1024 * 1024)) << " MiB/s)\n";
+    if (last_status) std::cout << "[BENCH] last error: " << shm_ring::status_message(last_status) << "\n";
+    std::cout << "[BENCH] latency_us p50=" << all.value_at_percentile(50)
+              << " p99=" << all.value_at_percentile(99)
+              << " p99.9=" << all.value_at_percentile(99.9)
+              << " max=" << all.max() << " mean=" << (int64_t)all.mean() << "\n";
+    return errors ? 1 : 0;
+}
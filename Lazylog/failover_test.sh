@@ -8,6 +8,10 @@ PORTS=(50051 50052 50053)
 POST_KILL_TIMEOUT=50
 POLL_INTERVAL=1
 
+# Write-unavailability budget: kill -> first successful append on a survivor
+MAX_UNAVAILABLE_MS=${MAX_UNAVAILABLE_MS:-1000}
+APPEND_CLIENT=${APPEND_CLIENT:-build/append_client}
+
 echo "====================================================="
 echo "[FAILOVER TEST] Starting"
 echo "Log directory: $LOG_DIR"
@@ -107,12 +111,25 @@ if [[ -z "$pid" ]]; then
 fi
 
 echo "[KILL] Killing leader process $pid (replica $leader_idx / port $leader_port)..."
+kill_ns=$(date +%s%N)
 kill -9 "$pid" || true
 echo "Leader process $pid killed."
 
-# Wait small time for ZooKeeper session to be noticed / ephemeral znode to disappear
-echo "[WAIT] Sleeping 2s to let ZooKeeper detect session loss..."
-sleep 2
+# Probe the survivors with appends until one succeeds; the gap between the
+# kill and that success is the end-to-end write-unavailability window.
+echo "[PROBE] Appending to survivors until a new leader accepts writes..."
+unavailable_ms=""
+probe_deadline_ns=$(( kill_ns + POST_KILL_TIMEOUT * 1000000000 ))
+while [[ -z "$unavailable_ms" ]] && (( $(date +%s%N) < probe_deadline_ns )); do
+    for i in "${!PORTS[@]}"; do
+        [[ "$i" == "$leader_idx" ]] && continue
+        out=$("$APPEND_CLIENT" --server_addr=127.0.0.1:${PORTS[$i]} --id=9000 --record=failover_probe 2>&1 || true)
+        if [[ "$out" == *"success=1"* ]]; then
+            unavailable_ms=$(( ($(date +%s%N) - kill_ns) / 1000000 ))
+            break
+        fi
+    done
+done
 
 echo "====================================================="
 echo "[STEP] Detecting new leader (will wait up to ${POST_KILL_TIMEOUT}s)..."
@@ -163,3 +180,23 @@ else
     echo "  - Maybe the killed process did not actually die or ephemeral znode still present"
 fi
 echo "====================================================="
+
+status=0
+if [[ -n "$new_leader_idx" ]]; then
+    # detection / election / seal breakdown logged by the new leader
+    grep "\[FAILOVER\]" "$LOG_DIR/replica_${new_leader_idx}.log" | tail -n 2 || true
+else
+    status=1
+fi
+
+if [[ -z "$unavailable_ms" ]]; then
+    echo "❌ ERROR: no survivor accepted an append within ${POST_KILL_TIMEOUT}s."
+    status=1
+elif (( unavailable_ms >= MAX_UNAVAILABLE_MS )); then
+    echo "❌ Write unavailability ${unavailable_ms} ms exceeds budget ${MAX_UNAVAILABLE_MS} ms."
+    status=1
+else
+    echo "✅ Write unavailability ${unavailable_ms} ms (budget ${MAX_UNAVAILABLE_MS} ms)."
+fi
+echo "====================================================="
+exit $status
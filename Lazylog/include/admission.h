@@ -0,0 +1,108 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// Admission control for the leader's append path. An append holds its
+// entries and record bytes from admission until its replication ended
+// (acked by every follower, or failed). One that would take the total past
+// max_entries or max_bytes waits up to wait_ms for others to finish and is
+// refused after that. Nothing outstanding admits any append, however
+// large, so one oversized record is not refused forever. 0 = no limit.
+//
+// Admission and release are a few atomic adds; only a waiting append
+// takes the mutex.
+class AdmissionControl {
+public:
+    int64_t max_entries = 0;
+    int64_t max_bytes = 0;
+    int wait_ms = 0;
+
+    // holds entries/bytes admitted by its constructor until destroyed
+    class Ticket {
+    public:
+        Ticket(AdmissionControl &ac, int64_t entries, int64_t bytes)
+            : ac_(ac), entries_(entries), bytes_(bytes), start_(std::chrono::steady_clock::now()),
+              ok_(ac.acquire(entries, bytes)) {}
+        ~Ticket() {
+            if (!ok_) return;
+            auto held = std::chrono::steady_clock::now() - start_;
+            ac_.release(entries_, bytes_,
+                        std::chrono::duration_cast<std::chrono::microseconds>(held).count());
+        }
+        Ticket(const Ticket &) = delete;
+        Ticket &operator=(const Ticket &) = delete;
+
+        explicit operator bool() const { return ok_; }
+
+    private:
+        AdmissionControl &ac_;
+        int64_t entries_, bytes_;
+        std::chrono::steady_clock::time_point start_;
+        bool ok_;
+    };
+
+    bool acquire(int64_t entries, int64_t bytes) {
+        if (try_acquire(entries, bytes, true)) return true;
+        if (wait_ms <= 0) return false;
+        auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(wait_ms);
+        std::unique_lock<std::mutex> lk(mu_);
+        waiters_++;
+        bool ok = cv_.wait_until(lk, until, [&] { return try_acquire(entries, bytes, false); });
+        waiters_--;
+        return ok;
+    }
+
+    // held_us: time since acquire, for retry_after_ms()
+    void release(int64_t entries, int64_t bytes, int64_t held_us) {
+        int64_t h = hold_us_.load(std::memory_order_relaxed);
+        hold_us_.store(h + (held_us - h) / 8, std::memory_order_relaxed);   // a hint; races are fine
+        entries_.fetch_sub(entries);
+        bytes_.fetch_sub(bytes);
+        // a waiter registers under mu_ before it tests, so it either sees
+        // the room made here or is woken
+        if (waiters_.load() > 0) {
+            std::lock_guard<std::mutex> lk(mu_);
+            cv_.notify_all();
+        }
+    }
+
+    // how long a refused client should wait before retrying: about the
+    // time an admitted append is held, by when its room is free again
+    int64_t retry_after_ms() const {
+        return std::max<int64_t>(1, (hold_us_.load(std::memory_order_relaxed) + 999) / 1000);
+    }
+
+    int64_t entries() const { return entries_.load(std::memory_order_relaxed); }
+    int64_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+
+private:
+    // adds first and takes it back when over: a waiter testing meanwhile
+    // may see too little room, so a taker outside mu_ wakes the waiters
+    // after taking back (waiters test one at a time, under mu_)
+    bool try_acquire(int64_t entries, int64_t bytes, bool wake) {
+        int64_t e = entries_.fetch_add(entries);
+        int64_t b = bytes_.fetch_add(bytes);
+        if (e == 0 || ((max_entries <= 0 || e + entries <= max_entries) &&
+                       (max_bytes <= 0 || b + bytes <= max_bytes))) {
+            return true;
+        }
+        entries_.fetch_sub(entries);
+        bytes_.fetch_sub(bytes);
+        if (wake && waiters_.load() > 0) {
+            std::lock_guard<std::mutex> lk(mu_);
+            cv_.notify_all();
+        }
+        return false;
+    }
+
+    std::atomic<int64_t> entries_{0};
+    std::atomic<int64_t> bytes_{0};
+    std::atomic<int64_t> hold_us_{0};
+    std::atomic<int> waiters_{0};
+    std::mutex mu_;
+    std::condition_variable cv_;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <google/protobuf/arena.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/message_allocator.h>
+
+// Message allocator for callback-API unary handlers: each call's request
+// and response live on one protobuf Arena, which goes away in a single
+// free when gRPC releases the call. The first block is sized for a typical
+// append so small calls need no further arena allocation.
+template <class Request, class Response>
+class ArenaMessageAllocator : public grpc::MessageAllocator<Request, Response> {
+public:
+    explicit ArenaMessageAllocator(size_t start_block_size = 1024)
+        : start_block_size_(start_block_size) {}
+
+    grpc::MessageHolder<Request, Response>* AllocateMessages() override {
+        return new Holder(start_block_size_);
+    }
+
+    // The handler gets its request as const; it is this allocator's until
+    // the call is released, so a handler may move fields out of it instead
+    // of copying them.
+    static Request* mutable_request(grpc::CallbackServerContext* context) {
+        return static_cast<grpc::MessageHolder<Request, Response>*>(
+            context->GetRpcAllocatorState())->request();
+    }
+
+private:
+    class Holder : public grpc::MessageHolder<Request, Response> {
+    public:
+        explicit Holder(size_t start_block_size) : arena_(options(start_block_size)) {
+            this->set_request(google::protobuf::Arena::CreateMessage<Request>(&arena_));
+            this->set_response(google::protobuf::Arena::CreateMessage<Response>(&arena_));
+        }
+        void Release() override { delete this; }
+
+    private:
+        static google::protobuf::ArenaOptions options(size_t start_block_size) {
+            google::protobuf::ArenaOptions o;
+            o.start_block_size = start_block_size;
+            return o;
+        }
+        google::protobuf::Arena arena_;
+    };
+
+    size_t start_block_size_;
+};
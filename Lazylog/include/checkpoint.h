@@ -0,0 +1,12 @@
+#pragma once
+#include <string>
+#include "sequencer_internal.pb.h"
+
+// Durable checkpoints of the sequencer metadata (Sequencer::take_checkpoint
+// builds one, restore_checkpoint installs it). A checkpoint is written to
+// path.tmp, fsync'd and renamed over path, so a crash at any point leaves
+// either the previous checkpoint or the new one, never a torn file.
+bool write_checkpoint_file(const std::string &path, const sequencer_internal::Checkpoint &ckpt);
+
+// false if there is no checkpoint at path or it cannot be parsed
+bool read_checkpoint_file(const std::string &path, sequencer_internal::Checkpoint *ckpt);
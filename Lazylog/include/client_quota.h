@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Per-client_id append quotas: records per second and record bytes per
+// second, each a token bucket holding burst_ms worth of its rate. A bucket
+// is kept as the time it would be full again (GCRA), one atomic per
+// bucket, so taking tokens is a compare-and-swap and never a lock.
+//
+// Clients live in a fixed open-addressed table allocated by configure();
+// a slot is claimed by the client's first append and kept, at 40 bytes a
+// slot. Clients that find no free slot near their hash share one overflow
+// bucket with the default rates.
+class ClientQuotas {
+public:
+    struct Rates {
+        int64_t records_per_s = 0;   // 0 = unlimited
+        int64_t bytes_per_s = 0;
+    };
+
+    // before serving. Quotas are off unless a default rate or an override
+    // is set. slots is rounded up to a power of two.
+    void configure(Rates defaults, int burst_ms, size_t slots,
+                   std::unordered_map<int32_t, Rates> overrides);
+    // "ID:RECORDS_PER_S:BYTES_PER_S,..." (0 = unlimited); false if malformed
+    static bool parse_overrides(const std::string &spec, std::unordered_map<int32_t, Rates> *out);
+
+    bool enabled() const { return enabled_; }
+
+    // take records/bytes tokens from client_id's buckets; 0 if taken, else
+    // the microseconds until they would be (and nothing is taken). A
+    // request larger than a whole bucket passes once the bucket is full.
+    int64_t take(int32_t client_id, int64_t records, int64_t bytes);
+    // return what take() took for a request that was refused after all
+    void give_back(int32_t client_id, int64_t records, int64_t bytes);
+
+    size_t clients() const { return used_.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<int64_t> key{0};   // client_id + 1; 0 = free, -1 = being claimed
+        std::atomic<int64_t> records_per_s{0};
+        std::atomic<int64_t> bytes_per_s{0};
+        std::atomic<int64_t> records_full_ns{0};   // steady time the bucket is full again
+        std::atomic<int64_t> bytes_full_ns{0};
+    };
+
+    Slot &slot_for(int32_t client_id);
+    // 0 if n tokens were taken from the bucket, else ns until they would be
+    int64_t take_from(std::atomic<int64_t> &full_ns, int64_t rate, int64_t n, int64_t now);
+    // the bucket may briefly look fuller than it was
+    static void put_back(std::atomic<int64_t> &full_ns, int64_t rate, int64_t n);
+
+    bool enabled_ = false;
+    Rates defaults_;
+    int64_t burst_ns_ = 0;
+    std::unordered_map<int32_t, Rates> overrides_;   // read-only once serving
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_ = 0;
+    Slot overflow_;
+    std::atomic<size_t> used_{0};
+};
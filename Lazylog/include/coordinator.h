@@ -0,0 +1,54 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Coordination service behind replica registration, leader election and
+// membership: the small subset of ZooKeeper the sequencer uses. One
+// Coordinator is one session; its ephemeral nodes live as long as it does.
+//
+// ZkCoordinator (make_zk_coordinator) talks to a real ensemble;
+// InMemoryCoordinator (memory_coordinator.h) keeps the tree in process so
+// clusters can be tested without a ZooKeeper server.
+
+enum class CoordRc { OK, NO_NODE, NODE_EXISTS, NOT_EMPTY, SESSION_EXPIRED, ERROR };
+
+enum class CoordEvent { CREATED, DELETED, CHANGED, CHILD, SESSION_EXPIRED };
+
+// One-shot watch; runs on the coordinator's event thread, so it must only
+// signal (set a flag, notify a condition variable) and never block.
+using CoordWatch = std::function<void(CoordEvent event, const std::string &path)>;
+
+const char *coord_rc_str(CoordRc rc);
+
+class Coordinator {
+public:
+    enum CreateFlags { PERSISTENT = 0, EPHEMERAL = 1, SEQUENTIAL = 2 };
+
+    virtual ~Coordinator() = default;
+
+    // SEQUENTIAL appends a 10-digit counter to path; created_path receives
+    // the full name of the new node
+    virtual CoordRc create(const std::string &path, const std::string &data, int flags,
+                           std::string *created_path = nullptr) = 0;
+    virtual CoordRc remove(const std::string &path) = 0;
+    virtual CoordRc get(const std::string &path, std::string *data) = 0;
+
+    // exists / children arm a one-shot watch when watch is non-null
+    // (exists also watches a node that does not exist yet, like ZooKeeper)
+    virtual CoordRc exists(const std::string &path, CoordWatch watch = nullptr) = 0;
+    virtual CoordRc children(const std::string &path, std::vector<std::string> *out,
+                             CoordWatch watch = nullptr) = 0;
+
+    virtual bool session_expired() = 0;
+    // fn runs once on the event thread when the session expires
+    virtual void on_session_expired(std::function<void()> fn) = 0;
+
+    // end the session now; its ephemeral nodes are deleted and no callback
+    // runs after close() returns
+    virtual void close() = 0;
+};
+
+// nullptr if the ZooKeeper client could not be created
+std::unique_ptr<Coordinator> make_zk_coordinator(const std::string &hosts, int session_timeout_ms);
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+// Minimal HDR (high dynamic range) histogram: log-linear buckets that keep
+// `significant_figures` decimal digits of precision across the whole
+// [1, highest] range with a fixed, small footprint. Same bucket layout as
+// HdrHistogram_c, without the dependency. Not thread-safe; record into one
+// histogram per thread and merge().
+class HdrHistogram {
+public:
+    explicit HdrHistogram(int64_t highest = 60LL * 1000 * 1000, int significant_figures = 3) {
+        int64_t largest_single_unit = 2 * (int64_t)std::pow(10, significant_figures);
+        int sub_bucket_count_magnitude = (int)std::ceil(std::log2((double)largest_single_unit));
+        sub_bucket_half_count_magnitude_ = std::max(sub_bucket_count_magnitude, 1) - 1;
+        sub_bucket_count_ = 1LL << (sub_bucket_half_count_magnitude_ + 1);
+        sub_bucket_half_count_ = sub_bucket_count_ / 2;
+        sub_bucket_mask_ = sub_bucket_count_ - 1;
+
+        int64_t smallest_untrackable = sub_bucket_count_;
+        int buckets = 1;
+        while (smallest_untrackable <= highest) {
+            smallest_untrackable <<= 1;
+            buckets++;
+        }
+        counts_.assign((size_t)(buckets + 1) * sub_bucket_half_count_, 0);
+        highest_ = highest;
+    }
+
+    void record(int64_t value) {
+        if (value < 0) value = 0;
+        if (value > highest_) value = highest_;
+        counts_[index_of(value)]++;
+        total_++;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        sum_ += (double)value;
+    }
+
+    void merge(const HdrHistogram &o) {
+        for (size_t i = 0; i < counts_.size() && i < o.counts_.size(); ++i) counts_[i] += o.counts_[i];
+        total_ += o.total_;
+        min_ = std::min(min_, o.min_);
+        max_ = std::max(max_, o.max_);
+        sum_ += o.sum_;
+    }
+
+    // value at percentile p in [0, 100]; reports the highest value that is
+    // equivalent (same bucket) to the true sample, like HdrHistogram
+    int64_t value_at_percentile(double p) const {
+        if (total_ == 0) return 0;
+        int64_t target = (int64_t)std::ceil(p / 100.0 * (double)total_);
+        target = std::max<int64_t>(target, 1);
+        int64_t seen = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if (seen >= target) return std::min(highest_equivalent((int64_t)i), max_);
+        }
+        return max_;
+    }
+
+    int64_t count() const { return total_; }
+    int64_t min() const { return total_ ? min_ : 0; }
+    int64_t max() const { return total_ ? max_ : 0; }
+    double mean() const { return total_ ? sum_ / (double)total_ : 0.0; }
+
+private:
+    int sub_bucket_half_count_magnitude_;
+    int64_t sub_bucket_count_;
+    int64_t sub_bucket_half_count_;
+    int64_t sub_bucket_mask_;
+    int64_t highest_;
+    std::vector<int64_t> counts_;
+    int64_t total_ = 0;
+    int64_t min_ = INT64_MAX;
+    int64_t max_ = 0;
+    double sum_ = 0.0;
+
+    size_t index_of(int64_t value) const {
+        int pow2ceiling = 64 - __builtin_clzll((uint64_t)(value | sub_bucket_mask_));
+        int bucket = pow2ceiling - (sub_bucket_half_count_magnitude_ + 1);
+        int64_t sub_bucket = value >> bucket;
+        return (size_t)(((int64_t)(bucket + 1) << sub_bucket_half_count_magnitude_) +
+                        (sub_bucket - sub_bucket_half_count_));
+    }
+
+    int64_t highest_equivalent(int64_t index) const {
+        int bucket = (int)(index >> sub_bucket_half_count_magnitude_) - 1;
+        int64_t sub_bucket = (index & (sub_bucket_half_count_ - 1)) + sub_bucket_half_count_;
+        if (bucket < 0) {
+            sub_bucket -= sub_bucket_half_count_;
+            bucket = 0;
+        }
+        int64_t lowest = sub_bucket << bucket;
+        return lowest + (1LL << bucket) - 1;
+    }
+};
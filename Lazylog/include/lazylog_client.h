@@ -0,0 +1,66 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "sequencer.grpc.pb.h"
+
+class Coordinator;
+
+// retry-after-ms a leader sent with RESOURCE_EXHAUSTED (admission.h), 0 if none
+int64_t retry_after_hint(const grpc::ClientContext &ctx);
+
+// Append client that finds the leader by itself. It caches the last
+// replica that accepted an append, follows the leader hint a rejecting
+// replica returns (AppendReply.leader_addr), and, when no replica it can
+// reach names a leader, asks the coordinator for the holder of the lowest
+// /lazylog/election node. After a failover the first append typically
+// costs one extra round trip: to the old leader's successor named in the
+// rejection, or to the replica ZooKeeper names. Thread-safe.
+class LazylogClient {
+public:
+    // seeds: replicas to ask when no leader is known, tried in turn;
+    // coord (optional, not owned) enables discovery through ZooKeeper
+    explicit LazylogClient(std::vector<std::string> seeds, Coordinator *coord = nullptr);
+
+    struct Result {
+        bool ok = false;
+        int64_t pos = -1;        // AppendReply.global_pos
+        std::string message;
+        std::string leader;      // replica that answered last
+        int redirects = 0;       // hints followed
+        int throttled = 0;       // RESOURCE_EXHAUSTED replies waited out
+    };
+
+    // Append with req, retried on replicas that cannot serve it until one
+    // does, a leader rejects it for good (e.g. too many logs), or
+    // timeout_ms passed. A replica not yet asked in this call is asked at
+    // once; asking one again waits backoff_ms first, an overloaded leader
+    // its retry-after hint. Retries reuse (client_id, req_id), so an
+    // append ordered before a failover keeps its position.
+    Result Append(const sequencer::AppendRequest &req);
+
+    // leader cached from the last successful append ("" = none)
+    std::string leader();
+    // replica holding the lowest /lazylog/election node, "" if unknown
+    std::string discover_leader();
+    // next replica to try once failed did not serve: ZooKeeper's answer,
+    // else the next seed (also used by Producer to route its stream)
+    std::string next_candidate(const std::string &failed);
+
+    int rpc_timeout_ms = 2000;
+    int timeout_ms = 5000;
+    int backoff_ms = 50;
+
+private:
+    std::shared_ptr<sequencer::SequencerService::Stub> stub_for(const std::string &addr);
+
+    std::vector<std::string> seeds_;
+    Coordinator *coord_;
+
+    std::mutex mu_;
+    std::string leader_;
+    size_t next_seed_ = 0;
+    std::unordered_map<std::string, std::shared_ptr<sequencer::SequencerService::Stub>> stubs_;
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include "memory_coordinator.h"
+#include "sequencer_server.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// N sequencer replicas in one process, coordinated through an
+// InMemoryEnsemble instead of ZooKeeper, each on its own ephemeral
+// loopback port. Replicas start as followers and elect a leader exactly as
+// a deployed cluster does. Fault hooks act on single replicas so tests can
+// script crashes, stalls, slow links and session loss deterministically.
+class LocalCluster {
+public:
+    // base supplies timing knobs (heartbeat_ms, lease_ms, ...); role, port,
+    // followers and zk_addr are set per replica, and base.uds and
+    // base.shm_name get the replica's index as a "-<i>" suffix
+    explicit LocalCluster(int replicas, const ServerConfig &base = ServerConfig());
+    ~LocalCluster();
+
+    // start every replica; false if one could not bind a port
+    bool Start();
+
+    int size() const { return (int)replicas_.size(); }
+    std::string address(int i) const { return replicas_[i].addr; }
+    bool alive(int i) const { return replicas_[i].server != nullptr; }
+    // null while replica i is killed
+    SequencerServer *server(int i) { return replicas_[i].server.get(); }
+
+    // index of the unsealed leader once exactly one replica serves appends,
+    // or -1 after timeout_ms. A deposed leader that has not noticed yet
+    // (e.g. still paused) can be left out with other_than.
+    int WaitForLeader(int timeout_ms, int other_than = -1);
+    // WaitForLeader, then until every other live replica has joined the
+    // leader's follower set (joins are asynchronous, see join_follower)
+    int WaitForFollowers(int timeout_ms);
+
+    // crash: RPCs fail, heartbeats stop, the replica's session ends
+    void Kill(int i);
+    // bring a killed replica back on its old port with an empty log
+    bool Restart(int i);
+    // stall incoming RPCs and outgoing heartbeats without losing the session
+    void Pause(int i);
+    void Resume(int i);
+    // extra latency on every RPC replica i serves
+    void Delay(int i, int ms);
+    // expire replica i's coordinator session; the process keeps running
+    void ExpireSession(int i);
+
+    InMemoryEnsemble &ensemble() { return *ensemble_; }
+
+private:
+    struct Replica {
+        std::unique_ptr<SequencerServer> server;
+        int64_t session = 0;
+        int port = 0;
+        std::string addr;
+    };
+
+    ServerConfig base_;
+    std::shared_ptr<InMemoryEnsemble> ensemble_;
+    std::vector<Replica> replicas_;
+
+    bool start_replica(int i);
+};
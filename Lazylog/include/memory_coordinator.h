@@ -0,0 +1,118 @@
+#pragma once
+#include "coordinator.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+// In-process stand-in for a ZooKeeper ensemble: one znode tree shared by any
+// number of sessions (connect()), with ephemeral / sequential nodes and
+// one-shot watches delivered on a single event thread, as the ZK C client
+// does. Lets LocalCluster run several replicas in one process with no
+// external service, and lets tests expire a session on demand.
+class InMemoryEnsemble : public std::enable_shared_from_this<InMemoryEnsemble> {
+public:
+    static std::shared_ptr<InMemoryEnsemble> create();
+    ~InMemoryEnsemble();
+
+    // open a new session
+    std::unique_ptr<Coordinator> connect();
+
+    // expire a session as if it had stopped heartbeating: its ephemeral
+    // nodes are deleted and its watches and expiry listener fire
+    void expire(int64_t session);
+
+private:
+    friend class InMemoryCoordinator;
+
+    struct Node {
+        std::string data;
+        int64_t owner = 0;   // session of an ephemeral node, 0 = persistent
+        int64_t next_seq = 0;
+    };
+    struct Watch {
+        int64_t session;
+        CoordWatch fn;
+    };
+    struct Event {
+        int64_t session;
+        CoordWatch fn;
+        std::function<void()> expired_fn;
+        CoordEvent type;
+        std::string path;
+    };
+
+    InMemoryEnsemble();
+
+    std::mutex mu_;
+    std::map<std::string, Node> nodes_;
+    std::map<std::string, std::vector<Watch>> exists_watches_;
+    std::map<std::string, std::vector<Watch>> child_watches_;
+    int64_t next_session_ = 1;
+    std::set<int64_t> expired_;
+    std::set<int64_t> closed_;
+    std::map<int64_t, std::function<void()>> expiry_listeners_;
+
+    std::deque<Event> events_;
+    std::condition_variable events_cv_;
+    bool stop_ = false;
+    std::mutex dispatch_mu_;   // held while a callback runs; see end_session
+    std::thread dispatcher_;
+
+    void dispatch_loop();
+    void fire_locked(std::map<std::string, std::vector<Watch>> &table, const std::string &path,
+                     CoordEvent type);
+    void delete_node_locked(const std::string &path);
+    void end_session(int64_t session, bool expired);
+    bool has_children_locked(const std::string &path);
+    bool dead_locked(int64_t session) const;
+    static std::string parent_of(const std::string &path);
+
+    CoordRc create(int64_t session, const std::string &path, const std::string &data, int flags,
+                   std::string *created_path);
+    CoordRc remove(int64_t session, const std::string &path);
+    CoordRc get(int64_t session, const std::string &path, std::string *data);
+    CoordRc exists(int64_t session, const std::string &path, CoordWatch watch);
+    CoordRc children(int64_t session, const std::string &path, std::vector<std::string> *out,
+                     CoordWatch watch);
+    bool session_expired(int64_t session);
+    void on_session_expired(int64_t session, std::function<void()> fn);
+};
+
+class InMemoryCoordinator : public Coordinator {
+public:
+    InMemoryCoordinator(std::shared_ptr<InMemoryEnsemble> ensemble, int64_t session)
+        : ensemble_(std::move(ensemble)), session_(session) {}
+    ~InMemoryCoordinator() override { close(); }
+
+    int64_t session_id() const { return session_; }
+
+    CoordRc create(const std::string &path, const std::string &data, int flags,
+                   std::string *created_path = nullptr) override {
+        return ensemble_->create(session_, path, data, flags, created_path);
+    }
+    CoordRc remove(const std::string &path) override { return ensemble_->remove(session_, path); }
+    CoordRc get(const std::string &path, std::string *data) override {
+        return ensemble_->get(session_, path, data);
+    }
+    CoordRc exists(const std::string &path, CoordWatch watch = nullptr) override {
+        return ensemble_->exists(session_, path, std::move(watch));
+    }
+    CoordRc children(const std::string &path, std::vector<std::string> *out,
+                     CoordWatch watch = nullptr) override {
+        return ensemble_->children(session_, path, out, std::move(watch));
+    }
+    bool session_expired() override { return ensemble_->session_expired(session_); }
+    void on_session_expired(std::function<void()> fn) override {
+        ensemble_->on_session_expired(session_, std::move(fn));
+    }
+    void close() override { ensemble_->end_session(session_, false); }
+
+private:
+    std::shared_ptr<InMemoryEnsemble> ensemble_;
+    int64_t session_;
+};
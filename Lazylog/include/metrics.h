@@ -0,0 +1,109 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "hdr_histogram.h"
+
+// Counters and latency histograms for the append path. Recording must not
+// become a serialization point of its own, so each metric is split into
+// METRIC_SHARDS cache-line-sized slots and a thread always records into
+// the slot it was assigned on first use; readers sum or merge all slots.
+
+constexpr int METRIC_SHARDS = 16;
+
+// 2 significant digits up to 60 s keeps a histogram around 20 KB, so the
+// sharded copies stay cheap
+constexpr int64_t METRIC_HIST_MAX_US = 60LL * 1000 * 1000;
+constexpr int METRIC_HIST_DIGITS = 2;
+
+inline int metric_shard() {
+    static std::atomic<int> next{0};
+    thread_local int shard = next.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    return shard;
+}
+
+class ShardedCounter {
+public:
+    void add(int64_t n = 1) { slots_[metric_shard()].v.fetch_add(n, std::memory_order_relaxed); }
+
+    int64_t value() const {
+        int64_t sum = 0;
+        for (const auto &s : slots_) sum += s.v.load(std::memory_order_relaxed);
+        return sum;
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<int64_t> v{0};
+    };
+    Slot slots_[METRIC_SHARDS];
+};
+
+// The per-slot mutex is only contended when more than METRIC_SHARDS
+// threads record at once, or against a reader merging the slots.
+class ShardedHistogram {
+public:
+    void record(int64_t v) {
+        Slot &s = slots_[metric_shard()];
+        std::lock_guard<std::mutex> lk(s.mu);
+        s.hist.record(v);
+    }
+
+    HdrHistogram snapshot() const {
+        HdrHistogram out(METRIC_HIST_MAX_US, METRIC_HIST_DIGITS);
+        for (const auto &s : slots_) {
+            std::lock_guard<std::mutex> lk(s.mu);
+            out.merge(s.hist);
+        }
+        return out;
+    }
+
+private:
+    struct alignas(64) Slot {
+        mutable std::mutex mu;
+        HdrHistogram hist{METRIC_HIST_MAX_US, METRIC_HIST_DIGITS};
+    };
+    Slot slots_[METRIC_SHARDS];
+};
+
+// Leader's view of one follower, refreshed by every heartbeat round.
+struct FollowerMetrics {
+    int64_t lag_entries = -1;   // leader log end - follower's next index
+    int64_t rtt_us = -1;        // last heartbeat round trip
+    int64_t last_ack_ms = 0;    // steady-clock time of the last ack
+    HdrHistogram rtt_hist{METRIC_HIST_MAX_US, METRIC_HIST_DIGITS};
+};
+
+struct SequencerMetrics {
+    // Append RPC (leader)
+    ShardedCounter appends;
+    ShardedCounter append_bytes;
+    ShardedCounter append_failures;
+    ShardedCounter overload_rejects;    // refused by admission control
+    ShardedCounter quota_rejects;       // refused by a client's quota
+    ShardedHistogram local_append_us;   // append_local_entry
+    ShardedHistogram replicate_us;      // replicate_to_followers
+    ShardedHistogram order_us;          // assign_global_pos
+    ShardedHistogram append_us;         // whole handler
+
+    // log GC
+    ShardedCounter gc_runs;
+    ShardedCounter gc_entries;
+    ShardedHistogram gc_us;
+
+    // written once per heartbeat round, not on the append path
+    std::mutex followers_mtx;
+    std::map<std::string, FollowerMetrics> followers;
+
+    void note_follower(const std::string &addr, int64_t lag_entries, int64_t rtt_us, int64_t now_ms) {
+        std::lock_guard<std::mutex> lk(followers_mtx);
+        FollowerMetrics &f = followers[addr];
+        f.lag_entries = lag_entries;
+        f.rtt_us = rtt_us;
+        f.last_ack_ms = now_ms;
+        f.rtt_hist.record(rtt_us);
+    }
+};
@@ -0,0 +1,113 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <grpcpp/grpcpp.h>
+#include "lazylog_client.h"
+#include "sequencer.grpc.pb.h"
+
+class Coordinator;
+
+// Producer library: the way a service appends a stream of records to one
+// log. append() queues a record and returns a future for its position.
+// Records are collected into a batch until it holds batch_records records
+// or batch_bytes bytes, or linger_ms passed since its first record, and up
+// to max_in_flight batches are kept outstanding on one AppendStream to the
+// leader (see sequencer.proto).
+//
+// Records are ordered in the order append() was called. Record i of the
+// producer is request next_req_id + i of client_id, so after a reconnect
+// (to the same replica or to a new leader, found like LazylogClient does)
+// every unanswered batch is resent in order and the replicas' dedup
+// answers the ones already ordered with their first positions. A leader
+// refusing a batch for overload (RESOURCE_EXHAUSTED) is asked again after
+// its retry-after hint, with the refused batch first. Batches refused for
+// good (too many logs, replication failed) fail their futures and do not
+// hold up the ones behind them. Thread-safe.
+class Producer {
+public:
+    struct Result {
+        bool ok = false;
+        int64_t pos = -1;     // position in the log
+        std::string message;
+    };
+
+    // client_id must be used by this producer alone; seeds and coord (not
+    // owned) as for LazylogClient
+    Producer(std::vector<std::string> seeds, int client_id, uint64_t log_id = 0,
+             Coordinator *coord = nullptr);
+    ~Producer();   // close()
+
+    // blocks while max_buffered records are unanswered; fails at once after close()
+    std::future<Result> append(std::string record);
+    // send what is queued without waiting for linger_ms, and wait until
+    // every record appended so far is answered
+    void flush();
+    // flush, then drop the stream; later appends fail
+    void close();
+
+    // set before the first append
+    int linger_ms = 5;
+    size_t batch_records = 1024;
+    size_t batch_bytes = 1 << 20;
+    int max_in_flight = 4;               // keep <= DEDUP_RUNS (sequencer.h)
+    size_t max_buffered = 1 << 16;
+    int delivery_timeout_ms = 30000;     // per record, from append() to its answer
+    int backoff_ms = 50;
+    // first request id; a producer taking over a client_id must start
+    // above every id used with it before
+    int next_req_id = 0;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using Stream = grpc::ClientReaderWriter<sequencer::AppendBatch, sequencer::AppendBatchReply>;
+
+    struct Batch {
+        sequencer::AppendBatch msg;
+        std::vector<std::promise<Result>> done;
+        size_t bytes = 0;
+        Clock::time_point created;
+    };
+
+    void run();
+    void read_replies(Stream *stream);
+    // with mu_ held: the open batch joins the send queue
+    void seal_locked();
+    void fail_locked(Batch &b, const std::string &why);
+    // drop the current stream and queue its unanswered batches for resending
+    void reset_stream(std::unique_lock<std::mutex> &lk);
+    bool open_stream(std::unique_lock<std::mutex> &lk);
+
+    LazylogClient router_;
+    const int client_id_;
+    const uint64_t log_id_;
+
+    std::mutex mu_;
+    std::condition_variable cv_;         // sender wakeups
+    std::condition_variable answered_;   // flush() and append() backpressure
+    bool started_ = false;
+    bool closing_ = false;
+    bool closed_ = false;
+    Batch open_;
+    std::deque<Batch> ready_;            // sealed, not sent on the current stream
+    std::deque<Batch> in_flight_;        // sent, in stream order
+    size_t buffered_ = 0;                // records not answered yet
+
+    std::string target_;                 // "" = ask router_ for one
+    std::string failed_;                 // replica the last stream went to
+    std::string hint_;                   // leader named by the last rejection
+    std::unique_ptr<sequencer::SequencerService::Stub> stub_;
+    std::unique_ptr<grpc::ClientContext> ctx_;
+    std::unique_ptr<Stream> stream_;
+    std::thread reader_;
+    bool broken_ = false;
+    bool ended_ = false;                 // the replica finished the stream
+    int64_t acked_on_stream_ = 0;
+    std::thread sender_;
+};
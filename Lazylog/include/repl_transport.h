@@ -0,0 +1,87 @@
+#pragma once
+#include "hdr_histogram.h"
+#include "sequencer_log.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <grpcpp/generic/generic_stub.h>
+
+// Outcome of sending one entry to one follower.
+struct ReplicateAck {
+    std::string addr;
+    bool ok = false;        // follower holds the entry
+    int64_t view = 0;       // follower's view; a higher one fences the leader
+    std::string error;      // transport failure or the follower's message
+    int attempts = 0;
+    int hedges = 0;         // attempts started because the first was slow
+    int64_t start_us = 0;   // steady clock, first attempt
+    int64_t done_us = 0;
+};
+
+// One entry on its way to a set of followers.
+class ReplicationCall {
+public:
+    virtual ~ReplicationCall() = default;
+    // start sending if begin() did not; called outside the sequencer lock,
+    // before wait(), so several calls can be on the wire at once. No
+    // attempt outlives deadline_us (steady clock).
+    virtual void send(int64_t /*deadline_us*/) {}
+    // blocks until every follower acked, failed or timed out. A follower in
+    // a newer view ends the call early; the acks returned then stop there.
+    virtual std::vector<ReplicateAck> wait() = 0;
+};
+
+// How replicate_to_followers reaches the followers. begin() runs under
+// the sequencer lock and gets the log's own entry. The entry stays in
+// place until the call is destroyed (GC stops at entries in flight and a
+// snapshot install waits for the round), so a call may keep pointing at
+// its record instead of copying it.
+class ReplicationTransport {
+public:
+    virtual ~ReplicationTransport() = default;
+    virtual std::unique_ptr<ReplicationCall> begin(const std::vector<std::string> &addrs,
+                                                   int64_t local_index,
+                                                   const SequencerLog::Entry &e,
+                                                   int64_t view, uint64_t trace_id) = 0;
+};
+
+// ReplicateAppend over gRPC: one request serialized once in send(), with
+// the record referenced from the log entry rather than copied, and sent
+// to every follower at once on its cached channel. Every attempt has its
+// own ClientContext with the call's deadline. An attempt that fails
+// before the deadline is retried after an exponential backoff, timed by
+// a grpc::Alarm rather than a sleep. With hedge on, a follower that has
+// not answered within its recent p99 gets a second attempt over a spare
+// channel (its own connection); the first answer wins.
+class GrpcReplicationTransport : public ReplicationTransport {
+public:
+    using StubFor = std::function<std::shared_ptr<grpc::GenericStub>(const std::string &)>;
+    GrpcReplicationTransport(StubFor stub_for, StubFor spare_stub_for)
+        : stub_for_(std::move(stub_for)), spare_stub_for_(std::move(spare_stub_for)) {}
+
+    std::unique_ptr<ReplicationCall> begin(const std::vector<std::string> &addrs,
+                                           int64_t local_index, const SequencerLog::Entry &e,
+                                           int64_t view, uint64_t trace_id) override;
+
+    std::atomic<bool> hedge{false};
+
+    // p99 of addr's first-attempt round trips over the last window of
+    // samples, 0 until the first window is full
+    int64_t hedge_after_us(const std::string &addr);
+    void note_round_trip(const std::string &addr, int64_t us);
+
+private:
+    StubFor stub_for_;
+    StubFor spare_stub_for_;
+    struct RoundTrips {
+        HdrHistogram window;
+        int64_t p99_us = 0;
+    };
+    std::mutex rtt_mu_;
+    std::unordered_map<std::string, RoundTrips> rtt_;
+};
@@ -6,7 +6,79 @@
 #include <memory>
 #include <atomic>
 #include <unordered_map>
+#include <unordered_set>
+#include <map>
+#include <set>
 #include <iostream>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include "sequencer_internal.grpc.pb.h"
+#include <grpcpp/generic/generic_stub.h>
+#include "admission.h"
+#include "client_quota.h"
+#include "metrics.h"
+#include "repl_transport.h"
+#include "tcp_transport.h"
+#include "trace.h"
+
+// monotonic wall-clock-independent time in ms (for leases and failover timing)
+inline int64_t steady_now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline int64_t steady_now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Requests first_req .. first_req+count-1 of a client, ordered at
+// consecutive positions from first_pos (typically one batch).
+struct DedupRun {
+    int first_req;
+    int count;
+    int64_t first_pos;
+};
+
+// runs a client's dedup entry remembers besides the latest one
+static const size_t DEDUP_RUNS = 8;
+
+// Latest request ordered for a client in one log; a retry of it gets the
+// same position. A retry of one of the run it ends (requests req_id-run+1
+// .. req_id at positions pos-run+1 .. pos) or of the DEDUP_RUNS runs
+// before it does too, so a producer with several batches in flight can
+// resend all of them after a reconnect.
+struct DedupEntry {
+    int req_id;
+    int64_t pos;
+    int run = 1;
+    std::vector<DedupRun> earlier;   // oldest first
+};
+
+// One log served by this replica. Logs share the replica group, its view,
+// replication stream and storage; what is per log is this struct, so a
+// mostly idle log costs little more than its dedup entries.
+struct LogState {
+    int64_t next_pos = 0;     // next position handed out (named logs)
+    int64_t gc_pos = -1;      // highest position GC dropped
+    std::unordered_map<int, DedupEntry> dedup;   // by client_id
+    // leader: (client_id, req_id) -> local index of its entry while it is
+    // appended but not ordered yet, so a retry does not append it again
+    std::unordered_map<int64_t, int> unordered;
+    std::map<std::string, int64_t> gc_holds;     // name -> keep-from position
+};
+
+// Timeline of the last failover this node took part in as the new leader.
+// detect: old leader's last sign of life -> this node noticed it was gone
+// elect:  noticed -> this node decided it is leader (ZK round trips)
+// seal:   decided -> view sealed/unsealed and appends accepted again
+struct FailoverStats {
+    int64_t detect_ms = -1;
+    int64_t elect_ms = -1;
+    int64_t seal_ms = -1;
+    int64_t total_ms = -1;
+};
 
 
 
@@ -14,32 +86,249 @@ class Sequencer {
 public:
     SequencerState state;
 
-    // follower addresses e.g. {"127.0.0.1:50052", "127.0.0.1:50053"}
-    std::vector<std::string> followers;
+    // this replica's own address, advertised in heartbeats
+    std::string self_addr;
 
     // concurrency
     std::mutex mtx;
 
-    // monotonic global position counter
+    // next gp the leader hands out (one past the highest gp in the log)
     std::atomic<int64_t> next_global_pos {0};
 
     // mapping from local_index -> global_pos
     std::unordered_map<int, int64_t> local_to_gp;
 
+    // append / replication / GC statistics, served by GetStats
+    SequencerMetrics metrics;
+
+    // bounds the appends between admission and the end of their replication
+    AdmissionControl admission;
+    // per-client_id rate limits, checked ahead of admission
+    ClientQuotas quotas;
+
+    // sampled append spans (off unless opened by the server)
+    Tracer tracer;
+
     Sequencer() = default;
+    ~Sequencer() { stop_background(); }
+
+    // stop catch-up and join threads and wait for them to exit; called
+    // before the replica is torn down
+    void stop_background();
+
+    // follower addresses e.g. {"127.0.0.1:50052", "127.0.0.1:50053"};
+    // replaced by the view change, so always read through get_followers()
+    std::vector<std::string> get_followers();
+    void set_followers(const std::vector<std::string> &addrs);
+
+    // leader: append locally, numbering the entry in the current view and
+    // in its log; returns local_index. A non-zero shard appends metadata
+    // only: the record bytes are on that shard. A non-zero trace_id records
+    // the stage's spans (here and in replicate_to_followers /
+    // assign_global_pos). A retry of a request whose entry is not ordered
+    // yet (its append is still replicating, or failed) gets that entry's
+    // index instead: replicating it again keeps the gp it has.
+    int append_local_entry(int client_id, int req_id, const std::string &record,
+                           int shard = 0, uint64_t trace_id = 0, uint64_t log_id = 0);
+
+    // follower: place an entry the leader already numbered at the leader's
+    // local_index. Rejects older views; entries past a gap are buffered and
+    // acked while a background catch-up fetches the missing range. The
+    // record is moved out of req.
+    void handle_replicate(sequencer_internal::ReplicateAppendRequest *req,
+                          sequencer_internal::ReplicateAppendReply *reply);
+
+    // replicate to followers synchronously (waits for all acks). Followers
+    // with a TCP replication route get the entry from tcp_transport, the
+    // rest over gRPC, where it is serialized once for all of them. Gives
+    // up after repl_timeout_ms, or at deadline_us (steady clock, 0 = none)
+    // if that is sooner.
+    bool replicate_to_followers(int local_index, uint64_t trace_id = 0, int64_t deadline_us = 0);
+    // leader: replication of these entries failed. They keep their gps for
+    // a retry of their requests to replicate again; an entry no retry came
+    // for is ordered once every follower holds it (heartbeat_followers)
+    void abandon_entries(const std::vector<int> &indices);
 
-    // append locally, returns local_index
-    int append_local_entry(int client_id, int req_id, const std::string &record);
+    // leader: append_local_entry / replicate_to_followers /
+    // assign_global_pos for consecutive entries, one lock hold per step.
+    // Used by the shared-memory ingestion path (shm_ingest.h) and by
+    // AppendStream; records are copied out of the caller's buffers.
+    struct BatchRecord {
+        int client_id;
+        int req_id;
+        uint64_t log_id;
+        const char *data;
+        size_t len;
+    };
+    // appends each record's local index to indices; consecutive, except
+    // for retries (see append_local_entry)
+    void append_local_batch(const std::vector<BatchRecord> &recs, std::vector<int> *indices);
+    // true if every follower acked every entry
+    bool replicate_range(int first_index, int count, uint64_t trace_id = 0, int64_t deadline_us = 0);
+    // appends each entry's position in its log to positions
+    void assign_global_range(const std::vector<int> &indices, std::vector<int64_t> *positions);
+    // the three steps above plus the append metrics (per batch); false if
+    // replication failed, else positions holds one position per record.
+    // deadline_us bounds the replication as in replicate_to_followers.
+    bool append_batch(const std::vector<BatchRecord> &recs, std::vector<int64_t> *positions,
+                      int64_t deadline_us = 0);
 
-    // replicate to followers synchronously (waits for all acks)
-    bool replicate_to_followers(int local_index);
+    // leader: the TCP replication transport, null when off (the default);
+    // routes come from the repl_port followers report in heartbeat replies
+    std::unique_ptr<TcpReplicationClient> tcp_transport;
+    // follower: port our TcpReplicationServer listens on, 0 if none
+    std::atomic<int> repl_port{0};
 
-    // called by leader when replication succeeded to assign global position
-    int assign_global_pos(int local_index);
+    // called by leader when replication succeeded: records the entry's
+    // global position as ordered and returns its position in its log
+    int assign_global_pos(int local_index, uint64_t trace_id = 0);
 
     // perform GC locally up to gp (global positon)
     void gc_up_to(int gp);
 
+    // one bounded GC step: drop at most max_entries ordered entries with
+    // gp' <= gp from the head of the log; returns the number dropped. The
+    // background GC calls it in a loop, so no step holds mtx for long.
+    int gc_step(int64_t gp, int max_entries);
+
+    // highest gp GC may drop now: ordered, below every GC hold, at least
+    // retain_entries behind the log end, and held by every follower (on
+    // the leader) or already dropped by the leader (on a follower). -1
+    // while a follower has not reported its position yet.
+    int64_t gc_safe_gp(int retain_entries);
+
+    // keep entries with gp >= keep_from_gp for holder name (a checkpoint,
+    // a consumer cursor) until the hold is moved or cleared
+    void set_gc_hold(const std::string &name, int64_t keep_from_gp);
+    void clear_gc_hold(const std::string &name);
+
+    // the same for one log, in its own positions: GC stops at the first
+    // entry of log_id at or past keep_from_pos
+    void set_log_gc_hold(uint64_t log_id, const std::string &name, int64_t keep_from_pos);
+    void clear_log_gc_hold(uint64_t log_id, const std::string &name);
+
+    // follower: gp up to which the leader has GC'd, from its heartbeats
+    std::atomic<int64_t> leader_gc_gp{-1};
+
+    // --------------------------
+    // Logs
+    // --------------------------
+    // logs are created by their first append; past max_logs (0 = no limit)
+    // the leader refuses appends that would create another one
+    int max_logs = 0;
+
+    // bound on replicating one append, retries included
+    int repl_timeout_ms = 1000;
+    // duplicate a gRPC replication attempt that is slower than the
+    // follower's p99 on a spare connection (see GrpcReplicationTransport)
+    void set_repl_hedge(bool on) { grpc_transport->hedge.store(on); }
+    bool admit_log(uint64_t log_id);
+    size_t log_count();
+    // next position and GC position of log_id; false if it does not exist
+    bool log_info(uint64_t log_id, int64_t *next_pos, int64_t *gc_pos, int64_t *clients);
+
+    // --------------------------
+    // Dedup / checkpoints
+    // --------------------------
+    // true (and the position it got) if req_id is a request ordered for
+    // client_id in log_id that its DedupEntry still covers, i.e. a retry
+    // of an append that already went through
+    bool find_duplicate(uint64_t log_id, int client_id, int req_id, int64_t *pos);
+
+    // copy of the metadata (gp state, view numbering, log counters and
+    // dedup tables). With track_dedup_changes, only the dedup entries
+    // changed since the previous checkpoint are copied under mtx, into
+    // ckpt_dedup; the checkpoint is then built from that copy while
+    // appends continue
+    sequencer_internal::Checkpoint take_checkpoint();
+    // a checkpoint is durable: entries past it stay in the log (GC hold)
+    void note_checkpoint_written(const sequencer_internal::Checkpoint &ckpt);
+    // install a checkpoint before the replica serves; the log restarts
+    // empty and the first catch-up fetches only the entries past it
+    void restore_checkpoint(const sequencer_internal::Checkpoint &ckpt);
+
+    // last_ordered_gp of the newest checkpoint written or restored
+    std::atomic<int64_t> checkpoint_gp{-1};
+
+    // set before serving when checkpoints are taken: ordering an entry
+    // marks its dedup entry changed (dedup_dirty), so take_checkpoint does
+    // not copy the whole table under mtx each time
+    bool track_dedup_changes = false;
+    // take_checkpoint's own copy of the dedup tables (log_id -> client_id
+    // -> entry), guarded by ckpt_mtx, which also keeps checkpoints apart
+    std::mutex ckpt_mtx;
+    std::unordered_map<uint64_t, std::unordered_map<int, DedupEntry>> ckpt_dedup;
+
+    // one heartbeat round to all followers, each bounded by timeout_ms;
+    // returns the number of followers that acked
+    int heartbeat_followers(int timeout_ms);
+
+    // --------------------------
+    // View change
+    // --------------------------
+    // New leader: seal every follower in a higher view, adopt the highest
+    // ordered tail any of them holds, fill gp holes with no-op entries,
+    // push the tail back and number the new view after it. Two parallel
+    // round trips, each bounded by timeout_ms; the caller unseals after.
+    // The new view is at least min_view (the leader's election epoch).
+    void run_view_change(int64_t min_view, int timeout_ms);
+
+    // follower side of the two view-change phases
+    void handle_seal_view(const sequencer_internal::SealViewRequest &req,
+                          sequencer_internal::SealViewReply *reply);
+    void handle_new_view(const sequencer_internal::NewViewRequest &req,
+                         sequencer_internal::NewViewReply *reply);
+
+    // --------------------------
+    // Epoch fencing
+    // --------------------------
+    int64_t current_view() {
+        std::lock_guard<std::mutex> lk(mtx);
+        return state.view;
+    }
+
+    // follower: accept a leader request stamped with view unless a newer
+    // view is already known; adopts the higher view
+    bool accept_view(int64_t view);
+
+    // leader: a follower reported view; if it is newer we were deposed, so
+    // step down and seal before serving another append
+    void fence_if_superseded(int64_t view);
+
+    // the replica this one takes for the leader, for clients it turns away:
+    // itself while it leads, else the sender of the last view change or
+    // heartbeat it accepted ("" before the first)
+    std::string leader_hint() {
+        if (is_leader.load()) return self_addr;
+        std::lock_guard<std::mutex> lk(mtx);
+        return leader_addr;
+    }
+
+    // --------------------------
+    // Catch-up / state transfer
+    // --------------------------
+    // leader side: stream the log from req.from_index in batches, without
+    // holding mtx across writes so appends continue during a long transfer
+    grpc::Status serve_fetch(const sequencer_internal::FetchEntriesRequest &req,
+                             grpc::ServerWriter<sequencer_internal::FetchEntriesReply> *writer);
+    void fill_snapshot(const sequencer_internal::SnapshotRequest &req,
+                       sequencer_internal::SnapshotReply *reply);
+
+    // follower side: a heartbeat from leader_addr advertising its last
+    // local index; starts a catch-up when we are still behind it since the
+    // previous heartbeat. Returns the next leader index we expect.
+    int64_t note_leader_progress(const std::string &leader_addr, int64_t leader_last_index);
+
+    // --------------------------
+    // Membership
+    // --------------------------
+    // replicas currently registered under /lazylog/replicas (seeded from
+    // --followers). On the leader, departed ones leave the follower set at
+    // once; new ones join only after join_follower has pre-warmed their
+    // channel and they have caught up to within a few entries.
+    void update_membership(const std::vector<std::string> &registered);
+    std::vector<std::string> get_registered();
+
     std::atomic<bool> sealed{false};
 
     void seal_view() {
@@ -57,9 +346,10 @@ public:
     // --------------------------
     std::atomic<bool> is_leader{false};
 
+    // leaves the view sealed: the caller runs the view change, then unseals
     void become_leader() {
         is_leader.store(true);
-        sealed.store(false);
+        renew_lease(steady_now_ms());   // initial lease until the first heartbeat round
         std::cout << "[ELECTION] This node became LEADER.\n";
     }
 
@@ -69,6 +359,117 @@ public:
         std::cout << "[ELECTION] This node is FOLLOWER.\n";
     }
 
+    // --------------------------
+    // Leader lease / failure detection
+    // --------------------------
+    // lease length in ms; 0 disables leases and heartbeat-based detection
+    int lease_ms = 0;
+
+    // leader: appends are served only until this steady-clock time; renewed
+    // whenever every follower acks a heartbeat round
+    std::atomic<int64_t> lease_expiry_ms{0};
+
+    // follower: steady-clock time of the last heartbeat from the leader
+    std::atomic<int64_t> last_heartbeat_ms{0};
+
+    // from_ms: when the heartbeat round that renews it was sent. Followers
+    // time the leader from when a heartbeat reached them, which is no
+    // earlier, so with a margin for clock rate drift the lease runs out
+    // before any of them gives up on the leader
+    void renew_lease(int64_t from_ms) {
+        lease_expiry_ms.store(from_ms + lease_ms - lease_ms / 20);
+    }
+
+    bool lease_valid() const {
+        return lease_ms == 0 || !has_followers.load() || steady_now_ms() < lease_expiry_ms.load();
+    }
+
+    std::mutex failover_mtx;
+    FailoverStats last_failover;
+
+    void record_failover(const FailoverStats &f) {
+        std::lock_guard<std::mutex> lk(failover_mtx);
+        last_failover = f;
+    }
+
+private:
+    std::mutex followers_mtx;
+    std::vector<std::string> followers;
+    std::atomic<bool> has_followers{false};
+
+    // cached stubs per follower address; channels are expensive to build
+    std::mutex stubs_mtx;
+    std::unordered_map<std::string, std::shared_ptr<sequencer_internal::SequencerInternal::Stub>> stubs;
+    std::unordered_map<std::string, std::shared_ptr<grpc::Channel>> channels;
+    // same channels, for calls that send pre-serialized requests
+    std::unordered_map<std::string, std::shared_ptr<grpc::GenericStub>> generic_stubs;
+    // a second connection per follower, for hedged replication attempts
+    std::unordered_map<std::string, std::shared_ptr<grpc::GenericStub>> spare_stubs;
+
+    std::shared_ptr<sequencer_internal::SequencerInternal::Stub> stub_for(const std::string &addr);
+    std::shared_ptr<grpc::GenericStub> generic_stub_for(const std::string &addr);
+    std::shared_ptr<grpc::GenericStub> spare_stub_for(const std::string &addr);
+    std::unique_ptr<GrpcReplicationTransport> grpc_transport{new GrpcReplicationTransport(
+        [this](const std::string &addr) { return generic_stub_for(addr); },
+        [this](const std::string &addr) { return spare_stub_for(addr); })};
+    // connect addr's cached channel ahead of use; false on timeout
+    bool prewarm(const std::string &addr, int timeout_ms);
+
+    // guarded by followers_mtx
+    std::vector<std::string> registered;
+    std::set<std::string> joining;
+    void join_follower(const std::string &addr);
+
+    // follower mirror of the leader's log (guarded by mtx). leader_next_index
+    // is the next leader local index we expect; -1 means unknown (fresh
+    // replica or missed view change) and forces a snapshot transfer.
+    std::string leader_addr;
+    int64_t leader_next_index = -1;
+    int64_t lag_seen_at_heartbeat = -1;
+    std::map<int64_t, sequencer_internal::LogEntry> pending;   // past a gap
+
+    // leader: local index -> appends still working on the entry, for
+    // entries not yet ordered (0 once every append of it failed) or still
+    // read by an append that joined it (guarded by mtx). GC stops at the
+    // first.
+    std::map<int, int> in_flight;
+    // replication rounds whose calls may still read log entries in place
+    // (guarded by mtx); a snapshot install waits for them
+    int sending = 0;
+    int join_unordered_locked(uint64_t log_id, int client_id, int req_id);
+    const SequencerLog::Entry &order_locked(int local_index);
+    void release_locked(int local_index);
+    // order abandoned entries every follower reports holding
+    void order_held_locked(const std::vector<std::string> &followers);
+
+    // GC inputs (guarded by mtx): each follower's next index as reported by
+    // its last heartbeat ack, and the holds set through set_gc_hold
+    std::unordered_map<std::string, int64_t> follower_next;
+    std::map<std::string, int64_t> gc_holds;
+
+    // the log registry (guarded by mtx); dedup tables and counters are
+    // filled as entries are ordered (leader) or mirrored
+    std::unordered_map<uint64_t, LogState> logs;
+    void note_ordered_locked(uint64_t log_id, int client_id, int req_id, int64_t pos);
+    // log_id -> clients whose dedup entry changed since the last checkpoint
+    // (guarded by mtx; only with track_dedup_changes)
+    std::unordered_map<uint64_t, std::unordered_set<int>> dedup_dirty;
+    // gp a restored checkpoint covers up to (exclusive); 0 once caught up
+    int64_t resume_gp = 0;
+    std::atomic<bool> catching_up{false};
+
+    // detached helper threads (catch-up, joins) still running
+    std::atomic<bool> stopping{false};
+    std::mutex background_mtx;
+    std::condition_variable background_cv;
+    int background_tasks = 0;
+    void spawn_background(std::function<void()> fn);
+
+    void append_mirrored_locked(sequencer_internal::LogEntry &&e);
+    void enter_view_locked(int64_t view);
+    void drain_pending_locked();
+    void start_catch_up();
+    void catch_up();
 
 
 
@@ -1,6 +1,7 @@
 #pragma once
-#include <vector>
+#include <deque>
 #include <string>
+#include <cstdint>
 
 class SequencerLog {
 public:
@@ -8,15 +9,32 @@ public:
         int client_id;
         int req_id;
         std::string record;
+        int64_t global_pos = -1;   // -1 until ordered
+        int shard = 0;             // non-zero: record bytes live on this shard
+        uint64_t log_id = 0;       // log the entry belongs to
+        int64_t log_pos = -1;      // position in that log (the gp for log 0)
     };
 
 private:
-    std::vector<Entry> log;
+    // deque so GC drops a prefix without moving the entries it keeps
+    std::deque<Entry> log;
+    int64_t first_local_index = 0;   // local index of log[0] (advances on GC)
     int64_t last_local_index = -1;
+    int64_t record_bytes = 0;        // sum of record sizes held
 
 public:
     int append(const Entry& e);
-    Entry get(int index);
+    int append(Entry&& e);     // takes over the record without copying it
+    // valid until the entry is GC'd or the log is reset; copy what must
+    // outlive the caller's lock
+    const Entry& get(int index) const;
     void gc_up_to(int index);
+    // drop everything and continue numbering at first_index (state transfer)
+    void reset(int64_t first_index);
     int size() { return log.size(); }
+    int64_t bytes() const { return record_bytes; }
+
+    // local index range currently held (empty when first > last)
+    int64_t first_index() const { return first_local_index; }
+    int64_t last_index() const { return last_local_index; }
 };
@@ -1,6 +1,7 @@
 #ifndef SEQUENCER_SERVER_H
 #define SEQUENCER_SERVER_H
 
+#include <memory>
 #include <string>
 #include <vector>   
 #include "sequencer.h"
@@ -8,9 +9,135 @@
 #include "sequencer.grpc.pb.h"
 
 
+// Command-line configurable settings of one replica (see main.cpp)
+struct ServerConfig {
+    std::string role = "leader";            // initial role only; ZK decides afterwards
+    int port = 50051;
+    // also serve on this Unix domain socket ("" = off, "@name" = abstract
+    // namespace, see uds_target.h) so producers on the same host skip TCP
+    std::string uds;
+    // shared-memory ingestion for producers on this host ("" = off): rings
+    // /dev/shm/<shm_name>-0.. of shm_ring_bytes each, one per attached
+    // ShmProducer (see shm_ring.h)
+    std::string shm_name;
+    int shm_rings = 4;
+    int shm_ring_bytes = 1 << 20;
+    std::vector<std::string> followers;
+
+    // ZooKeeper ensemble and session timeout. The server clamps the timeout
+    // to [2, 20] x tickTime, so very small values are rounded up.
+    std::string zk_addr = "127.0.0.1:2181";
+    int zk_session_timeout_ms = 30000;
+
+    // Leader -> follower heartbeat period. The replica next in line deletes
+    // the leader's election node after lease_ms without a heartbeat, so a
+    // crashed leader is replaced without waiting for its ZK session to
+    // expire. lease_ms = 0 falls back to session expiry only.
+    int heartbeat_ms = 100;
+    int lease_ms = 500;
+
+    // Bound on each of the two view-change round trips a new leader makes
+    // before it accepts appends; unresponsive followers are skipped.
+    int view_change_timeout_ms = 300;
+
+    // Background log GC: every gc_interval_ms (0 = off) truncate the log
+    // up to what every follower holds and no GC hold pins, keeping at
+    // least gc_retain_entries for follower catch-up, in steps of at most
+    // gc_step_entries so appends interleave with a large truncation.
+    int gc_interval_ms = 1000;
+    int gc_step_entries = 1024;
+    int gc_retain_entries = 10000;
+
+    // Checkpoint the sequencer metadata (gp state, view, dedup table) to
+    // <checkpoint_dir>/checkpoint-<port> every checkpoint_interval_ms and
+    // recover from it on restart ("" = off). GC keeps the entries past the
+    // newest checkpoint.
+    std::string checkpoint_dir;
+    int checkpoint_interval_ms = 5000;
+
+    // Logs (AppendRequest.log_id) are created by their first append; the
+    // leader refuses to create more than max_logs of them (0 = no limit).
+    int max_logs = 0;
+
+    // Admission control on the leader: appends admitted and not done
+    // replicating are limited to max_inflight_entries entries and
+    // max_inflight_bytes record bytes (0 = no limit). An append past
+    // either waits up to admission_wait_ms for room, then fails with
+    // RESOURCE_EXHAUSTED and a retry-after-ms hint.
+    int64_t max_inflight_entries = 1 << 16;
+    int64_t max_inflight_bytes = 256LL << 20;
+    int admission_wait_ms = 10;
+
+    // Per-client_id quotas (0 = unlimited): every client may append
+    // client_records_per_s records and client_bytes_per_s record bytes a
+    // second, with bursts of client_burst_ms at those rates. client_quotas
+    // overrides them per client as "ID:RECORDS_PER_S:BYTES_PER_S,...". A
+    // client over its quota gets RESOURCE_EXHAUSTED with retry-after-ms;
+    // its shared-memory records wait in their ring. quota_slots sizes the
+    // client table (see client_quota.h).
+    int64_t client_records_per_s = 0;
+    int64_t client_bytes_per_s = 0;
+    int client_burst_ms = 1000;
+    std::string client_quotas;
+    int quota_slots = 1 << 16;
+
+    // Leader -> follower replication: "grpc" (ReplicateAppend) or "tcp",
+    // the binary transport in tcp_transport.h. With "tcp" every replica
+    // also listens on repl_tcp_port (0 = any free port) and reports it in
+    // heartbeat replies; a follower the leader cannot reach there still
+    // gets entries over gRPC. A TCP send unacked after repl_tcp_timeout_ms
+    // fails like a failed ReplicateAppend.
+    std::string repl_transport = "grpc";
+    int repl_tcp_port = 0;
+    int repl_tcp_timeout_ms = 1000;
+    // Replicating one append gives up after repl_timeout_ms, retries
+    // included, or when the client's deadline passes if that is sooner.
+    // With repl_hedge a gRPC ReplicateAppend still unanswered after the
+    // follower's recent p99 is sent again over a second connection.
+    int repl_timeout_ms = 1000;
+    bool repl_hedge = false;
+
+    // Trace 1 in trace_sample appends end to end (0 = off). Every replica
+    // with tracing on writes the spans it sees to
+    // <trace_dir>/lazylog-trace-<port>.json, so turn it on for all of them.
+    int trace_sample = 0;
+    std::string trace_dir = ".";
+};
+
+class Coordinator;
+
+// One replica: gRPC services, coordinator registration, election,
+// membership and heartbeat threads. Several can run in one process (see
+// LocalCluster).
 class SequencerServer {
 public:
-    void Run(const std::string& role, int port, const std::vector<std::string>& followers);
+    SequencerServer();
+    ~SequencerServer();
+
+    // Start + Wait; installs the SIGUSR1 seal handler (process entry point)
+    void Run(const ServerConfig& cfg);
+
+    // Serve in the background. cfg.port = 0 picks a free port. coord is the
+    // coordination session to use; null connects to ZooKeeper at cfg.zk_addr.
+    // Returns false if the port cannot be bound.
+    bool Start(const ServerConfig& cfg, std::unique_ptr<Coordinator> coord = nullptr);
+    void Wait();
+    // stop serving, join background threads and end the coordinator session
+    void Shutdown();
+
+    int port() const;
+    std::string address() const;   // advertised "127.0.0.1:port"
+    Sequencer& sequencer();
+
+    // Fault injection: while paused, incoming RPCs block and no heartbeats
+    // go out; SetDelay adds latency to every incoming RPC.
+    void Pause();
+    void Resume();
+    void SetDelay(int ms);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
 };
 
 
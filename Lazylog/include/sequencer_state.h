@@ -4,7 +4,13 @@
 struct SequencerState {
     int64_t last_ordered_gp = -1;
     int64_t stable_gp = -1; // leader only
-    int view = 0;
+    int64_t gc_gp = -1;     // highest gp dropped by GC
+    int64_t view = 0;
     bool is_leader = false;
     SequencerLog log;
+
+    // gp numbering of the current view: the entry at local index i gets
+    // gp = view_gp_base + (i - view_local_base). Fixed by the view change.
+    int64_t view_local_base = 0;
+    int64_t view_gp_base = 0;
 };
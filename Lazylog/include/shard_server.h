@@ -0,0 +1,41 @@
+#ifndef SHARD_SERVER_H
+#define SHARD_SERVER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+struct ShardConfig {
+    int port = 50061;                   // 0 picks a free port
+    // Backups this shard replicates every write to before acking; empty
+    // for a backup (or an unreplicated shard).
+    std::vector<std::string> backups;
+    int replicate_timeout_ms = 1000;
+};
+
+// One shard replica: holds record bytes keyed by (log_id, client_id,
+// req_id) in its own log (see proto/shard.proto). Shards do not take part
+// in ordering; the sequencer only sees which shard a record went to.
+class ShardServer {
+public:
+    ShardServer();
+    ~ShardServer();
+
+    // serve in the background; false if the port cannot be bound
+    bool Start(const ShardConfig& cfg);
+    void Wait();
+    void Shutdown();
+
+    int port() const;
+    std::string address() const;   // "127.0.0.1:port"
+
+    // entries and record bytes held
+    int64_t size() const;
+    int64_t bytes() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+#endif
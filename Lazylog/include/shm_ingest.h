@@ -0,0 +1,55 @@
+#pragma once
+#include "shm_ring.h"
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Sequencer;
+
+// Sequencer side of the shared-memory ingestion path (see shm_ring.h).
+// Creates the ring segments and runs one drain thread that collects the
+// records waiting in all rings into a batch (deficit round robin across
+// rings, holding back clients over their quota), takes it through the
+// leader's append path (one lock hold to append, one replication round,
+// one to order) and posts the positions back. The thread spins while
+// there is work and backs off to short sleeps when the rings stay empty.
+class ShmIngest {
+public:
+    // before_batch runs ahead of every batch (the server's fault gate)
+    ShmIngest(Sequencer &seq, std::function<void()> before_batch);
+    ~ShmIngest();
+
+    // create the segments /name-0 .. /name-(rings-1), each with ring_bytes
+    // of request ring (rounded up to a power of two), and start draining;
+    // false if one cannot be made
+    bool start(const std::string &name, int rings, size_t ring_bytes);
+    // stop draining and remove the segments; producers see server_up = 0
+    void stop();
+
+private:
+    struct Pending {
+        shm_ring::RingHeader *ring;
+        int32_t client_id;
+        int32_t req_id;
+        int32_t status;
+        int64_t pos;
+        int batch_slot;     // index into the batch, -1 if answered early
+    };
+
+    void loop();
+    // collect, append and answer one batch; false if every ring was empty
+    bool drain_once();
+    void reclaim_abandoned();
+
+    Sequencer &seq_;
+    std::function<void()> before_batch_;
+    std::string name_;
+    std::vector<shm_ring::RingHeader *> rings_;
+    size_t map_len_ = 0;
+    size_t next_ring_ = 0;   // drained first in the next batch, for fairness
+    std::vector<int64_t> deficit_;   // DRR credit per ring, in bytes
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
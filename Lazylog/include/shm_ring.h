@@ -0,0 +1,140 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Layout of the shared-memory ingestion rings. A sequencer started with
+// --shm_name=NAME creates segments /NAME-0 .. /NAME-(rings-1) (POSIX shm,
+// i.e. /dev/shm/NAME-k). Each is owned by at most one producer at a time
+// and holds two single-producer single-consumer rings:
+//
+//   request ring     producer -> sequencer, variable-size records
+//   completion ring  sequencer -> producer, one Completion per record, in
+//                    request order
+//
+// Both sides only touch memory on the fast path: indices are free-running
+// byte / slot counters published with release stores. Producer and
+// sequencer must be the same build on the same host (host byte order).
+namespace shm_ring {
+
+const uint32_t MAGIC = 0x4c5a5348;    // "HSZL"
+const uint32_t VERSION = 1;
+const uint32_t WRAP = 0xffffffffu;    // RecordHeader::len: skip to the ring start
+
+// completion status; OK and DUPLICATE carry a position. Values match
+// sequencer.AppendStatus, so status_message() serves both.
+enum Status : int32_t {
+    OK = 0,
+    DUPLICATE = 1,          // retry of an ordered append: its original position
+    NOT_LEADER = 2,
+    SEALED = 3,
+    LEASE_EXPIRED = 4,
+    TOO_MANY_LOGS = 5,
+    REPLICATION_FAILED = 6,
+    BAD_RECORD = 7,         // malformed request record
+    OVERLOADED = 8,         // refused by admission control; retry later
+};
+
+struct alignas(64) RingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t data_capacity;             // request ring bytes, a power of two
+    uint64_t comp_capacity;             // completion slots, a power of two
+    std::atomic<uint32_t> owner;        // producer pid, 0 = free
+    std::atomic<uint32_t> server_up;    // 1 while the sequencer drains this ring
+
+    alignas(64) std::atomic<uint64_t> req_head;    // written by the producer
+    alignas(64) std::atomic<uint64_t> req_tail;    // written by the sequencer
+    alignas(64) std::atomic<uint64_t> comp_head;   // written by the sequencer
+    alignas(64) std::atomic<uint64_t> comp_tail;   // written by the producer
+};
+
+// request records start 8-byte aligned and never wrap; a record that does
+// not fit before the end is preceded by a WRAP header
+struct RecordHeader {
+    uint32_t len;           // record bytes that follow, or WRAP
+    int32_t client_id;
+    int32_t req_id;
+    uint32_t pad;
+    uint64_t log_id;
+};
+
+struct Completion {
+    int32_t client_id;
+    int32_t req_id;
+    int32_t status;         // Status
+    uint32_t pad;
+    int64_t pos;            // position in the record's log
+};
+
+static_assert(sizeof(RecordHeader) == 24, "RecordHeader layout");
+static_assert(sizeof(Completion) == 24, "Completion layout");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared atomics must be lock-free");
+
+inline size_t record_size(size_t len) { return (sizeof(RecordHeader) + len + 7) & ~size_t(7); }
+
+// largest record a ring of data_capacity bytes takes
+inline size_t max_record(uint64_t data_capacity) { return data_capacity / 4 - sizeof(RecordHeader); }
+
+inline size_t segment_size(uint64_t data_capacity, uint64_t comp_capacity) {
+    return sizeof(RingHeader) + data_capacity + comp_capacity * sizeof(Completion);
+}
+
+inline char *ring_data(RingHeader *h) { return reinterpret_cast<char *>(h + 1); }
+
+inline Completion *ring_completions(RingHeader *h) {
+    return reinterpret_cast<Completion *>(ring_data(h) + h->data_capacity);
+}
+
+// shm_open name of segment k
+inline std::string segment_name(const std::string &name, int k) {
+    return "/" + name + "-" + std::to_string(k);
+}
+
+const char *status_message(int32_t status);
+
+}  // namespace shm_ring
+
+// Producer side: claims a free ring of a sequencer's segment set and
+// appends through it without system calls. Not thread-safe; use one
+// ShmProducer per producing thread (each gets its own ring).
+class ShmProducer {
+public:
+    struct Ack {
+        int client_id;
+        int req_id;
+        int32_t status;     // shm_ring::Status
+        int64_t pos;
+    };
+
+    ShmProducer() = default;
+    ~ShmProducer() { detach(); }
+    ShmProducer(const ShmProducer &) = delete;
+    ShmProducer &operator=(const ShmProducer &) = delete;
+
+    // claim a free ring of the sequencer serving shm_name; false if there
+    // is none (segments missing, sequencer gone, or all rings taken)
+    bool attach(const std::string &shm_name);
+    // give the ring back; acks still in flight are dropped
+    void detach();
+    bool attached() const { return hdr_ != nullptr; }
+
+    // queue one append; false if the ring or the completion window is
+    // full (poll first) or the record exceeds max_record()
+    bool try_append(int client_id, int req_id, const void *data, size_t len, uint64_t log_id = 0);
+    // take up to max acks, in append order; returns how many
+    size_t poll(Ack *out, size_t max);
+
+    size_t outstanding() const { return (size_t)(submitted_ - completed_); }
+    size_t max_record() const;
+    // false once the sequencer stopped serving the ring
+    bool server_up() const;
+
+private:
+    shm_ring::RingHeader *hdr_ = nullptr;
+    size_t map_len_ = 0;
+    uint64_t head_ = 0;        // our copy of req_head
+    uint64_t submitted_ = 0;   // completions expected so far (slot counter)
+    uint64_t completed_ = 0;   // our copy of comp_tail
+};
@@ -0,0 +1,138 @@
+#pragma once
+#include "repl_transport.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace sequencer_internal {
+class ReplicateAppendRequest;
+class ReplicateAppendReply;
+}
+
+// Wire format of the TCP replication transport. Both ends are replicas of
+// the same build, so fields are in host byte order and naturally aligned.
+// A connection carries frames: a FrameHeader, then body_len bytes. An
+// ENTRIES frame (leader -> follower) holds count entries, each an
+// EntryHeader followed by record_len record bytes; an ACKS frame (follower
+// -> leader) holds count AckRecords, one per entry, in order.
+namespace tcp_repl {
+
+const uint32_t MAGIC = 0x4c5a4c47;          // "GLZL"
+const uint32_t MAX_FRAME = 64u << 20;       // body_len bound; larger = corrupt
+
+enum FrameKind : uint32_t { ENTRIES = 1, ACKS = 2 };
+
+struct FrameHeader {
+    uint32_t magic;
+    uint32_t kind;
+    uint32_t count;
+    uint32_t body_len;
+};
+
+struct EntryHeader {
+    uint64_t seq;            // sender's id, echoed in the ack
+    int64_t local_index;
+    int64_t global_pos;
+    int64_t view;
+    int64_t log_pos;
+    uint64_t trace_id;
+    uint64_t log_id;
+    int32_t client_id;
+    int32_t req_id;
+    int32_t shard;
+    uint32_t record_len;
+};
+
+struct AckRecord {
+    uint64_t seq;
+    int64_t view;
+    uint32_t ok;
+    uint32_t pad;
+};
+
+static_assert(sizeof(FrameHeader) == 16, "FrameHeader layout");
+static_assert(sizeof(EntryHeader) == 72, "EntryHeader layout");
+static_assert(sizeof(AckRecord) == 24, "AckRecord layout");
+
+}  // namespace tcp_repl
+
+// Leader side: one persistent connection per follower, driven by an epoll
+// thread that reads acks and drains output the socket would not take at
+// once. begin() writes the frame with writev straight from the log entry
+// under the sequencer lock (non-blocking); only a remainder the socket
+// buffer cannot take is copied, so nothing points into the log afterwards.
+class TcpReplicationClient : public ReplicationTransport {
+public:
+    explicit TcpReplicationClient(int timeout_ms);
+    ~TcpReplicationClient();
+
+    // the follower at addr (its gRPC address) takes TCP replication on
+    // port of the same host; 0 removes the route
+    void set_route(const std::string &addr, int port);
+
+    // true if addr has a route and a connected socket, connecting first if
+    // needed (bounded, with backoff after a failure). Call it without the
+    // sequencer lock; followers without a connection use gRPC instead.
+    bool connect(const std::string &addr);
+
+    std::unique_ptr<ReplicationCall> begin(const std::vector<std::string> &addrs,
+                                           int64_t local_index, const SequencerLog::Entry &e,
+                                           int64_t view, uint64_t trace_id) override;
+
+    struct Peer;
+    struct CallState;
+
+private:
+    void loop();
+    void on_readable(Peer *p);
+    void on_writable(Peer *p);
+    void fail_peer_locked(Peer *p, const std::string &why);
+    std::shared_ptr<Peer> find_peer(const std::string &addr);
+
+    int timeout_ms_;
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    std::atomic<bool> stop_{false};
+    std::atomic<uint64_t> next_seq_{1};
+    std::mutex peers_mu_;
+    std::unordered_map<std::string, std::shared_ptr<Peer>> peers_;
+    std::thread thread_;
+
+    friend class TcpReplicationCall;
+};
+
+// Follower side: accepts leader connections and hands every entry to the
+// handler (Sequencer::handle_replicate), acking each frame in one write.
+// One epoll thread serves all connections.
+class TcpReplicationServer {
+public:
+    using Handler = std::function<void(sequencer_internal::ReplicateAppendRequest *,
+                                       sequencer_internal::ReplicateAppendReply *)>;
+
+    explicit TcpReplicationServer(Handler handler);
+    ~TcpReplicationServer();
+
+    // listen on port (0 picks a free one); returns the bound port, 0 on failure
+    int start(int port);
+    void stop();
+
+private:
+    struct Conn;
+    void loop();
+    bool on_readable(Conn *c);
+    bool flush(Conn *c);
+
+    Handler handler_;
+    int listen_fd_ = -1;
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    std::atomic<bool> stop_{false};
+    std::unordered_map<int, std::unique_ptr<Conn>> conns_;   // epoll thread only
+    std::thread thread_;
+};
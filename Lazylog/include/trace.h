@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Sampled per-append tracing. The leader gives 1 in sample_every appends a
+// trace id, which reaches the followers in ReplicateAppendRequest.trace_id;
+// every replica records the spans of traced requests it handles. Spans are
+// written as Chrome trace events (JSON array form, so a file cut short by a
+// crash still loads) in chrome://tracing or ui.perfetto.dev. Each replica
+// uses its port as pid and wall-clock timestamps, so the files of all
+// replicas on a host can be opened together as one timeline.
+class Tracer {
+public:
+    ~Tracer() { close(); }
+
+    // start writing to path; pid/label name this replica's track
+    bool open(const std::string &path, int sample_every, int pid, const std::string &label);
+    // write out buffered spans and finish the file
+    void close();
+
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // a fresh trace id for 1 in sample_every calls, 0 otherwise
+    uint64_t sample();
+
+    // completed span [start_us, end_us) on the steady clock, on the
+    // calling thread's track; detail is shown in the span's args
+    void span(uint64_t trace_id, const char *name, int64_t start_us, int64_t end_us,
+              const std::string &detail = "");
+
+    // spans lost because the writer fell behind
+    int64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Event {
+        uint64_t trace_id;
+        const char *name;
+        int64_t start_us;
+        int64_t dur_us;
+        int tid;
+        std::string detail;
+    };
+
+    void writer_loop();
+    void write_events(const std::vector<Event> &events);
+
+    std::atomic<bool> enabled_{false};
+    int sample_every_ = 0;
+    std::atomic<uint64_t> sampled_{0};
+    uint64_t id_base_ = 0;
+    int pid_ = 0;
+    int64_t wall_offset_us_ = 0;   // steady -> wall clock
+    std::atomic<int64_t> dropped_{0};
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::vector<Event> buffer_;
+    std::FILE *out_ = nullptr;
+    std::thread writer_;
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include <string>
+
+// gRPC address of a Unix domain socket given as on the command line
+// (--uds=...): "@name" is a Linux abstract-namespace socket, which leaves
+// no file behind, anything else a filesystem path. Usable both as a
+// server listening address and as a client channel target.
+inline std::string uds_target(const std::string &uds) {
+    if (!uds.empty() && uds[0] == '@') return "unix-abstract:" + uds.substr(1);
+    return "unix:" + uds;
+}
@@ -22,6 +22,12 @@ rm -f "$LOG_DIR"/*
 
 PORTS=(50051 50052 50053)
 
+# Failover tuning: heartbeats every HEARTBEAT_MS, the next replica in line
+# takes over after LEASE_MS of silence; ZK session expiry is the fallback.
+ZK_SESSION_TIMEOUT_MS=${ZK_SESSION_TIMEOUT_MS:-4000}
+HEARTBEAT_MS=${HEARTBEAT_MS:-100}
+LEASE_MS=${LEASE_MS:-400}
+
 echo "====================================================="
 echo "[STEP 1] Starting replicas (ALL as FOLLOWERS)..."
 echo "====================================================="
@@ -32,11 +38,21 @@ echo "====================================================="
 PIDS=()
 i=0
 for PORT in "${PORTS[@]}"; do
-    echo "[START] Replica $i on port $PORT"
+    # every replica may become leader, so each one lists the others
+    FOLLOWERS=""
+    for P in "${PORTS[@]}"; do
+        [[ "$P" == "$PORT" ]] && continue
+        FOLLOWERS+="${FOLLOWERS:+,}127.0.0.1:$P"
+    done
+    echo "[START] Replica $i on port $PORT (followers: $FOLLOWERS)"
     stdbuf -i0 -o0 -e0 ./sequencer \
         --id=$i \
         --role=follower \
         --port=$PORT \
+        --followers=$FOLLOWERS \
+        --zk_session_timeout_ms=$ZK_SESSION_TIMEOUT_MS \
+        --heartbeat_ms=$HEARTBEAT_MS \
+        --lease_ms=$LEASE_MS \
         > "$LOG_DIR/replica_$i.log" 2>&1 &
     PIDS+=($!)
     ((i++))
@@ -50,80 +66,55 @@ echo "[WAIT] Allowing time for ZooKeeper leader election..."
 sleep 5
 
 ############################################################
-# 4) DETECT ELECTED LEADER BASED ON SMALLEST SEQ NODE
+# 4) SEND CLIENT APPENDS (the client finds the leader)
 ############################################################
 echo "====================================================="
-echo "[STEP 2] Detecting elected leader from logs..."
+echo "[STEP 2] Sending client appends; any replica is a seed"
 echo "====================================================="
 
-LEADER_PORT=""
-leader_index=-1
-min_seq=999999999
-
-for i in "${!PORTS[@]}"; do
-    LOGFILE="$LOG_DIR/replica_$i.log"
-    PORT=${PORTS[$i]}
-
-    # Extract election node name
-    line=$(grep "My election node:" "$LOGFILE" | tail -n1)
-    if [[ -z "$line" ]]; then
-        echo "[WARN] Replica $i produced no election node line!"
-        continue
-    fi
-
-    # Extract node-XXXXXXXXXX
-    node_name=$(echo "$line" | sed -E 's#.*(node-[0-9]+).*#\1#')
-    seq=$(echo "$node_name" | sed -E 's/node-0*//')
-
-    echo "[DEBUG] Replica $i -> $node_name -> seq=$seq"
-
-    if (( seq < min_seq )); then
-        min_seq=$seq
-        leader_index=$i
-        LEADER_PORT=$PORT
-    fi
+SEEDS=""
+for PORT in "${PORTS[@]}"; do
+    SEEDS="${SEEDS:+$SEEDS,}127.0.0.1:$PORT"
 done
 
-if [[ -z "$LEADER_PORT" ]]; then
-    echo "❌ ERROR: Could not determine leader."
-    echo "Check logs in $LOG_DIR"
-    exit 1
-fi
-
-echo ""
-echo "====================================================="
-echo "✅ Leader elected: Replica $leader_index (port $LEADER_PORT)"
-echo "====================================================="
-echo ""
-
-############################################################
-# 5) SEND CLIENT APPENDS TO THE LEADER
-############################################################
-echo "[STEP 3] Sending client appends to elected leader ($LEADER_PORT)..."
-
 RECORDS=("Hello" "World" "Test1" "Test2" "Test3")
 
+LEADER_ADDR=""
 i=0
 for rec in "${RECORDS[@]}"; do
-    echo "[CLIENT] Sending '$rec' to leader $LEADER_PORT"
+    echo "[CLIENT] Sending '$rec' (seeds $SEEDS)"
     stdbuf -i0 -o0 -e0 ./append_client \
         --id=$((2000 + i)) \
         --record="$rec" \
-        --server_addr=127.0.0.1:$LEADER_PORT \
+        --seeds="$SEEDS" \
         > "$LOG_DIR/client_$i.log" 2>&1
+    leader=$(grep -o 'leader=[^ ]*' "$LOG_DIR/client_$i.log" | cut -d= -f2)
+    [[ -n "$leader" ]] && LEADER_ADDR=$leader
     ((i++))
     sleep 0.2
 done
 
+if [[ -z "$LEADER_ADDR" ]]; then
+    echo "❌ ERROR: No append succeeded."
+    echo "Check logs in $LOG_DIR"
+    exit 1
+fi
+
+echo ""
+echo "====================================================="
+echo "✅ Leader elected: $LEADER_ADDR"
+echo "====================================================="
+echo ""
+
 ############################################################
-# 6) SUMMARY OUTPUT
+# 5) SUMMARY OUTPUT
 ############################################################
 echo ""
 echo "====================================================="
 echo "[DONE] Execution complete."
 echo "-----------------------------------------------------"
 echo "Replica PIDs: ${PIDS[@]}"
-echo "Leader was: $LEADER_PORT"
+echo "Leader was: $LEADER_ADDR"
 echo ""
 echo "Logs stored in $LOG_DIR"
 echo "-----------------------------------------------------"
@@ -0,0 +1,60 @@
+#include "checkpoint.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+
+static bool write_all(int fd, const std::string &data) {
+    size_t off = 0;
+    while (off < data.size()) {
+        ssize_t n = ::write(fd, data.data() + off, data.size() - off);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        off += (size_t)n;
+    }
+    return true;
+}
+
+// the rename is only durable once the directory entry is
+static void fsync_parent_dir(const std::string &path) {
+    size_t slash = path.rfind('/');
+    std::string dir = slash == std::string::npos ? "." : path.substr(0, slash);
+    int fd = ::open(dir.empty() ? "/" : dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) return;
+    ::fsync(fd);
+    ::close(fd);
+}
+
+bool write_checkpoint_file(const std::string &path, const sequencer_internal::Checkpoint &ckpt) {
+    std::string data;
+    if (!ckpt.SerializeToString(&data)) return false;
+
+    std::string tmp = path + ".tmp";
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "[CKPT] cannot open " << tmp << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+    bool ok = write_all(fd, data) && ::fsync(fd) == 0;
+    ::close(fd);
+    if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::cerr << "[CKPT] cannot write " << path << ": " << std::strerror(errno) << "\n";
+        ::unlink(tmp.c_str());
+        return false;
+    }
+    fsync_parent_dir(path);
+    return true;
+}
+
+bool read_checkpoint_file(const std::string &path, sequencer_internal::Checkpoint *ckpt) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    if (!ckpt->ParseFromIstream(&in)) {
+        std::cerr << "[CKPT] " << path << " is corrupt, ignoring it\n";
+        return false;
+    }
+    return true;
+}
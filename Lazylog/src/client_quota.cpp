@@ -0,0 +1,118 @@
+#include "client_quota.h"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+// slots probed from a client's hash before it falls back to the overflow bucket
+static const size_t MAX_PROBES = 32;
+
+// time n tokens take to refill at rate per second
+static int64_t cost_ns(int64_t n, int64_t rate) {
+    return n * (1000000000 / rate) + n * (1000000000 % rate) / rate;
+}
+
+static int64_t steady_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ClientQuotas::configure(Rates defaults, int burst_ms, size_t slots,
+                             std::unordered_map<int32_t, Rates> overrides) {
+    defaults_ = defaults;
+    burst_ns_ = std::max<int64_t>(burst_ms, 1) * 1000000;
+    overrides_ = std::move(overrides);
+    enabled_ = defaults_.records_per_s > 0 || defaults_.bytes_per_s > 0 || !overrides_.empty();
+    if (!enabled_) return;
+    size_t n = 64;
+    while (n < slots) n <<= 1;
+    slots_.reset(new Slot[n]);
+    mask_ = n - 1;
+    overflow_.records_per_s.store(defaults_.records_per_s);
+    overflow_.bytes_per_s.store(defaults_.bytes_per_s);
+}
+
+bool ClientQuotas::parse_overrides(const std::string &spec, std::unordered_map<int32_t, Rates> *out) {
+    std::stringstream list(spec);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        if (item.empty()) continue;
+        size_t a = item.find(':');
+        size_t b = a == std::string::npos ? a : item.find(':', a + 1);
+        if (b == std::string::npos) return false;
+        try {
+            Rates r;
+            r.records_per_s = std::stoll(item.substr(a + 1, b - a - 1));
+            r.bytes_per_s = std::stoll(item.substr(b + 1));
+            (*out)[std::stoi(item.substr(0, a))] = r;
+        } catch (const std::exception &) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ClientQuotas::Slot &ClientQuotas::slot_for(int32_t client_id) {
+    const int64_t key = (int64_t)client_id + 1;   // never 0 or -1 for an int32
+    size_t i = (size_t)((uint64_t)(uint32_t)client_id * 0x9E3779B97F4A7C15ULL >> 32) & mask_;
+    for (size_t probe = 0; probe < MAX_PROBES; ++probe, i = (i + 1) & mask_) {
+        Slot &s = slots_[i];
+        int64_t k = s.key.load(std::memory_order_acquire);
+        if (k == 0) {
+            // claim it; the rates are written before the key is published
+            if (s.key.compare_exchange_strong(k, -1, std::memory_order_acq_rel)) {
+                auto it = overrides_.find(client_id);
+                const Rates &r = it == overrides_.end() ? defaults_ : it->second;
+                s.records_per_s.store(r.records_per_s, std::memory_order_relaxed);
+                s.bytes_per_s.store(r.bytes_per_s, std::memory_order_relaxed);
+                s.key.store(key, std::memory_order_release);
+                used_.fetch_add(1, std::memory_order_relaxed);
+                return s;
+            }
+        }
+        // another thread is claiming this slot, maybe for the same client
+        while (k == -1) {
+            std::this_thread::yield();
+            k = s.key.load(std::memory_order_acquire);
+        }
+        if (k == key) return s;
+    }
+    return overflow_;
+}
+
+int64_t ClientQuotas::take_from(std::atomic<int64_t> &full_ns, int64_t rate, int64_t n, int64_t now) {
+    if (rate <= 0) return 0;
+    const int64_t cost = cost_ns(n, rate);
+    // a request costing more than the whole bucket passes once it is full
+    const int64_t limit = std::max(burst_ns_, cost);
+    int64_t old = full_ns.load(std::memory_order_relaxed);
+    while (true) {
+        int64_t next = std::max(old, now) + cost;
+        if (next - now > limit) return next - now - limit;
+        if (full_ns.compare_exchange_weak(old, next, std::memory_order_relaxed)) return 0;
+    }
+}
+
+void ClientQuotas::put_back(std::atomic<int64_t> &full_ns, int64_t rate, int64_t n) {
+    if (rate > 0) full_ns.fetch_sub(cost_ns(n, rate));
+}
+
+int64_t ClientQuotas::take(int32_t client_id, int64_t records, int64_t bytes) {
+    if (!enabled_) return 0;
+    Slot &s = slot_for(client_id);
+    int64_t now = steady_ns();
+    int64_t rec_rate = s.records_per_s.load(std::memory_order_relaxed);
+    int64_t wait = take_from(s.records_full_ns, rec_rate, records, now);
+    if (wait == 0) {
+        wait = take_from(s.bytes_full_ns, s.bytes_per_s.load(std::memory_order_relaxed), bytes, now);
+        if (wait > 0) put_back(s.records_full_ns, rec_rate, records);
+    }
+    return wait > 0 ? (wait + 999) / 1000 : 0;
+}
+
+void ClientQuotas::give_back(int32_t client_id, int64_t records, int64_t bytes) {
+    if (!enabled_) return;
+    Slot &s = slot_for(client_id);
+    put_back(s.records_full_ns, s.records_per_s.load(std::memory_order_relaxed), records);
+    put_back(s.bytes_full_ns, s.bytes_per_s.load(std::memory_order_relaxed), bytes);
+}
@@ -1,91 +0,0 @@
-// Generated by the gRPC C++ plugin.
-// If you make any local change, they will be lost.
-// source: sequencer.proto
-
-#include "sequencer.pb.h"
-#include "sequencer.grpc.pb.h"
-
-#include <functional>
-#include <grpcpp/impl/codegen/async_stream.h>
-#include <grpcpp/impl/codegen/async_unary_call.h>
-#include <grpcpp/impl/codegen/channel_interface.h>
-#include <grpcpp/impl/codegen/client_unary_call.h>
-#include <grpcpp/impl/codegen/client_callback.h>
-#include <grpcpp/impl/codegen/message_allocator.h>
-#include <grpcpp/impl/codegen/method_handler.h>
-#include <grpcpp/impl/codegen/rpc_service_method.h>
-#include <grpcpp/impl/codegen/server_callback.h>
-#include <grpcpp/impl/codegen/server_callback_handlers.h>
-#include <grpcpp/impl/codegen/server_context.h>
-#include <grpcpp/impl/codegen/service_type.h>
-#include <grpcpp/impl/codegen/sync_stream.h>
-namespace sequencer {
-
-static const char* SequencerService_method_names[] = {
-  "/sequencer.SequencerService/Append",
-};
-
-std::unique_ptr< SequencerService::Stub> SequencerService::NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options) {
-  (void)options;
-  std::unique_ptr< SequencerService::Stub> stub(new SequencerService::Stub(channel));
-  return stub;
-}
-
-SequencerService::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channel)
-  : channel_(channel), rpcmethod_Append_(SequencerService_method_names[0], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
-  {}
-
-::grpc::Status SequencerService::Stub::Append(::grpc::ClientContext* context, const ::sequencer::AppendRequest& request, ::sequencer::AppendReply* response) {
-  return ::grpc::internal::BlockingUnaryCall(channel_.get(), rpcmethod_Append_, context, request, response);
-}
-
-void SequencerService::Stub::experimental_async::Append(::grpc::ClientContext* context, const ::sequencer::AppendRequest* request, ::sequencer::AppendReply* response, std::function<void(::grpc::Status)> f) {
-  ::grpc_impl::internal::CallbackUnaryCall(stub_->channel_.get(), stub_->rpcmethod_Append_, context, request, response, std::move(f));
-}
-
-void SequencerService::Stub::experimental_async::Append(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer::AppendReply* response, std::function<void(::grpc::Status)> f) {
-  ::grpc_impl::internal::CallbackUnaryCall(stub_->channel_.get(), stub_->rpcmethod_Append_, context, request, response, std::move(f));
-}
-
-void SequencerService::Stub::experimental_async::Append(::grpc::ClientContext* context, const ::sequencer::AppendRequest* request, ::sequencer::AppendReply* response, ::grpc::experimental::ClientUnaryReactor* reactor) {
-  ::grpc_impl::internal::ClientCallbackUnaryFactory::Create(stub_->channel_.get(), stub_->rpcmethod_Append_, context, request, response, reactor);
-}
-
-void SequencerService::Stub::experimental_async::Append(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer::AppendReply* response, ::grpc::experimental::ClientUnaryReactor* reactor) {
-  ::grpc_impl::internal::ClientCallbackUnaryFactory::Create(stub_->channel_.get(), stub_->rpcmethod_Append_, context, request, response, reactor);
-}
-
-::grpc::ClientAsyncResponseReader< ::sequencer::AppendReply>* SequencerService::Stub::AsyncAppendRaw(::grpc::ClientContext* context, const ::sequencer::AppendRequest& request, ::grpc::CompletionQueue* cq) {
-  return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::sequencer::AppendReply>::Create(channel_.get(), cq, rpcmethod_Append_, context, request, true);
-}
-
-::grpc::ClientAsyncResponseReader< ::sequencer::AppendReply>* SequencerService::Stub::PrepareAsyncAppendRaw(::grpc::ClientContext* context, const ::sequencer::AppendRequest& request, ::grpc::CompletionQueue* cq) {
-  return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::sequencer::AppendReply>::Create(channel_.get(), cq, rpcmethod_Append_, context, request, false);
-}
-
-SequencerService::Service::Service() {
-  AddMethod(new ::grpc::internal::RpcServiceMethod(
-      SequencerService_method_names[0],
-      ::grpc::internal::RpcMethod::NORMAL_RPC,
-      new ::grpc::internal::RpcMethodHandler< SequencerService::Service, ::sequencer::AppendRequest, ::sequencer::AppendReply>(
-          [](SequencerService::Service* service,
-             ::grpc_impl::ServerContext* ctx,
-             const ::sequencer::AppendRequest* req,
-             ::sequencer::AppendReply* resp) {
-               return service->Append(ctx, req, resp);
-             }, this)));
-}
-
-SequencerService::Service::~Service() {
-}
-
-::grpc::Status SequencerService::Service::Append(::grpc::ServerContext* context, const ::sequencer::AppendRequest* request, ::sequencer::AppendReply* response) {
-  (void) context;
-  (void) request;
-  (void) response;
-  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-}
-
-
-}  // namespace sequencer
-
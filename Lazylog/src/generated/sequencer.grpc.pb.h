@@ -1,304 +0,0 @@
-// Generated by the gRPC C++ plugin.
-// If you make any local change, they will be lost.
-// source: sequencer.proto
-#ifndef GRPC_sequencer_2eproto__INCLUDED
-#define GRPC_sequencer_2eproto__INCLUDED
-
-#include "sequencer.pb.h"
-
-#include <functional>
-#include <grpc/impl/codegen/port_platform.h>
-#include <grpcpp/impl/codegen/async_generic_service.h>
-#include <grpcpp/impl/codegen/async_stream.h>
-#include <grpcpp/impl/codegen/async_unary_call.h>
-#include <grpcpp/impl/codegen/client_callback.h>
-#include <grpcpp/impl/codegen/client_context.h>
-#include <grpcpp/impl/codegen/completion_queue.h>
-#include <grpcpp/impl/codegen/message_allocator.h>
-#include <grpcpp/impl/codegen/method_handler.h>
-#include <grpcpp/impl/codegen/proto_utils.h>
-#include <grpcpp/impl/codegen/rpc_method.h>
-#include <grpcpp/impl/codegen/server_callback.h>
-#include <grpcpp/impl/codegen/server_callback_handlers.h>
-#include <grpcpp/impl/codegen/server_context.h>
-#include <grpcpp/impl/codegen/service_type.h>
-#include <grpcpp/impl/codegen/status.h>
-#include <grpcpp/impl/codegen/stub_options.h>
-#include <grpcpp/impl/codegen/sync_stream.h>
-
-namespace sequencer {
-
-class SequencerService final {
- public:
-  static constexpr char const* service_full_name() {
-    return "sequencer.SequencerService";
-  }
-  class StubInterface {
-   public:
-    virtual ~StubInterface() {}
-    virtual ::grpc::Status Append(::grpc::ClientContext* context, const ::sequencer::AppendRequest& request, ::sequencer::AppendReply* response) = 0;
-    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::sequencer::AppendReply>> AsyncAppend(::grpc::ClientContext* context, const ::sequencer::AppendRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::sequencer::AppendReply>>(AsyncAppendRaw(context, request, cq));
-    }
-    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::sequencer::AppendReply>> PrepareAsyncAppend(::grpc::ClientContext* context, const ::sequencer::AppendRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::sequencer::AppendReply>>(PrepareAsyncAppendRaw(context, request, cq));
-    }
-    class experimental_async_interface {
-     public:
-      virtual ~experimental_async_interface() {}
-      virtual void Append(::grpc::ClientContext* context, const ::sequencer::AppendRequest* request, ::sequencer::AppendReply* response, std::function<void(::grpc::Status)>) = 0;
-      virtual void Append(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer::AppendReply* response, std::function<void(::grpc::Status)>) = 0;
-      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      virtual void Append(::grpc::ClientContext* context, const ::sequencer::AppendRequest* request, ::sequencer::AppendReply* response, ::grpc::ClientUnaryReactor* reactor) = 0;
-      #else
-      virtual void Append(::grpc::ClientContext* context, const ::sequencer::AppendRequest* request, ::sequencer::AppendReply* response, ::grpc::experimental::ClientUnaryReactor* reactor) = 0;
-      #endif
-      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      virtual void Append(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer::AppendReply* response, ::grpc::ClientUnaryReactor* reactor) = 0;
-      #else
-      virtual void Append(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer::AppendReply* response, ::grpc::experimental::ClientUnaryReactor* reactor) = 0;
-      #endif
-    };
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-    typedef class experimental_async_interface async_interface;
-    #endif
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-    async_interface* async() { return experimental_async(); }
-    #endif
-    virtual class experimental_async_interface* experimental_async() { return nullptr; }
-  private:
-    virtual ::grpc::ClientAsyncResponseReaderInterface< ::sequencer::AppendReply>* AsyncAppendRaw(::grpc::ClientContext* context, const ::sequencer::AppendRequest& request, ::grpc::CompletionQueue* cq) = 0;
-    virtual ::grpc::ClientAsyncResponseReaderInterface< ::sequencer::AppendReply>* PrepareAsyncAppendRaw(::grpc::ClientContext* context, const ::sequencer::AppendRequest& request, ::grpc::CompletionQueue* cq) = 0;
-  };
-  class Stub final : public StubInterface {
-   public:
-    Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channel);
-    ::grpc::Status Append(::grpc::ClientContext* context, const ::sequencer::AppendRequest& request, ::sequencer::AppendReply* response) override;
-    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::sequencer::AppendReply>> AsyncAppend(::grpc::ClientContext* context, const ::sequencer::AppendRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::sequencer::AppendReply>>(AsyncAppendRaw(context, request, cq));
-    }
-    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::sequencer::AppendReply>> PrepareAsyncAppend(::grpc::ClientContext* context, const ::sequencer::AppendRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::sequencer::AppendReply>>(PrepareAsyncAppendRaw(context, request, cq));
-    }
-    class experimental_async final :
-      public StubInterface::experimental_async_interface {
-     public:
-      void Append(::grpc::ClientContext* context, const ::sequencer::AppendRequest* request, ::sequencer::AppendReply* response, std::function<void(::grpc::Status)>) override;
-      void Append(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer::AppendReply* response, std::function<void(::grpc::Status)>) override;
-      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      void Append(::grpc::ClientContext* context, const ::sequencer::AppendRequest* request, ::sequencer::AppendReply* response, ::grpc::ClientUnaryReactor* reactor) override;
-      #else
-      void Append(::grpc::ClientContext* context, const ::sequencer::AppendRequest* request, ::sequencer::AppendReply* response, ::grpc::experimental::ClientUnaryReactor* reactor) override;
-      #endif
-      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      void Append(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer::AppendReply* response, ::grpc::ClientUnaryReactor* reactor) override;
-      #else
-      void Append(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer::AppendReply* response, ::grpc::experimental::ClientUnaryReactor* reactor) override;
-      #endif
-     private:
-      friend class Stub;
-      explicit experimental_async(Stub* stub): stub_(stub) { }
-      Stub* stub() { return stub_; }
-      Stub* stub_;
-    };
-    class experimental_async_interface* experimental_async() override { return &async_stub_; }
-
-   private:
-    std::shared_ptr< ::grpc::ChannelInterface> channel_;
-    class experimental_async async_stub_{this};
-    ::grpc::ClientAsyncResponseReader< ::sequencer::AppendReply>* AsyncAppendRaw(::grpc::ClientContext* context, const ::sequencer::AppendRequest& request, ::grpc::CompletionQueue* cq) override;
-    ::grpc::ClientAsyncResponseReader< ::sequencer::AppendReply>* PrepareAsyncAppendRaw(::grpc::ClientContext* context, const ::sequencer::AppendRequest& request, ::grpc::CompletionQueue* cq) override;
-    const ::grpc::internal::RpcMethod rpcmethod_Append_;
-  };
-  static std::unique_ptr<Stub> NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options = ::grpc::StubOptions());
-
-  class Service : public ::grpc::Service {
-   public:
-    Service();
-    virtual ~Service();
-    virtual ::grpc::Status Append(::grpc::ServerContext* context, const ::sequencer::AppendRequest* request, ::sequencer::AppendReply* response);
-  };
-  template <class BaseClass>
-  class WithAsyncMethod_Append : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithAsyncMethod_Append() {
-      ::grpc::Service::MarkMethodAsync(0);
-    }
-    ~WithAsyncMethod_Append() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status Append(::grpc::ServerContext* /*context*/, const ::sequencer::AppendRequest* /*request*/, ::sequencer::AppendReply* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    void RequestAppend(::grpc::ServerContext* context, ::sequencer::AppendRequest* request, ::grpc::ServerAsyncResponseWriter< ::sequencer::AppendReply>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
-      ::grpc::Service::RequestAsyncUnary(0, context, request, response, new_call_cq, notification_cq, tag);
-    }
-  };
-  typedef WithAsyncMethod_Append<Service > AsyncService;
-  template <class BaseClass>
-  class ExperimentalWithCallbackMethod_Append : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    ExperimentalWithCallbackMethod_Append() {
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      ::grpc::Service::
-    #else
-      ::grpc::Service::experimental().
-    #endif
-        MarkMethodCallback(0,
-          new ::grpc_impl::internal::CallbackUnaryHandler< ::sequencer::AppendRequest, ::sequencer::AppendReply>(
-            [this](
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-                   ::grpc::CallbackServerContext*
-    #else
-                   ::grpc::experimental::CallbackServerContext*
-    #endif
-                     context, const ::sequencer::AppendRequest* request, ::sequencer::AppendReply* response) { return this->Append(context, request, response); }));}
-    void SetMessageAllocatorFor_Append(
-        ::grpc::experimental::MessageAllocator< ::sequencer::AppendRequest, ::sequencer::AppendReply>* allocator) {
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      ::grpc::internal::MethodHandler* const handler = ::grpc::Service::GetHandler(0);
-    #else
-      ::grpc::internal::MethodHandler* const handler = ::grpc::Service::experimental().GetHandler(0);
-    #endif
-      static_cast<::grpc_impl::internal::CallbackUnaryHandler< ::sequencer::AppendRequest, ::sequencer::AppendReply>*>(handler)
-              ->SetMessageAllocator(allocator);
-    }
-    ~ExperimentalWithCallbackMethod_Append() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status Append(::grpc::ServerContext* /*context*/, const ::sequencer::AppendRequest* /*request*/, ::sequencer::AppendReply* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-    virtual ::grpc::ServerUnaryReactor* Append(
-      ::grpc::CallbackServerContext* /*context*/, const ::sequencer::AppendRequest* /*request*/, ::sequencer::AppendReply* /*response*/)
-    #else
-    virtual ::grpc::experimental::ServerUnaryReactor* Append(
-      ::grpc::experimental::CallbackServerContext* /*context*/, const ::sequencer::AppendRequest* /*request*/, ::sequencer::AppendReply* /*response*/)
-    #endif
-      { return nullptr; }
-  };
-  #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-  typedef ExperimentalWithCallbackMethod_Append<Service > CallbackService;
-  #endif
-
-  typedef ExperimentalWithCallbackMethod_Append<Service > ExperimentalCallbackService;
-  template <class BaseClass>
-  class WithGenericMethod_Append : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithGenericMethod_Append() {
-      ::grpc::Service::MarkMethodGeneric(0);
-    }
-    ~WithGenericMethod_Append() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status Append(::grpc::ServerContext* /*context*/, const ::sequencer::AppendRequest* /*request*/, ::sequencer::AppendReply* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-  };
-  template <class BaseClass>
-  class WithRawMethod_Append : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithRawMethod_Append() {
-      ::grpc::Service::MarkMethodRaw(0);
-    }
-    ~WithRawMethod_Append() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status Append(::grpc::ServerContext* /*context*/, const ::sequencer::AppendRequest* /*request*/, ::sequencer::AppendReply* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    void RequestAppend(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncResponseWriter< ::grpc::ByteBuffer>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
-      ::grpc::Service::RequestAsyncUnary(0, context, request, response, new_call_cq, notification_cq, tag);
-    }
-  };
-  template <class BaseClass>
-  class ExperimentalWithRawCallbackMethod_Append : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    ExperimentalWithRawCallbackMethod_Append() {
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      ::grpc::Service::
-    #else
-      ::grpc::Service::experimental().
-    #endif
-        MarkMethodRawCallback(0,
-          new ::grpc_impl::internal::CallbackUnaryHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
-            [this](
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-                   ::grpc::CallbackServerContext*
-    #else
-                   ::grpc::experimental::CallbackServerContext*
-    #endif
-                     context, const ::grpc::ByteBuffer* request, ::grpc::ByteBuffer* response) { return this->Append(context, request, response); }));
-    }
-    ~ExperimentalWithRawCallbackMethod_Append() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status Append(::grpc::ServerContext* /*context*/, const ::sequencer::AppendRequest* /*request*/, ::sequencer::AppendReply* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-    virtual ::grpc::ServerUnaryReactor* Append(
-      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)
-    #else
-    virtual ::grpc::experimental::ServerUnaryReactor* Append(
-      ::grpc::experimental::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)
-    #endif
-      { return nullptr; }
-  };
-  template <class BaseClass>
-  class WithStreamedUnaryMethod_Append : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithStreamedUnaryMethod_Append() {
-      ::grpc::Service::MarkMethodStreamed(0,
-        new ::grpc::internal::StreamedUnaryHandler<
-          ::sequencer::AppendRequest, ::sequencer::AppendReply>(
-            [this](::grpc_impl::ServerContext* context,
-                   ::grpc_impl::ServerUnaryStreamer<
-                     ::sequencer::AppendRequest, ::sequencer::AppendReply>* streamer) {
-                       return this->StreamedAppend(context,
-                         streamer);
-                  }));
-    }
-    ~WithStreamedUnaryMethod_Append() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable regular version of this method
-    ::grpc::Status Append(::grpc::ServerContext* /*context*/, const ::sequencer::AppendRequest* /*request*/, ::sequencer::AppendReply* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    // replace default version of method with streamed unary
-    virtual ::grpc::Status StreamedAppend(::grpc::ServerContext* context, ::grpc::ServerUnaryStreamer< ::sequencer::AppendRequest,::sequencer::AppendReply>* server_unary_streamer) = 0;
-  };
-  typedef WithStreamedUnaryMethod_Append<Service > StreamedUnaryService;
-  typedef Service SplitStreamedService;
-  typedef WithStreamedUnaryMethod_Append<Service > StreamedService;
-};
-
-}  // namespace sequencer
-
-
-#endif  // GRPC_sequencer_2eproto__INCLUDED
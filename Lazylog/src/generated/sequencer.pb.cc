@@ -1,664 +0,0 @@
-// Generated by the protocol buffer compiler.  DO NOT EDIT!
-// source: sequencer.proto
-
-#include "sequencer.pb.h"
-
-#include <algorithm>
-
-#include <google/protobuf/io/coded_stream.h>
-#include <google/protobuf/extension_set.h>
-#include <google/protobuf/wire_format_lite.h>
-#include <google/protobuf/descriptor.h>
-#include <google/protobuf/generated_message_reflection.h>
-#include <google/protobuf/reflection_ops.h>
-#include <google/protobuf/wire_format.h>
-// @@protoc_insertion_point(includes)
-#include <google/protobuf/port_def.inc>
-namespace sequencer {
-class AppendRequestDefaultTypeInternal {
- public:
-  ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<AppendRequest> _instance;
-} _AppendRequest_default_instance_;
-class AppendReplyDefaultTypeInternal {
- public:
-  ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<AppendReply> _instance;
-} _AppendReply_default_instance_;
-}  // namespace sequencer
-static void InitDefaultsscc_info_AppendReply_sequencer_2eproto() {
-  GOOGLE_PROTOBUF_VERIFY_VERSION;
-
-  {
-    void* ptr = &::sequencer::_AppendReply_default_instance_;
-    new (ptr) ::sequencer::AppendReply();
-    ::PROTOBUF_NAMESPACE_ID::internal::OnShutdownDestroyMessage(ptr);
-  }
-  ::sequencer::AppendReply::InitAsDefaultInstance();
-}
-
-::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_AppendReply_sequencer_2eproto =
-    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 0, 0, InitDefaultsscc_info_AppendReply_sequencer_2eproto}, {}};
-
-static void InitDefaultsscc_info_AppendRequest_sequencer_2eproto() {
-  GOOGLE_PROTOBUF_VERIFY_VERSION;
-
-  {
-    void* ptr = &::sequencer::_AppendRequest_default_instance_;
-    new (ptr) ::sequencer::AppendRequest();
-    ::PROTOBUF_NAMESPACE_ID::internal::OnShutdownDestroyMessage(ptr);
-  }
-  ::sequencer::AppendRequest::InitAsDefaultInstance();
-}
-
-::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_AppendRequest_sequencer_2eproto =
-    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 0, 0, InitDefaultsscc_info_AppendRequest_sequencer_2eproto}, {}};
-
-static ::PROTOBUF_NAMESPACE_ID::Metadata file_level_metadata_sequencer_2eproto[2];
-static constexpr ::PROTOBUF_NAMESPACE_ID::EnumDescriptor const** file_level_enum_descriptors_sequencer_2eproto = nullptr;
-static constexpr ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor const** file_level_service_descriptors_sequencer_2eproto = nullptr;
-
-const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_sequencer_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
-  ~0u,  // no _has_bits_
-  PROTOBUF_FIELD_OFFSET(::sequencer::AppendRequest, _internal_metadata_),
-  ~0u,  // no _extensions_
-  ~0u,  // no _oneof_case_
-  ~0u,  // no _weak_field_map_
-  PROTOBUF_FIELD_OFFSET(::sequencer::AppendRequest, client_id_),
-  PROTOBUF_FIELD_OFFSET(::sequencer::AppendRequest, req_id_),
-  PROTOBUF_FIELD_OFFSET(::sequencer::AppendRequest, record_),
-  ~0u,  // no _has_bits_
-  PROTOBUF_FIELD_OFFSET(::sequencer::AppendReply, _internal_metadata_),
-  ~0u,  // no _extensions_
-  ~0u,  // no _oneof_case_
-  ~0u,  // no _weak_field_map_
-  PROTOBUF_FIELD_OFFSET(::sequencer::AppendReply, success_),
-  PROTOBUF_FIELD_OFFSET(::sequencer::AppendReply, global_pos_),
-  PROTOBUF_FIELD_OFFSET(::sequencer::AppendReply, message_),
-};
-static const ::PROTOBUF_NAMESPACE_ID::internal::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
-  { 0, -1, sizeof(::sequencer::AppendRequest)},
-  { 8, -1, sizeof(::sequencer::AppendReply)},
-};
-
-static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] = {
-  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::sequencer::_AppendRequest_default_instance_),
-  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::sequencer::_AppendReply_default_instance_),
-};
-
-const char descriptor_table_protodef_sequencer_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
-  "\n\017sequencer.proto\022\tsequencer\"B\n\rAppendRe"
-  "quest\022\021\n\tclient_id\030\001 \001(\005\022\016\n\006req_id\030\002 \001(\005"
-  "\022\016\n\006record\030\003 \001(\t\"C\n\013AppendReply\022\017\n\007succe"
-  "ss\030\001 \001(\010\022\022\n\nglobal_pos\030\002 \001(\003\022\017\n\007message\030"
-  "\003 \001(\t2N\n\020SequencerService\022:\n\006Append\022\030.se"
-  "quencer.AppendRequest\032\026.sequencer.Append"
-  "Replyb\006proto3"
-  ;
-static const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable*const descriptor_table_sequencer_2eproto_deps[1] = {
-};
-static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_sequencer_2eproto_sccs[2] = {
-  &scc_info_AppendReply_sequencer_2eproto.base,
-  &scc_info_AppendRequest_sequencer_2eproto.base,
-};
-static ::PROTOBUF_NAMESPACE_ID::internal::once_flag descriptor_table_sequencer_2eproto_once;
-const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_sequencer_2eproto = {
-  false, false, descriptor_table_protodef_sequencer_2eproto, "sequencer.proto", 253,
-  &descriptor_table_sequencer_2eproto_once, descriptor_table_sequencer_2eproto_sccs, descriptor_table_sequencer_2eproto_deps, 2, 0,
-  schemas, file_default_instances, TableStruct_sequencer_2eproto::offsets,
-  file_level_metadata_sequencer_2eproto, 2, file_level_enum_descriptors_sequencer_2eproto, file_level_service_descriptors_sequencer_2eproto,
-};
-
-// Force running AddDescriptors() at dynamic initialization time.
-static bool dynamic_init_dummy_sequencer_2eproto = (static_cast<void>(::PROTOBUF_NAMESPACE_ID::internal::AddDescriptors(&descriptor_table_sequencer_2eproto)), true);
-namespace sequencer {
-
-// ===================================================================
-
-void AppendRequest::InitAsDefaultInstance() {
-}
-class AppendRequest::_Internal {
- public:
-};
-
-AppendRequest::AppendRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena)
-  : ::PROTOBUF_NAMESPACE_ID::Message(arena) {
-  SharedCtor();
-  RegisterArenaDtor(arena);
-  // @@protoc_insertion_point(arena_constructor:sequencer.AppendRequest)
-}
-AppendRequest::AppendRequest(const AppendRequest& from)
-  : ::PROTOBUF_NAMESPACE_ID::Message() {
-  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  record_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  if (!from._internal_record().empty()) {
-    record_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from._internal_record(),
-      GetArena());
-  }
-  ::memcpy(&client_id_, &from.client_id_,
-    static_cast<size_t>(reinterpret_cast<char*>(&req_id_) -
-    reinterpret_cast<char*>(&client_id_)) + sizeof(req_id_));
-  // @@protoc_insertion_point(copy_constructor:sequencer.AppendRequest)
-}
-
-void AppendRequest::SharedCtor() {
-  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_AppendRequest_sequencer_2eproto.base);
-  record_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  ::memset(&client_id_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&req_id_) -
-      reinterpret_cast<char*>(&client_id_)) + sizeof(req_id_));
-}
-
-AppendRequest::~AppendRequest() {
-  // @@protoc_insertion_point(destructor:sequencer.AppendRequest)
-  SharedDtor();
-  _internal_metadata_.Delete<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
-}
-
-void AppendRequest::SharedDtor() {
-  GOOGLE_DCHECK(GetArena() == nullptr);
-  record_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-}
-
-void AppendRequest::ArenaDtor(void* object) {
-  AppendRequest* _this = reinterpret_cast< AppendRequest* >(object);
-  (void)_this;
-}
-void AppendRequest::RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena*) {
-}
-void AppendRequest::SetCachedSize(int size) const {
-  _cached_size_.Set(size);
-}
-const AppendRequest& AppendRequest::default_instance() {
-  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&::scc_info_AppendRequest_sequencer_2eproto.base);
-  return *internal_default_instance();
-}
-
-
-void AppendRequest::Clear() {
-// @@protoc_insertion_point(message_clear_start:sequencer.AppendRequest)
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  // Prevent compiler warnings about cached_has_bits being unused
-  (void) cached_has_bits;
-
-  record_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  ::memset(&client_id_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&req_id_) -
-      reinterpret_cast<char*>(&client_id_)) + sizeof(req_id_));
-  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
-}
-
-const char* AppendRequest::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
-#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
-  ::PROTOBUF_NAMESPACE_ID::Arena* arena = GetArena(); (void)arena;
-  while (!ctx->Done(&ptr)) {
-    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
-    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
-    CHK_(ptr);
-    switch (tag >> 3) {
-      // int32 client_id = 1;
-      case 1:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 8)) {
-          client_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
-          CHK_(ptr);
-        } else goto handle_unusual;
-        continue;
-      // int32 req_id = 2;
-      case 2:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 16)) {
-          req_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
-          CHK_(ptr);
-        } else goto handle_unusual;
-        continue;
-      // string record = 3;
-      case 3:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 26)) {
-          auto str = _internal_mutable_record();
-          ptr = ::PROTOBUF_NAMESPACE_ID::internal::InlineGreedyStringParser(str, ptr, ctx);
-          CHK_(::PROTOBUF_NAMESPACE_ID::internal::VerifyUTF8(str, "sequencer.AppendRequest.record"));
-          CHK_(ptr);
-        } else goto handle_unusual;
-        continue;
-      default: {
-      handle_unusual:
-        if ((tag & 7) == 4 || tag == 0) {
-          ctx->SetLastTag(tag);
-          goto success;
-        }
-        ptr = UnknownFieldParse(tag,
-            _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
-            ptr, ctx);
-        CHK_(ptr != nullptr);
-        continue;
-      }
-    }  // switch
-  }  // while
-success:
-  return ptr;
-failure:
-  ptr = nullptr;
-  goto success;
-#undef CHK_
-}
-
-::PROTOBUF_NAMESPACE_ID::uint8* AppendRequest::_InternalSerialize(
-    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
-  // @@protoc_insertion_point(serialize_to_array_start:sequencer.AppendRequest)
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  (void) cached_has_bits;
-
-  // int32 client_id = 1;
-  if (this->client_id() != 0) {
-    target = stream->EnsureSpace(target);
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt32ToArray(1, this->_internal_client_id(), target);
-  }
-
-  // int32 req_id = 2;
-  if (this->req_id() != 0) {
-    target = stream->EnsureSpace(target);
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt32ToArray(2, this->_internal_req_id(), target);
-  }
-
-  // string record = 3;
-  if (this->record().size() > 0) {
-    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
-      this->_internal_record().data(), static_cast<int>(this->_internal_record().length()),
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
-      "sequencer.AppendRequest.record");
-    target = stream->WriteStringMaybeAliased(
-        3, this->_internal_record(), target);
-  }
-
-  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
-        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
-  }
-  // @@protoc_insertion_point(serialize_to_array_end:sequencer.AppendRequest)
-  return target;
-}
-
-size_t AppendRequest::ByteSizeLong() const {
-// @@protoc_insertion_point(message_byte_size_start:sequencer.AppendRequest)
-  size_t total_size = 0;
-
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  // Prevent compiler warnings about cached_has_bits being unused
-  (void) cached_has_bits;
-
-  // string record = 3;
-  if (this->record().size() > 0) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
-        this->_internal_record());
-  }
-
-  // int32 client_id = 1;
-  if (this->client_id() != 0) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int32Size(
-        this->_internal_client_id());
-  }
-
-  // int32 req_id = 2;
-  if (this->req_id() != 0) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int32Size(
-        this->_internal_req_id());
-  }
-
-  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
-    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
-        _internal_metadata_, total_size, &_cached_size_);
-  }
-  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
-  SetCachedSize(cached_size);
-  return total_size;
-}
-
-void AppendRequest::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
-// @@protoc_insertion_point(generalized_merge_from_start:sequencer.AppendRequest)
-  GOOGLE_DCHECK_NE(&from, this);
-  const AppendRequest* source =
-      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<AppendRequest>(
-          &from);
-  if (source == nullptr) {
-  // @@protoc_insertion_point(generalized_merge_from_cast_fail:sequencer.AppendRequest)
-    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
-  } else {
-  // @@protoc_insertion_point(generalized_merge_from_cast_success:sequencer.AppendRequest)
-    MergeFrom(*source);
-  }
-}
-
-void AppendRequest::MergeFrom(const AppendRequest& from) {
-// @@protoc_insertion_point(class_specific_merge_from_start:sequencer.AppendRequest)
-  GOOGLE_DCHECK_NE(&from, this);
-  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  (void) cached_has_bits;
-
-  if (from.record().size() > 0) {
-    _internal_set_record(from._internal_record());
-  }
-  if (from.client_id() != 0) {
-    _internal_set_client_id(from._internal_client_id());
-  }
-  if (from.req_id() != 0) {
-    _internal_set_req_id(from._internal_req_id());
-  }
-}
-
-void AppendRequest::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
-// @@protoc_insertion_point(generalized_copy_from_start:sequencer.AppendRequest)
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
-}
-
-void AppendRequest::CopyFrom(const AppendRequest& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:sequencer.AppendRequest)
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
-}
-
-bool AppendRequest::IsInitialized() const {
-  return true;
-}
-
-void AppendRequest::InternalSwap(AppendRequest* other) {
-  using std::swap;
-  _internal_metadata_.Swap<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(&other->_internal_metadata_);
-  record_.Swap(&other->record_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(AppendRequest, req_id_)
-      + sizeof(AppendRequest::req_id_)
-      - PROTOBUF_FIELD_OFFSET(AppendRequest, client_id_)>(
-          reinterpret_cast<char*>(&client_id_),
-          reinterpret_cast<char*>(&other->client_id_));
-}
-
-::PROTOBUF_NAMESPACE_ID::Metadata AppendRequest::GetMetadata() const {
-  return GetMetadataStatic();
-}
-
-
-// ===================================================================
-
-void AppendReply::InitAsDefaultInstance() {
-}
-class AppendReply::_Internal {
- public:
-};
-
-AppendReply::AppendReply(::PROTOBUF_NAMESPACE_ID::Arena* arena)
-  : ::PROTOBUF_NAMESPACE_ID::Message(arena) {
-  SharedCtor();
-  RegisterArenaDtor(arena);
-  // @@protoc_insertion_point(arena_constructor:sequencer.AppendReply)
-}
-AppendReply::AppendReply(const AppendReply& from)
-  : ::PROTOBUF_NAMESPACE_ID::Message() {
-  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  message_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  if (!from._internal_message().empty()) {
-    message_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from._internal_message(),
-      GetArena());
-  }
-  ::memcpy(&global_pos_, &from.global_pos_,
-    static_cast<size_t>(reinterpret_cast<char*>(&success_) -
-    reinterpret_cast<char*>(&global_pos_)) + sizeof(success_));
-  // @@protoc_insertion_point(copy_constructor:sequencer.AppendReply)
-}
-
-void AppendReply::SharedCtor() {
-  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_AppendReply_sequencer_2eproto.base);
-  message_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  ::memset(&global_pos_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&success_) -
-      reinterpret_cast<char*>(&global_pos_)) + sizeof(success_));
-}
-
-AppendReply::~AppendReply() {
-  // @@protoc_insertion_point(destructor:sequencer.AppendReply)
-  SharedDtor();
-  _internal_metadata_.Delete<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
-}
-
-void AppendReply::SharedDtor() {
-  GOOGLE_DCHECK(GetArena() == nullptr);
-  message_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-}
-
-void AppendReply::ArenaDtor(void* object) {
-  AppendReply* _this = reinterpret_cast< AppendReply* >(object);
-  (void)_this;
-}
-void AppendReply::RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena*) {
-}
-void AppendReply::SetCachedSize(int size) const {
-  _cached_size_.Set(size);
-}
-const AppendReply& AppendReply::default_instance() {
-  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&::scc_info_AppendReply_sequencer_2eproto.base);
-  return *internal_default_instance();
-}
-
-
-void AppendReply::Clear() {
-// @@protoc_insertion_point(message_clear_start:sequencer.AppendReply)
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  // Prevent compiler warnings about cached_has_bits being unused
-  (void) cached_has_bits;
-
-  message_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  ::memset(&global_pos_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&success_) -
-      reinterpret_cast<char*>(&global_pos_)) + sizeof(success_));
-  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
-}
-
-const char* AppendReply::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
-#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
-  ::PROTOBUF_NAMESPACE_ID::Arena* arena = GetArena(); (void)arena;
-  while (!ctx->Done(&ptr)) {
-    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
-    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
-    CHK_(ptr);
-    switch (tag >> 3) {
-      // bool success = 1;
-      case 1:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 8)) {
-          success_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
-          CHK_(ptr);
-        } else goto handle_unusual;
-        continue;
-      // int64 global_pos = 2;
-      case 2:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 16)) {
-          global_pos_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
-          CHK_(ptr);
-        } else goto handle_unusual;
-        continue;
-      // string message = 3;
-      case 3:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 26)) {
-          auto str = _internal_mutable_message();
-          ptr = ::PROTOBUF_NAMESPACE_ID::internal::InlineGreedyStringParser(str, ptr, ctx);
-          CHK_(::PROTOBUF_NAMESPACE_ID::internal::VerifyUTF8(str, "sequencer.AppendReply.message"));
-          CHK_(ptr);
-        } else goto handle_unusual;
-        continue;
-      default: {
-      handle_unusual:
-        if ((tag & 7) == 4 || tag == 0) {
-          ctx->SetLastTag(tag);
-          goto success;
-        }
-        ptr = UnknownFieldParse(tag,
-            _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
-            ptr, ctx);
-        CHK_(ptr != nullptr);
-        continue;
-      }
-    }  // switch
-  }  // while
-success:
-  return ptr;
-failure:
-  ptr = nullptr;
-  goto success;
-#undef CHK_
-}
-
-::PROTOBUF_NAMESPACE_ID::uint8* AppendReply::_InternalSerialize(
-    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
-  // @@protoc_insertion_point(serialize_to_array_start:sequencer.AppendReply)
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  (void) cached_has_bits;
-
-  // bool success = 1;
-  if (this->success() != 0) {
-    target = stream->EnsureSpace(target);
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteBoolToArray(1, this->_internal_success(), target);
-  }
-
-  // int64 global_pos = 2;
-  if (this->global_pos() != 0) {
-    target = stream->EnsureSpace(target);
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64ToArray(2, this->_internal_global_pos(), target);
-  }
-
-  // string message = 3;
-  if (this->message().size() > 0) {
-    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
-      this->_internal_message().data(), static_cast<int>(this->_internal_message().length()),
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
-      "sequencer.AppendReply.message");
-    target = stream->WriteStringMaybeAliased(
-        3, this->_internal_message(), target);
-  }
-
-  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
-        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
-  }
-  // @@protoc_insertion_point(serialize_to_array_end:sequencer.AppendReply)
-  return target;
-}
-
-size_t AppendReply::ByteSizeLong() const {
-// @@protoc_insertion_point(message_byte_size_start:sequencer.AppendReply)
-  size_t total_size = 0;
-
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  // Prevent compiler warnings about cached_has_bits being unused
-  (void) cached_has_bits;
-
-  // string message = 3;
-  if (this->message().size() > 0) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
-        this->_internal_message());
-  }
-
-  // int64 global_pos = 2;
-  if (this->global_pos() != 0) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int64Size(
-        this->_internal_global_pos());
-  }
-
-  // bool success = 1;
-  if (this->success() != 0) {
-    total_size += 1 + 1;
-  }
-
-  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
-    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
-        _internal_metadata_, total_size, &_cached_size_);
-  }
-  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
-  SetCachedSize(cached_size);
-  return total_size;
-}
-
-void AppendReply::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
-// @@protoc_insertion_point(generalized_merge_from_start:sequencer.AppendReply)
-  GOOGLE_DCHECK_NE(&from, this);
-  const AppendReply* source =
-      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<AppendReply>(
-          &from);
-  if (source == nullptr) {
-  // @@protoc_insertion_point(generalized_merge_from_cast_fail:sequencer.AppendReply)
-    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
-  } else {
-  // @@protoc_insertion_point(generalized_merge_from_cast_success:sequencer.AppendReply)
-    MergeFrom(*source);
-  }
-}
-
-void AppendReply::MergeFrom(const AppendReply& from) {
-// @@protoc_insertion_point(class_specific_merge_from_start:sequencer.AppendReply)
-  GOOGLE_DCHECK_NE(&from, this);
-  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  (void) cached_has_bits;
-
-  if (from.message().size() > 0) {
-    _internal_set_message(from._internal_message());
-  }
-  if (from.global_pos() != 0) {
-    _internal_set_global_pos(from._internal_global_pos());
-  }
-  if (from.success() != 0) {
-    _internal_set_success(from._internal_success());
-  }
-}
-
-void AppendReply::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
-// @@protoc_insertion_point(generalized_copy_from_start:sequencer.AppendReply)
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
-}
-
-void AppendReply::CopyFrom(const AppendReply& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:sequencer.AppendReply)
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
-}
-
-bool AppendReply::IsInitialized() const {
-  return true;
-}
-
-void AppendReply::InternalSwap(AppendReply* other) {
-  using std::swap;
-  _internal_metadata_.Swap<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(&other->_internal_metadata_);
-  message_.Swap(&other->message_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(AppendReply, success_)
-      + sizeof(AppendReply::success_)
-      - PROTOBUF_FIELD_OFFSET(AppendReply, global_pos_)>(
-          reinterpret_cast<char*>(&global_pos_),
-          reinterpret_cast<char*>(&other->global_pos_));
-}
-
-::PROTOBUF_NAMESPACE_ID::Metadata AppendReply::GetMetadata() const {
-  return GetMetadataStatic();
-}
-
-
-// @@protoc_insertion_point(namespace_scope)
-}  // namespace sequencer
-PROTOBUF_NAMESPACE_OPEN
-template<> PROTOBUF_NOINLINE ::sequencer::AppendRequest* Arena::CreateMaybeMessage< ::sequencer::AppendRequest >(Arena* arena) {
-  return Arena::CreateMessageInternal< ::sequencer::AppendRequest >(arena);
-}
-template<> PROTOBUF_NOINLINE ::sequencer::AppendReply* Arena::CreateMaybeMessage< ::sequencer::AppendReply >(Arena* arena) {
-  return Arena::CreateMessageInternal< ::sequencer::AppendReply >(arena);
-}
-PROTOBUF_NAMESPACE_CLOSE
-
-// @@protoc_insertion_point(global_scope)
-#include <google/protobuf/port_undef.inc>
@@ -1,691 +0,0 @@
-// Generated by the protocol buffer compiler.  DO NOT EDIT!
-// source: sequencer.proto
-
-#ifndef GOOGLE_PROTOBUF_INCLUDED_sequencer_2eproto
-#define GOOGLE_PROTOBUF_INCLUDED_sequencer_2eproto
-
-#include <limits>
-#include <string>
-
-#include <google/protobuf/port_def.inc>
-#if PROTOBUF_VERSION < 3012000
-#error This file was generated by a newer version of protoc which is
-#error incompatible with your Protocol Buffer headers. Please update
-#error your headers.
-#endif
-#if 3012004 < PROTOBUF_MIN_PROTOC_VERSION
-#error This file was generated by an older version of protoc which is
-#error incompatible with your Protocol Buffer headers. Please
-#error regenerate this file with a newer version of protoc.
-#endif
-
-#include <google/protobuf/port_undef.inc>
-#include <google/protobuf/io/coded_stream.h>
-#include <google/protobuf/arena.h>
-#include <google/protobuf/arenastring.h>
-#include <google/protobuf/generated_message_table_driven.h>
-#include <google/protobuf/generated_message_util.h>
-#include <google/protobuf/inlined_string_field.h>
-#include <google/protobuf/metadata_lite.h>
-#include <google/protobuf/generated_message_reflection.h>
-#include <google/protobuf/message.h>
-#include <google/protobuf/repeated_field.h>  // IWYU pragma: export
-#include <google/protobuf/extension_set.h>  // IWYU pragma: export
-#include <google/protobuf/unknown_field_set.h>
-// @@protoc_insertion_point(includes)
-#include <google/protobuf/port_def.inc>
-#define PROTOBUF_INTERNAL_EXPORT_sequencer_2eproto
-PROTOBUF_NAMESPACE_OPEN
-namespace internal {
-class AnyMetadata;
-}  // namespace internal
-PROTOBUF_NAMESPACE_CLOSE
-
-// Internal implementation detail -- do not use these members.
-struct TableStruct_sequencer_2eproto {
-  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTableField entries[]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::AuxillaryParseTableField aux[]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTable schema[2]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::FieldMetadata field_metadata[];
-  static const ::PROTOBUF_NAMESPACE_ID::internal::SerializationTable serialization_table[];
-  static const ::PROTOBUF_NAMESPACE_ID::uint32 offsets[];
-};
-extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_sequencer_2eproto;
-namespace sequencer {
-class AppendReply;
-class AppendReplyDefaultTypeInternal;
-extern AppendReplyDefaultTypeInternal _AppendReply_default_instance_;
-class AppendRequest;
-class AppendRequestDefaultTypeInternal;
-extern AppendRequestDefaultTypeInternal _AppendRequest_default_instance_;
-}  // namespace sequencer
-PROTOBUF_NAMESPACE_OPEN
-template<> ::sequencer::AppendReply* Arena::CreateMaybeMessage<::sequencer::AppendReply>(Arena*);
-template<> ::sequencer::AppendRequest* Arena::CreateMaybeMessage<::sequencer::AppendRequest>(Arena*);
-PROTOBUF_NAMESPACE_CLOSE
-namespace sequencer {
-
-// ===================================================================
-
-class AppendRequest PROTOBUF_FINAL :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:sequencer.AppendRequest) */ {
- public:
-  inline AppendRequest() : AppendRequest(nullptr) {};
-  virtual ~AppendRequest();
-
-  AppendRequest(const AppendRequest& from);
-  AppendRequest(AppendRequest&& from) noexcept
-    : AppendRequest() {
-    *this = ::std::move(from);
-  }
-
-  inline AppendRequest& operator=(const AppendRequest& from) {
-    CopyFrom(from);
-    return *this;
-  }
-  inline AppendRequest& operator=(AppendRequest&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
-    } else {
-      CopyFrom(from);
-    }
-    return *this;
-  }
-
-  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
-    return GetDescriptor();
-  }
-  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
-  }
-  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
-  }
-  static const AppendRequest& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
-  static inline const AppendRequest* internal_default_instance() {
-    return reinterpret_cast<const AppendRequest*>(
-               &_AppendRequest_default_instance_);
-  }
-  static constexpr int kIndexInFileMessages =
-    0;
-
-  friend void swap(AppendRequest& a, AppendRequest& b) {
-    a.Swap(&b);
-  }
-  inline void Swap(AppendRequest* other) {
-    if (other == this) return;
-    if (GetArena() == other->GetArena()) {
-      InternalSwap(other);
-    } else {
-      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
-    }
-  }
-  void UnsafeArenaSwap(AppendRequest* other) {
-    if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
-    InternalSwap(other);
-  }
-
-  // implements Message ----------------------------------------------
-
-  inline AppendRequest* New() const final {
-    return CreateMaybeMessage<AppendRequest>(nullptr);
-  }
-
-  AppendRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
-    return CreateMaybeMessage<AppendRequest>(arena);
-  }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void CopyFrom(const AppendRequest& from);
-  void MergeFrom(const AppendRequest& from);
-  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
-  bool IsInitialized() const final;
-
-  size_t ByteSizeLong() const final;
-  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
-
-  private:
-  inline void SharedCtor();
-  inline void SharedDtor();
-  void SetCachedSize(int size) const final;
-  void InternalSwap(AppendRequest* other);
-  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
-  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "sequencer.AppendRequest";
-  }
-  protected:
-  explicit AppendRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  public:
-
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_sequencer_2eproto);
-    return ::descriptor_table_sequencer_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
-
-  public:
-
-  // nested types ----------------------------------------------------
-
-  // accessors -------------------------------------------------------
-
-  enum : int {
-    kRecordFieldNumber = 3,
-    kClientIdFieldNumber = 1,
-    kReqIdFieldNumber = 2,
-  };
-  // string record = 3;
-  void clear_record();
-  const std::string& record() const;
-  void set_record(const std::string& value);
-  void set_record(std::string&& value);
-  void set_record(const char* value);
-  void set_record(const char* value, size_t size);
-  std::string* mutable_record();
-  std::string* release_record();
-  void set_allocated_record(std::string* record);
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  std::string* unsafe_arena_release_record();
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  void unsafe_arena_set_allocated_record(
-      std::string* record);
-  private:
-  const std::string& _internal_record() const;
-  void _internal_set_record(const std::string& value);
-  std::string* _internal_mutable_record();
-  public:
-
-  // int32 client_id = 1;
-  void clear_client_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 client_id() const;
-  void set_client_id(::PROTOBUF_NAMESPACE_ID::int32 value);
-  private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_client_id() const;
-  void _internal_set_client_id(::PROTOBUF_NAMESPACE_ID::int32 value);
-  public:
-
-  // int32 req_id = 2;
-  void clear_req_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 req_id() const;
-  void set_req_id(::PROTOBUF_NAMESPACE_ID::int32 value);
-  private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_req_id() const;
-  void _internal_set_req_id(::PROTOBUF_NAMESPACE_ID::int32 value);
-  public:
-
-  // @@protoc_insertion_point(class_scope:sequencer.AppendRequest)
- private:
-  class _Internal;
-
-  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
-  typedef void InternalArenaConstructable_;
-  typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr record_;
-  ::PROTOBUF_NAMESPACE_ID::int32 client_id_;
-  ::PROTOBUF_NAMESPACE_ID::int32 req_id_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  friend struct ::TableStruct_sequencer_2eproto;
-};
-// -------------------------------------------------------------------
-
-class AppendReply PROTOBUF_FINAL :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:sequencer.AppendReply) */ {
- public:
-  inline AppendReply() : AppendReply(nullptr) {};
-  virtual ~AppendReply();
-
-  AppendReply(const AppendReply& from);
-  AppendReply(AppendReply&& from) noexcept
-    : AppendReply() {
-    *this = ::std::move(from);
-  }
-
-  inline AppendReply& operator=(const AppendReply& from) {
-    CopyFrom(from);
-    return *this;
-  }
-  inline AppendReply& operator=(AppendReply&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
-    } else {
-      CopyFrom(from);
-    }
-    return *this;
-  }
-
-  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
-    return GetDescriptor();
-  }
-  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
-  }
-  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
-  }
-  static const AppendReply& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
-  static inline const AppendReply* internal_default_instance() {
-    return reinterpret_cast<const AppendReply*>(
-               &_AppendReply_default_instance_);
-  }
-  static constexpr int kIndexInFileMessages =
-    1;
-
-  friend void swap(AppendReply& a, AppendReply& b) {
-    a.Swap(&b);
-  }
-  inline void Swap(AppendReply* other) {
-    if (other == this) return;
-    if (GetArena() == other->GetArena()) {
-      InternalSwap(other);
-    } else {
-      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
-    }
-  }
-  void UnsafeArenaSwap(AppendReply* other) {
-    if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
-    InternalSwap(other);
-  }
-
-  // implements Message ----------------------------------------------
-
-  inline AppendReply* New() const final {
-    return CreateMaybeMessage<AppendReply>(nullptr);
-  }
-
-  AppendReply* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
-    return CreateMaybeMessage<AppendReply>(arena);
-  }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void CopyFrom(const AppendReply& from);
-  void MergeFrom(const AppendReply& from);
-  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
-  bool IsInitialized() const final;
-
-  size_t ByteSizeLong() const final;
-  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
-
-  private:
-  inline void SharedCtor();
-  inline void SharedDtor();
-  void SetCachedSize(int size) const final;
-  void InternalSwap(AppendReply* other);
-  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
-  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "sequencer.AppendReply";
-  }
-  protected:
-  explicit AppendReply(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  public:
-
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_sequencer_2eproto);
-    return ::descriptor_table_sequencer_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
-
-  public:
-
-  // nested types ----------------------------------------------------
-
-  // accessors -------------------------------------------------------
-
-  enum : int {
-    kMessageFieldNumber = 3,
-    kGlobalPosFieldNumber = 2,
-    kSuccessFieldNumber = 1,
-  };
-  // string message = 3;
-  void clear_message();
-  const std::string& message() const;
-  void set_message(const std::string& value);
-  void set_message(std::string&& value);
-  void set_message(const char* value);
-  void set_message(const char* value, size_t size);
-  std::string* mutable_message();
-  std::string* release_message();
-  void set_allocated_message(std::string* message);
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  std::string* unsafe_arena_release_message();
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  void unsafe_arena_set_allocated_message(
-      std::string* message);
-  private:
-  const std::string& _internal_message() const;
-  void _internal_set_message(const std::string& value);
-  std::string* _internal_mutable_message();
-  public:
-
-  // int64 global_pos = 2;
-  void clear_global_pos();
-  ::PROTOBUF_NAMESPACE_ID::int64 global_pos() const;
-  void set_global_pos(::PROTOBUF_NAMESPACE_ID::int64 value);
-  private:
-  ::PROTOBUF_NAMESPACE_ID::int64 _internal_global_pos() const;
-  void _internal_set_global_pos(::PROTOBUF_NAMESPACE_ID::int64 value);
-  public:
-
-  // bool success = 1;
-  void clear_success();
-  bool success() const;
-  void set_success(bool value);
-  private:
-  bool _internal_success() const;
-  void _internal_set_success(bool value);
-  public:
-
-  // @@protoc_insertion_point(class_scope:sequencer.AppendReply)
- private:
-  class _Internal;
-
-  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
-  typedef void InternalArenaConstructable_;
-  typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
-  ::PROTOBUF_NAMESPACE_ID::int64 global_pos_;
-  bool success_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  friend struct ::TableStruct_sequencer_2eproto;
-};
-// ===================================================================
-
-
-// ===================================================================
-
-#ifdef __GNUC__
-  #pragma GCC diagnostic push
-  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
-#endif  // __GNUC__
-// AppendRequest
-
-// int32 client_id = 1;
-inline void AppendRequest::clear_client_id() {
-  client_id_ = 0;
-}
-inline ::PROTOBUF_NAMESPACE_ID::int32 AppendRequest::_internal_client_id() const {
-  return client_id_;
-}
-inline ::PROTOBUF_NAMESPACE_ID::int32 AppendRequest::client_id() const {
-  // @@protoc_insertion_point(field_get:sequencer.AppendRequest.client_id)
-  return _internal_client_id();
-}
-inline void AppendRequest::_internal_set_client_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  
-  client_id_ = value;
-}
-inline void AppendRequest::set_client_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _internal_set_client_id(value);
-  // @@protoc_insertion_point(field_set:sequencer.AppendRequest.client_id)
-}
-
-// int32 req_id = 2;
-inline void AppendRequest::clear_req_id() {
-  req_id_ = 0;
-}
-inline ::PROTOBUF_NAMESPACE_ID::int32 AppendRequest::_internal_req_id() const {
-  return req_id_;
-}
-inline ::PROTOBUF_NAMESPACE_ID::int32 AppendRequest::req_id() const {
-  // @@protoc_insertion_point(field_get:sequencer.AppendRequest.req_id)
-  return _internal_req_id();
-}
-inline void AppendRequest::_internal_set_req_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  
-  req_id_ = value;
-}
-inline void AppendRequest::set_req_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _internal_set_req_id(value);
-  // @@protoc_insertion_point(field_set:sequencer.AppendRequest.req_id)
-}
-
-// string record = 3;
-inline void AppendRequest::clear_record() {
-  record_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-}
-inline const std::string& AppendRequest::record() const {
-  // @@protoc_insertion_point(field_get:sequencer.AppendRequest.record)
-  return _internal_record();
-}
-inline void AppendRequest::set_record(const std::string& value) {
-  _internal_set_record(value);
-  // @@protoc_insertion_point(field_set:sequencer.AppendRequest.record)
-}
-inline std::string* AppendRequest::mutable_record() {
-  // @@protoc_insertion_point(field_mutable:sequencer.AppendRequest.record)
-  return _internal_mutable_record();
-}
-inline const std::string& AppendRequest::_internal_record() const {
-  return record_.Get();
-}
-inline void AppendRequest::_internal_set_record(const std::string& value) {
-  
-  record_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value, GetArena());
-}
-inline void AppendRequest::set_record(std::string&& value) {
-  
-  record_.Set(
-    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:sequencer.AppendRequest.record)
-}
-inline void AppendRequest::set_record(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  
-  record_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value),
-              GetArena());
-  // @@protoc_insertion_point(field_set_char:sequencer.AppendRequest.record)
-}
-inline void AppendRequest::set_record(const char* value,
-    size_t size) {
-  
-  record_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:sequencer.AppendRequest.record)
-}
-inline std::string* AppendRequest::_internal_mutable_record() {
-  
-  return record_.Mutable(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-}
-inline std::string* AppendRequest::release_record() {
-  // @@protoc_insertion_point(field_release:sequencer.AppendRequest.record)
-  return record_.Release(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-}
-inline void AppendRequest::set_allocated_record(std::string* record) {
-  if (record != nullptr) {
-    
-  } else {
-    
-  }
-  record_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), record,
-      GetArena());
-  // @@protoc_insertion_point(field_set_allocated:sequencer.AppendRequest.record)
-}
-inline std::string* AppendRequest::unsafe_arena_release_record() {
-  // @@protoc_insertion_point(field_unsafe_arena_release:sequencer.AppendRequest.record)
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  
-  return record_.UnsafeArenaRelease(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      GetArena());
-}
-inline void AppendRequest::unsafe_arena_set_allocated_record(
-    std::string* record) {
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  if (record != nullptr) {
-    
-  } else {
-    
-  }
-  record_.UnsafeArenaSetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      record, GetArena());
-  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:sequencer.AppendRequest.record)
-}
-
-// -------------------------------------------------------------------
-
-// AppendReply
-
-// bool success = 1;
-inline void AppendReply::clear_success() {
-  success_ = false;
-}
-inline bool AppendReply::_internal_success() const {
-  return success_;
-}
-inline bool AppendReply::success() const {
-  // @@protoc_insertion_point(field_get:sequencer.AppendReply.success)
-  return _internal_success();
-}
-inline void AppendReply::_internal_set_success(bool value) {
-  
-  success_ = value;
-}
-inline void AppendReply::set_success(bool value) {
-  _internal_set_success(value);
-  // @@protoc_insertion_point(field_set:sequencer.AppendReply.success)
-}
-
-// int64 global_pos = 2;
-inline void AppendReply::clear_global_pos() {
-  global_pos_ = PROTOBUF_LONGLONG(0);
-}
-inline ::PROTOBUF_NAMESPACE_ID::int64 AppendReply::_internal_global_pos() const {
-  return global_pos_;
-}
-inline ::PROTOBUF_NAMESPACE_ID::int64 AppendReply::global_pos() const {
-  // @@protoc_insertion_point(field_get:sequencer.AppendReply.global_pos)
-  return _internal_global_pos();
-}
-inline void AppendReply::_internal_set_global_pos(::PROTOBUF_NAMESPACE_ID::int64 value) {
-  
-  global_pos_ = value;
-}
-inline void AppendReply::set_global_pos(::PROTOBUF_NAMESPACE_ID::int64 value) {
-  _internal_set_global_pos(value);
-  // @@protoc_insertion_point(field_set:sequencer.AppendReply.global_pos)
-}
-
-// string message = 3;
-inline void AppendReply::clear_message() {
-  message_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-}
-inline const std::string& AppendReply::message() const {
-  // @@protoc_insertion_point(field_get:sequencer.AppendReply.message)
-  return _internal_message();
-}
-inline void AppendReply::set_message(const std::string& value) {
-  _internal_set_message(value);
-  // @@protoc_insertion_point(field_set:sequencer.AppendReply.message)
-}
-inline std::string* AppendReply::mutable_message() {
-  // @@protoc_insertion_point(field_mutable:sequencer.AppendReply.message)
-  return _internal_mutable_message();
-}
-inline const std::string& AppendReply::_internal_message() const {
-  return message_.Get();
-}
-inline void AppendReply::_internal_set_message(const std::string& value) {
-  
-  message_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value, GetArena());
-}
-inline void AppendReply::set_message(std::string&& value) {
-  
-  message_.Set(
-    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:sequencer.AppendReply.message)
-}
-inline void AppendReply::set_message(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  
-  message_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value),
-              GetArena());
-  // @@protoc_insertion_point(field_set_char:sequencer.AppendReply.message)
-}
-inline void AppendReply::set_message(const char* value,
-    size_t size) {
-  
-  message_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:sequencer.AppendReply.message)
-}
-inline std::string* AppendReply::_internal_mutable_message() {
-  
-  return message_.Mutable(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-}
-inline std::string* AppendReply::release_message() {
-  // @@protoc_insertion_point(field_release:sequencer.AppendReply.message)
-  return message_.Release(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-}
-inline void AppendReply::set_allocated_message(std::string* message) {
-  if (message != nullptr) {
-    
-  } else {
-    
-  }
-  message_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), message,
-      GetArena());
-  // @@protoc_insertion_point(field_set_allocated:sequencer.AppendReply.message)
-}
-inline std::string* AppendReply::unsafe_arena_release_message() {
-  // @@protoc_insertion_point(field_unsafe_arena_release:sequencer.AppendReply.message)
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  
-  return message_.UnsafeArenaRelease(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      GetArena());
-}
-inline void AppendReply::unsafe_arena_set_allocated_message(
-    std::string* message) {
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  if (message != nullptr) {
-    
-  } else {
-    
-  }
-  message_.UnsafeArenaSetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      message, GetArena());
-  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:sequencer.AppendReply.message)
-}
-
-#ifdef __GNUC__
-  #pragma GCC diagnostic pop
-#endif  // __GNUC__
-// -------------------------------------------------------------------
-
-
-// @@protoc_insertion_point(namespace_scope)
-
-}  // namespace sequencer
-
-// @@protoc_insertion_point(global_scope)
-
-#include <google/protobuf/port_undef.inc>
-#endif  // GOOGLE_PROTOBUF_INCLUDED_GOOGLE_PROTOBUF_INCLUDED_sequencer_2eproto
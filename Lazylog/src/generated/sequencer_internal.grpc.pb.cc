@@ -1,91 +0,0 @@
-// Generated by the gRPC C++ plugin.
-// If you make any local change, they will be lost.
-// source: sequencer_internal.proto
-
-#include "sequencer_internal.pb.h"
-#include "sequencer_internal.grpc.pb.h"
-
-#include <functional>
-#include <grpcpp/impl/codegen/async_stream.h>
-#include <grpcpp/impl/codegen/async_unary_call.h>
-#include <grpcpp/impl/codegen/channel_interface.h>
-#include <grpcpp/impl/codegen/client_unary_call.h>
-#include <grpcpp/impl/codegen/client_callback.h>
-#include <grpcpp/impl/codegen/message_allocator.h>
-#include <grpcpp/impl/codegen/method_handler.h>
-#include <grpcpp/impl/codegen/rpc_service_method.h>
-#include <grpcpp/impl/codegen/server_callback.h>
-#include <grpcpp/impl/codegen/server_callback_handlers.h>
-#include <grpcpp/impl/codegen/server_context.h>
-#include <grpcpp/impl/codegen/service_type.h>
-#include <grpcpp/impl/codegen/sync_stream.h>
-namespace sequencer_internal {
-
-static const char* SequencerInternal_method_names[] = {
-  "/sequencer_internal.SequencerInternal/ReplicateAppend",
-};
-
-std::unique_ptr< SequencerInternal::Stub> SequencerInternal::NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options) {
-  (void)options;
-  std::unique_ptr< SequencerInternal::Stub> stub(new SequencerInternal::Stub(channel));
-  return stub;
-}
-
-SequencerInternal::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channel)
-  : channel_(channel), rpcmethod_ReplicateAppend_(SequencerInternal_method_names[0], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
-  {}
-
-::grpc::Status SequencerInternal::Stub::ReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest& request, ::sequencer_internal::ReplicateAppendReply* response) {
-  return ::grpc::internal::BlockingUnaryCall(channel_.get(), rpcmethod_ReplicateAppend_, context, request, response);
-}
-
-void SequencerInternal::Stub::experimental_async::ReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest* request, ::sequencer_internal::ReplicateAppendReply* response, std::function<void(::grpc::Status)> f) {
-  ::grpc_impl::internal::CallbackUnaryCall(stub_->channel_.get(), stub_->rpcmethod_ReplicateAppend_, context, request, response, std::move(f));
-}
-
-void SequencerInternal::Stub::experimental_async::ReplicateAppend(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer_internal::ReplicateAppendReply* response, std::function<void(::grpc::Status)> f) {
-  ::grpc_impl::internal::CallbackUnaryCall(stub_->channel_.get(), stub_->rpcmethod_ReplicateAppend_, context, request, response, std::move(f));
-}
-
-void SequencerInternal::Stub::experimental_async::ReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest* request, ::sequencer_internal::ReplicateAppendReply* response, ::grpc::experimental::ClientUnaryReactor* reactor) {
-  ::grpc_impl::internal::ClientCallbackUnaryFactory::Create(stub_->channel_.get(), stub_->rpcmethod_ReplicateAppend_, context, request, response, reactor);
-}
-
-void SequencerInternal::Stub::experimental_async::ReplicateAppend(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer_internal::ReplicateAppendReply* response, ::grpc::experimental::ClientUnaryReactor* reactor) {
-  ::grpc_impl::internal::ClientCallbackUnaryFactory::Create(stub_->channel_.get(), stub_->rpcmethod_ReplicateAppend_, context, request, response, reactor);
-}
-
-::grpc::ClientAsyncResponseReader< ::sequencer_internal::ReplicateAppendReply>* SequencerInternal::Stub::AsyncReplicateAppendRaw(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest& request, ::grpc::CompletionQueue* cq) {
-  return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::sequencer_internal::ReplicateAppendReply>::Create(channel_.get(), cq, rpcmethod_ReplicateAppend_, context, request, true);
-}
-
-::grpc::ClientAsyncResponseReader< ::sequencer_internal::ReplicateAppendReply>* SequencerInternal::Stub::PrepareAsyncReplicateAppendRaw(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest& request, ::grpc::CompletionQueue* cq) {
-  return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::sequencer_internal::ReplicateAppendReply>::Create(channel_.get(), cq, rpcmethod_ReplicateAppend_, context, request, false);
-}
-
-SequencerInternal::Service::Service() {
-  AddMethod(new ::grpc::internal::RpcServiceMethod(
-      SequencerInternal_method_names[0],
-      ::grpc::internal::RpcMethod::NORMAL_RPC,
-      new ::grpc::internal::RpcMethodHandler< SequencerInternal::Service, ::sequencer_internal::ReplicateAppendRequest, ::sequencer_internal::ReplicateAppendReply>(
-          [](SequencerInternal::Service* service,
-             ::grpc_impl::ServerContext* ctx,
-             const ::sequencer_internal::ReplicateAppendRequest* req,
-             ::sequencer_internal::ReplicateAppendReply* resp) {
-               return service->ReplicateAppend(ctx, req, resp);
-             }, this)));
-}
-
-SequencerInternal::Service::~Service() {
-}
-
-::grpc::Status SequencerInternal::Service::ReplicateAppend(::grpc::ServerContext* context, const ::sequencer_internal::ReplicateAppendRequest* request, ::sequencer_internal::ReplicateAppendReply* response) {
-  (void) context;
-  (void) request;
-  (void) response;
-  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-}
-
-
-}  // namespace sequencer_internal
-
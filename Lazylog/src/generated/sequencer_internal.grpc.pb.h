@@ -1,305 +0,0 @@
-// Generated by the gRPC C++ plugin.
-// If you make any local change, they will be lost.
-// source: sequencer_internal.proto
-#ifndef GRPC_sequencer_5finternal_2eproto__INCLUDED
-#define GRPC_sequencer_5finternal_2eproto__INCLUDED
-
-#include "sequencer_internal.pb.h"
-
-#include <functional>
-#include <grpc/impl/codegen/port_platform.h>
-#include <grpcpp/impl/codegen/async_generic_service.h>
-#include <grpcpp/impl/codegen/async_stream.h>
-#include <grpcpp/impl/codegen/async_unary_call.h>
-#include <grpcpp/impl/codegen/client_callback.h>
-#include <grpcpp/impl/codegen/client_context.h>
-#include <grpcpp/impl/codegen/completion_queue.h>
-#include <grpcpp/impl/codegen/message_allocator.h>
-#include <grpcpp/impl/codegen/method_handler.h>
-#include <grpcpp/impl/codegen/proto_utils.h>
-#include <grpcpp/impl/codegen/rpc_method.h>
-#include <grpcpp/impl/codegen/server_callback.h>
-#include <grpcpp/impl/codegen/server_callback_handlers.h>
-#include <grpcpp/impl/codegen/server_context.h>
-#include <grpcpp/impl/codegen/service_type.h>
-#include <grpcpp/impl/codegen/status.h>
-#include <grpcpp/impl/codegen/stub_options.h>
-#include <grpcpp/impl/codegen/sync_stream.h>
-
-namespace sequencer_internal {
-
-// Leader -> Follower RPC: replicate an entry
-class SequencerInternal final {
- public:
-  static constexpr char const* service_full_name() {
-    return "sequencer_internal.SequencerInternal";
-  }
-  class StubInterface {
-   public:
-    virtual ~StubInterface() {}
-    virtual ::grpc::Status ReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest& request, ::sequencer_internal::ReplicateAppendReply* response) = 0;
-    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::sequencer_internal::ReplicateAppendReply>> AsyncReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::sequencer_internal::ReplicateAppendReply>>(AsyncReplicateAppendRaw(context, request, cq));
-    }
-    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::sequencer_internal::ReplicateAppendReply>> PrepareAsyncReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::sequencer_internal::ReplicateAppendReply>>(PrepareAsyncReplicateAppendRaw(context, request, cq));
-    }
-    class experimental_async_interface {
-     public:
-      virtual ~experimental_async_interface() {}
-      virtual void ReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest* request, ::sequencer_internal::ReplicateAppendReply* response, std::function<void(::grpc::Status)>) = 0;
-      virtual void ReplicateAppend(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer_internal::ReplicateAppendReply* response, std::function<void(::grpc::Status)>) = 0;
-      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      virtual void ReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest* request, ::sequencer_internal::ReplicateAppendReply* response, ::grpc::ClientUnaryReactor* reactor) = 0;
-      #else
-      virtual void ReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest* request, ::sequencer_internal::ReplicateAppendReply* response, ::grpc::experimental::ClientUnaryReactor* reactor) = 0;
-      #endif
-      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      virtual void ReplicateAppend(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer_internal::ReplicateAppendReply* response, ::grpc::ClientUnaryReactor* reactor) = 0;
-      #else
-      virtual void ReplicateAppend(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer_internal::ReplicateAppendReply* response, ::grpc::experimental::ClientUnaryReactor* reactor) = 0;
-      #endif
-    };
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-    typedef class experimental_async_interface async_interface;
-    #endif
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-    async_interface* async() { return experimental_async(); }
-    #endif
-    virtual class experimental_async_interface* experimental_async() { return nullptr; }
-  private:
-    virtual ::grpc::ClientAsyncResponseReaderInterface< ::sequencer_internal::ReplicateAppendReply>* AsyncReplicateAppendRaw(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest& request, ::grpc::CompletionQueue* cq) = 0;
-    virtual ::grpc::ClientAsyncResponseReaderInterface< ::sequencer_internal::ReplicateAppendReply>* PrepareAsyncReplicateAppendRaw(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest& request, ::grpc::CompletionQueue* cq) = 0;
-  };
-  class Stub final : public StubInterface {
-   public:
-    Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channel);
-    ::grpc::Status ReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest& request, ::sequencer_internal::ReplicateAppendReply* response) override;
-    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::sequencer_internal::ReplicateAppendReply>> AsyncReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::sequencer_internal::ReplicateAppendReply>>(AsyncReplicateAppendRaw(context, request, cq));
-    }
-    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::sequencer_internal::ReplicateAppendReply>> PrepareAsyncReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest& request, ::grpc::CompletionQueue* cq) {
-      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::sequencer_internal::ReplicateAppendReply>>(PrepareAsyncReplicateAppendRaw(context, request, cq));
-    }
-    class experimental_async final :
-      public StubInterface::experimental_async_interface {
-     public:
-      void ReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest* request, ::sequencer_internal::ReplicateAppendReply* response, std::function<void(::grpc::Status)>) override;
-      void ReplicateAppend(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer_internal::ReplicateAppendReply* response, std::function<void(::grpc::Status)>) override;
-      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      void ReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest* request, ::sequencer_internal::ReplicateAppendReply* response, ::grpc::ClientUnaryReactor* reactor) override;
-      #else
-      void ReplicateAppend(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest* request, ::sequencer_internal::ReplicateAppendReply* response, ::grpc::experimental::ClientUnaryReactor* reactor) override;
-      #endif
-      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      void ReplicateAppend(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer_internal::ReplicateAppendReply* response, ::grpc::ClientUnaryReactor* reactor) override;
-      #else
-      void ReplicateAppend(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::sequencer_internal::ReplicateAppendReply* response, ::grpc::experimental::ClientUnaryReactor* reactor) override;
-      #endif
-     private:
-      friend class Stub;
-      explicit experimental_async(Stub* stub): stub_(stub) { }
-      Stub* stub() { return stub_; }
-      Stub* stub_;
-    };
-    class experimental_async_interface* experimental_async() override { return &async_stub_; }
-
-   private:
-    std::shared_ptr< ::grpc::ChannelInterface> channel_;
-    class experimental_async async_stub_{this};
-    ::grpc::ClientAsyncResponseReader< ::sequencer_internal::ReplicateAppendReply>* AsyncReplicateAppendRaw(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest& request, ::grpc::CompletionQueue* cq) override;
-    ::grpc::ClientAsyncResponseReader< ::sequencer_internal::ReplicateAppendReply>* PrepareAsyncReplicateAppendRaw(::grpc::ClientContext* context, const ::sequencer_internal::ReplicateAppendRequest& request, ::grpc::CompletionQueue* cq) override;
-    const ::grpc::internal::RpcMethod rpcmethod_ReplicateAppend_;
-  };
-  static std::unique_ptr<Stub> NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options = ::grpc::StubOptions());
-
-  class Service : public ::grpc::Service {
-   public:
-    Service();
-    virtual ~Service();
-    virtual ::grpc::Status ReplicateAppend(::grpc::ServerContext* context, const ::sequencer_internal::ReplicateAppendRequest* request, ::sequencer_internal::ReplicateAppendReply* response);
-  };
-  template <class BaseClass>
-  class WithAsyncMethod_ReplicateAppend : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithAsyncMethod_ReplicateAppend() {
-      ::grpc::Service::MarkMethodAsync(0);
-    }
-    ~WithAsyncMethod_ReplicateAppend() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ReplicateAppend(::grpc::ServerContext* /*context*/, const ::sequencer_internal::ReplicateAppendRequest* /*request*/, ::sequencer_internal::ReplicateAppendReply* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    void RequestReplicateAppend(::grpc::ServerContext* context, ::sequencer_internal::ReplicateAppendRequest* request, ::grpc::ServerAsyncResponseWriter< ::sequencer_internal::ReplicateAppendReply>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
-      ::grpc::Service::RequestAsyncUnary(0, context, request, response, new_call_cq, notification_cq, tag);
-    }
-  };
-  typedef WithAsyncMethod_ReplicateAppend<Service > AsyncService;
-  template <class BaseClass>
-  class ExperimentalWithCallbackMethod_ReplicateAppend : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    ExperimentalWithCallbackMethod_ReplicateAppend() {
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      ::grpc::Service::
-    #else
-      ::grpc::Service::experimental().
-    #endif
-        MarkMethodCallback(0,
-          new ::grpc_impl::internal::CallbackUnaryHandler< ::sequencer_internal::ReplicateAppendRequest, ::sequencer_internal::ReplicateAppendReply>(
-            [this](
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-                   ::grpc::CallbackServerContext*
-    #else
-                   ::grpc::experimental::CallbackServerContext*
-    #endif
-                     context, const ::sequencer_internal::ReplicateAppendRequest* request, ::sequencer_internal::ReplicateAppendReply* response) { return this->ReplicateAppend(context, request, response); }));}
-    void SetMessageAllocatorFor_ReplicateAppend(
-        ::grpc::experimental::MessageAllocator< ::sequencer_internal::ReplicateAppendRequest, ::sequencer_internal::ReplicateAppendReply>* allocator) {
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      ::grpc::internal::MethodHandler* const handler = ::grpc::Service::GetHandler(0);
-    #else
-      ::grpc::internal::MethodHandler* const handler = ::grpc::Service::experimental().GetHandler(0);
-    #endif
-      static_cast<::grpc_impl::internal::CallbackUnaryHandler< ::sequencer_internal::ReplicateAppendRequest, ::sequencer_internal::ReplicateAppendReply>*>(handler)
-              ->SetMessageAllocator(allocator);
-    }
-    ~ExperimentalWithCallbackMethod_ReplicateAppend() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ReplicateAppend(::grpc::ServerContext* /*context*/, const ::sequencer_internal::ReplicateAppendRequest* /*request*/, ::sequencer_internal::ReplicateAppendReply* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-    virtual ::grpc::ServerUnaryReactor* ReplicateAppend(
-      ::grpc::CallbackServerContext* /*context*/, const ::sequencer_internal::ReplicateAppendRequest* /*request*/, ::sequencer_internal::ReplicateAppendReply* /*response*/)
-    #else
-    virtual ::grpc::experimental::ServerUnaryReactor* ReplicateAppend(
-      ::grpc::experimental::CallbackServerContext* /*context*/, const ::sequencer_internal::ReplicateAppendRequest* /*request*/, ::sequencer_internal::ReplicateAppendReply* /*response*/)
-    #endif
-      { return nullptr; }
-  };
-  #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-  typedef ExperimentalWithCallbackMethod_ReplicateAppend<Service > CallbackService;
-  #endif
-
-  typedef ExperimentalWithCallbackMethod_ReplicateAppend<Service > ExperimentalCallbackService;
-  template <class BaseClass>
-  class WithGenericMethod_ReplicateAppend : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithGenericMethod_ReplicateAppend() {
-      ::grpc::Service::MarkMethodGeneric(0);
-    }
-    ~WithGenericMethod_ReplicateAppend() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ReplicateAppend(::grpc::ServerContext* /*context*/, const ::sequencer_internal::ReplicateAppendRequest* /*request*/, ::sequencer_internal::ReplicateAppendReply* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-  };
-  template <class BaseClass>
-  class WithRawMethod_ReplicateAppend : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithRawMethod_ReplicateAppend() {
-      ::grpc::Service::MarkMethodRaw(0);
-    }
-    ~WithRawMethod_ReplicateAppend() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ReplicateAppend(::grpc::ServerContext* /*context*/, const ::sequencer_internal::ReplicateAppendRequest* /*request*/, ::sequencer_internal::ReplicateAppendReply* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    void RequestReplicateAppend(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncResponseWriter< ::grpc::ByteBuffer>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
-      ::grpc::Service::RequestAsyncUnary(0, context, request, response, new_call_cq, notification_cq, tag);
-    }
-  };
-  template <class BaseClass>
-  class ExperimentalWithRawCallbackMethod_ReplicateAppend : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    ExperimentalWithRawCallbackMethod_ReplicateAppend() {
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-      ::grpc::Service::
-    #else
-      ::grpc::Service::experimental().
-    #endif
-        MarkMethodRawCallback(0,
-          new ::grpc_impl::internal::CallbackUnaryHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
-            [this](
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-                   ::grpc::CallbackServerContext*
-    #else
-                   ::grpc::experimental::CallbackServerContext*
-    #endif
-                     context, const ::grpc::ByteBuffer* request, ::grpc::ByteBuffer* response) { return this->ReplicateAppend(context, request, response); }));
-    }
-    ~ExperimentalWithRawCallbackMethod_ReplicateAppend() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable synchronous version of this method
-    ::grpc::Status ReplicateAppend(::grpc::ServerContext* /*context*/, const ::sequencer_internal::ReplicateAppendRequest* /*request*/, ::sequencer_internal::ReplicateAppendReply* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-    virtual ::grpc::ServerUnaryReactor* ReplicateAppend(
-      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)
-    #else
-    virtual ::grpc::experimental::ServerUnaryReactor* ReplicateAppend(
-      ::grpc::experimental::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)
-    #endif
-      { return nullptr; }
-  };
-  template <class BaseClass>
-  class WithStreamedUnaryMethod_ReplicateAppend : public BaseClass {
-   private:
-    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
-   public:
-    WithStreamedUnaryMethod_ReplicateAppend() {
-      ::grpc::Service::MarkMethodStreamed(0,
-        new ::grpc::internal::StreamedUnaryHandler<
-          ::sequencer_internal::ReplicateAppendRequest, ::sequencer_internal::ReplicateAppendReply>(
-            [this](::grpc_impl::ServerContext* context,
-                   ::grpc_impl::ServerUnaryStreamer<
-                     ::sequencer_internal::ReplicateAppendRequest, ::sequencer_internal::ReplicateAppendReply>* streamer) {
-                       return this->StreamedReplicateAppend(context,
-                         streamer);
-                  }));
-    }
-    ~WithStreamedUnaryMethod_ReplicateAppend() override {
-      BaseClassMustBeDerivedFromService(this);
-    }
-    // disable regular version of this method
-    ::grpc::Status ReplicateAppend(::grpc::ServerContext* /*context*/, const ::sequencer_internal::ReplicateAppendRequest* /*request*/, ::sequencer_internal::ReplicateAppendReply* /*response*/) override {
-      abort();
-      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-    }
-    // replace default version of method with streamed unary
-    virtual ::grpc::Status StreamedReplicateAppend(::grpc::ServerContext* context, ::grpc::ServerUnaryStreamer< ::sequencer_internal::ReplicateAppendRequest,::sequencer_internal::ReplicateAppendReply>* server_unary_streamer) = 0;
-  };
-  typedef WithStreamedUnaryMethod_ReplicateAppend<Service > StreamedUnaryService;
-  typedef Service SplitStreamedService;
-  typedef WithStreamedUnaryMethod_ReplicateAppend<Service > StreamedService;
-};
-
-}  // namespace sequencer_internal
-
-
-#endif  // GRPC_sequencer_5finternal_2eproto__INCLUDED
@@ -1,655 +0,0 @@
-// Generated by the protocol buffer compiler.  DO NOT EDIT!
-// source: sequencer_internal.proto
-
-#include "sequencer_internal.pb.h"
-
-#include <algorithm>
-
-#include <google/protobuf/io/coded_stream.h>
-#include <google/protobuf/extension_set.h>
-#include <google/protobuf/wire_format_lite.h>
-#include <google/protobuf/descriptor.h>
-#include <google/protobuf/generated_message_reflection.h>
-#include <google/protobuf/reflection_ops.h>
-#include <google/protobuf/wire_format.h>
-// @@protoc_insertion_point(includes)
-#include <google/protobuf/port_def.inc>
-namespace sequencer_internal {
-class ReplicateAppendRequestDefaultTypeInternal {
- public:
-  ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<ReplicateAppendRequest> _instance;
-} _ReplicateAppendRequest_default_instance_;
-class ReplicateAppendReplyDefaultTypeInternal {
- public:
-  ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<ReplicateAppendReply> _instance;
-} _ReplicateAppendReply_default_instance_;
-}  // namespace sequencer_internal
-static void InitDefaultsscc_info_ReplicateAppendReply_sequencer_5finternal_2eproto() {
-  GOOGLE_PROTOBUF_VERIFY_VERSION;
-
-  {
-    void* ptr = &::sequencer_internal::_ReplicateAppendReply_default_instance_;
-    new (ptr) ::sequencer_internal::ReplicateAppendReply();
-    ::PROTOBUF_NAMESPACE_ID::internal::OnShutdownDestroyMessage(ptr);
-  }
-  ::sequencer_internal::ReplicateAppendReply::InitAsDefaultInstance();
-}
-
-::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_ReplicateAppendReply_sequencer_5finternal_2eproto =
-    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 0, 0, InitDefaultsscc_info_ReplicateAppendReply_sequencer_5finternal_2eproto}, {}};
-
-static void InitDefaultsscc_info_ReplicateAppendRequest_sequencer_5finternal_2eproto() {
-  GOOGLE_PROTOBUF_VERIFY_VERSION;
-
-  {
-    void* ptr = &::sequencer_internal::_ReplicateAppendRequest_default_instance_;
-    new (ptr) ::sequencer_internal::ReplicateAppendRequest();
-    ::PROTOBUF_NAMESPACE_ID::internal::OnShutdownDestroyMessage(ptr);
-  }
-  ::sequencer_internal::ReplicateAppendRequest::InitAsDefaultInstance();
-}
-
-::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_ReplicateAppendRequest_sequencer_5finternal_2eproto =
-    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 0, 0, InitDefaultsscc_info_ReplicateAppendRequest_sequencer_5finternal_2eproto}, {}};
-
-static ::PROTOBUF_NAMESPACE_ID::Metadata file_level_metadata_sequencer_5finternal_2eproto[2];
-static constexpr ::PROTOBUF_NAMESPACE_ID::EnumDescriptor const** file_level_enum_descriptors_sequencer_5finternal_2eproto = nullptr;
-static constexpr ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor const** file_level_service_descriptors_sequencer_5finternal_2eproto = nullptr;
-
-const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_sequencer_5finternal_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
-  ~0u,  // no _has_bits_
-  PROTOBUF_FIELD_OFFSET(::sequencer_internal::ReplicateAppendRequest, _internal_metadata_),
-  ~0u,  // no _extensions_
-  ~0u,  // no _oneof_case_
-  ~0u,  // no _weak_field_map_
-  PROTOBUF_FIELD_OFFSET(::sequencer_internal::ReplicateAppendRequest, client_id_),
-  PROTOBUF_FIELD_OFFSET(::sequencer_internal::ReplicateAppendRequest, req_id_),
-  PROTOBUF_FIELD_OFFSET(::sequencer_internal::ReplicateAppendRequest, record_),
-  PROTOBUF_FIELD_OFFSET(::sequencer_internal::ReplicateAppendRequest, local_index_),
-  ~0u,  // no _has_bits_
-  PROTOBUF_FIELD_OFFSET(::sequencer_internal::ReplicateAppendReply, _internal_metadata_),
-  ~0u,  // no _extensions_
-  ~0u,  // no _oneof_case_
-  ~0u,  // no _weak_field_map_
-  PROTOBUF_FIELD_OFFSET(::sequencer_internal::ReplicateAppendReply, ok_),
-  PROTOBUF_FIELD_OFFSET(::sequencer_internal::ReplicateAppendReply, message_),
-};
-static const ::PROTOBUF_NAMESPACE_ID::internal::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
-  { 0, -1, sizeof(::sequencer_internal::ReplicateAppendRequest)},
-  { 9, -1, sizeof(::sequencer_internal::ReplicateAppendReply)},
-};
-
-static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] = {
-  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::sequencer_internal::_ReplicateAppendRequest_default_instance_),
-  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::sequencer_internal::_ReplicateAppendReply_default_instance_),
-};
-
-const char descriptor_table_protodef_sequencer_5finternal_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
-  "\n\030sequencer_internal.proto\022\022sequencer_in"
-  "ternal\"`\n\026ReplicateAppendRequest\022\021\n\tclie"
-  "nt_id\030\001 \001(\005\022\016\n\006req_id\030\002 \001(\005\022\016\n\006record\030\003 "
-  "\001(\t\022\023\n\013local_index\030\004 \001(\003\"3\n\024ReplicateApp"
-  "endReply\022\n\n\002ok\030\001 \001(\010\022\017\n\007message\030\002 \001(\t2|\n"
-  "\021SequencerInternal\022g\n\017ReplicateAppend\022*."
-  "sequencer_internal.ReplicateAppendReques"
-  "t\032(.sequencer_internal.ReplicateAppendRe"
-  "plyb\006proto3"
-  ;
-static const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable*const descriptor_table_sequencer_5finternal_2eproto_deps[1] = {
-};
-static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_sequencer_5finternal_2eproto_sccs[2] = {
-  &scc_info_ReplicateAppendReply_sequencer_5finternal_2eproto.base,
-  &scc_info_ReplicateAppendRequest_sequencer_5finternal_2eproto.base,
-};
-static ::PROTOBUF_NAMESPACE_ID::internal::once_flag descriptor_table_sequencer_5finternal_2eproto_once;
-const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_sequencer_5finternal_2eproto = {
-  false, false, descriptor_table_protodef_sequencer_5finternal_2eproto, "sequencer_internal.proto", 331,
-  &descriptor_table_sequencer_5finternal_2eproto_once, descriptor_table_sequencer_5finternal_2eproto_sccs, descriptor_table_sequencer_5finternal_2eproto_deps, 2, 0,
-  schemas, file_default_instances, TableStruct_sequencer_5finternal_2eproto::offsets,
-  file_level_metadata_sequencer_5finternal_2eproto, 2, file_level_enum_descriptors_sequencer_5finternal_2eproto, file_level_service_descriptors_sequencer_5finternal_2eproto,
-};
-
-// Force running AddDescriptors() at dynamic initialization time.
-static bool dynamic_init_dummy_sequencer_5finternal_2eproto = (static_cast<void>(::PROTOBUF_NAMESPACE_ID::internal::AddDescriptors(&descriptor_table_sequencer_5finternal_2eproto)), true);
-namespace sequencer_internal {
-
-// ===================================================================
-
-void ReplicateAppendRequest::InitAsDefaultInstance() {
-}
-class ReplicateAppendRequest::_Internal {
- public:
-};
-
-ReplicateAppendRequest::ReplicateAppendRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena)
-  : ::PROTOBUF_NAMESPACE_ID::Message(arena) {
-  SharedCtor();
-  RegisterArenaDtor(arena);
-  // @@protoc_insertion_point(arena_constructor:sequencer_internal.ReplicateAppendRequest)
-}
-ReplicateAppendRequest::ReplicateAppendRequest(const ReplicateAppendRequest& from)
-  : ::PROTOBUF_NAMESPACE_ID::Message() {
-  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  record_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  if (!from._internal_record().empty()) {
-    record_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from._internal_record(),
-      GetArena());
-  }
-  ::memcpy(&client_id_, &from.client_id_,
-    static_cast<size_t>(reinterpret_cast<char*>(&local_index_) -
-    reinterpret_cast<char*>(&client_id_)) + sizeof(local_index_));
-  // @@protoc_insertion_point(copy_constructor:sequencer_internal.ReplicateAppendRequest)
-}
-
-void ReplicateAppendRequest::SharedCtor() {
-  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_ReplicateAppendRequest_sequencer_5finternal_2eproto.base);
-  record_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  ::memset(&client_id_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&local_index_) -
-      reinterpret_cast<char*>(&client_id_)) + sizeof(local_index_));
-}
-
-ReplicateAppendRequest::~ReplicateAppendRequest() {
-  // @@protoc_insertion_point(destructor:sequencer_internal.ReplicateAppendRequest)
-  SharedDtor();
-  _internal_metadata_.Delete<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
-}
-
-void ReplicateAppendRequest::SharedDtor() {
-  GOOGLE_DCHECK(GetArena() == nullptr);
-  record_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-}
-
-void ReplicateAppendRequest::ArenaDtor(void* object) {
-  ReplicateAppendRequest* _this = reinterpret_cast< ReplicateAppendRequest* >(object);
-  (void)_this;
-}
-void ReplicateAppendRequest::RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena*) {
-}
-void ReplicateAppendRequest::SetCachedSize(int size) const {
-  _cached_size_.Set(size);
-}
-const ReplicateAppendRequest& ReplicateAppendRequest::default_instance() {
-  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&::scc_info_ReplicateAppendRequest_sequencer_5finternal_2eproto.base);
-  return *internal_default_instance();
-}
-
-
-void ReplicateAppendRequest::Clear() {
-// @@protoc_insertion_point(message_clear_start:sequencer_internal.ReplicateAppendRequest)
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  // Prevent compiler warnings about cached_has_bits being unused
-  (void) cached_has_bits;
-
-  record_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  ::memset(&client_id_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&local_index_) -
-      reinterpret_cast<char*>(&client_id_)) + sizeof(local_index_));
-  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
-}
-
-const char* ReplicateAppendRequest::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
-#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
-  ::PROTOBUF_NAMESPACE_ID::Arena* arena = GetArena(); (void)arena;
-  while (!ctx->Done(&ptr)) {
-    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
-    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
-    CHK_(ptr);
-    switch (tag >> 3) {
-      // int32 client_id = 1;
-      case 1:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 8)) {
-          client_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
-          CHK_(ptr);
-        } else goto handle_unusual;
-        continue;
-      // int32 req_id = 2;
-      case 2:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 16)) {
-          req_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
-          CHK_(ptr);
-        } else goto handle_unusual;
-        continue;
-      // string record = 3;
-      case 3:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 26)) {
-          auto str = _internal_mutable_record();
-          ptr = ::PROTOBUF_NAMESPACE_ID::internal::InlineGreedyStringParser(str, ptr, ctx);
-          CHK_(::PROTOBUF_NAMESPACE_ID::internal::VerifyUTF8(str, "sequencer_internal.ReplicateAppendRequest.record"));
-          CHK_(ptr);
-        } else goto handle_unusual;
-        continue;
-      // int64 local_index = 4;
-      case 4:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 32)) {
-          local_index_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
-          CHK_(ptr);
-        } else goto handle_unusual;
-        continue;
-      default: {
-      handle_unusual:
-        if ((tag & 7) == 4 || tag == 0) {
-          ctx->SetLastTag(tag);
-          goto success;
-        }
-        ptr = UnknownFieldParse(tag,
-            _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
-            ptr, ctx);
-        CHK_(ptr != nullptr);
-        continue;
-      }
-    }  // switch
-  }  // while
-success:
-  return ptr;
-failure:
-  ptr = nullptr;
-  goto success;
-#undef CHK_
-}
-
-::PROTOBUF_NAMESPACE_ID::uint8* ReplicateAppendRequest::_InternalSerialize(
-    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
-  // @@protoc_insertion_point(serialize_to_array_start:sequencer_internal.ReplicateAppendRequest)
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  (void) cached_has_bits;
-
-  // int32 client_id = 1;
-  if (this->client_id() != 0) {
-    target = stream->EnsureSpace(target);
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt32ToArray(1, this->_internal_client_id(), target);
-  }
-
-  // int32 req_id = 2;
-  if (this->req_id() != 0) {
-    target = stream->EnsureSpace(target);
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt32ToArray(2, this->_internal_req_id(), target);
-  }
-
-  // string record = 3;
-  if (this->record().size() > 0) {
-    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
-      this->_internal_record().data(), static_cast<int>(this->_internal_record().length()),
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
-      "sequencer_internal.ReplicateAppendRequest.record");
-    target = stream->WriteStringMaybeAliased(
-        3, this->_internal_record(), target);
-  }
-
-  // int64 local_index = 4;
-  if (this->local_index() != 0) {
-    target = stream->EnsureSpace(target);
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64ToArray(4, this->_internal_local_index(), target);
-  }
-
-  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
-        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
-  }
-  // @@protoc_insertion_point(serialize_to_array_end:sequencer_internal.ReplicateAppendRequest)
-  return target;
-}
-
-size_t ReplicateAppendRequest::ByteSizeLong() const {
-// @@protoc_insertion_point(message_byte_size_start:sequencer_internal.ReplicateAppendRequest)
-  size_t total_size = 0;
-
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  // Prevent compiler warnings about cached_has_bits being unused
-  (void) cached_has_bits;
-
-  // string record = 3;
-  if (this->record().size() > 0) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
-        this->_internal_record());
-  }
-
-  // int32 client_id = 1;
-  if (this->client_id() != 0) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int32Size(
-        this->_internal_client_id());
-  }
-
-  // int32 req_id = 2;
-  if (this->req_id() != 0) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int32Size(
-        this->_internal_req_id());
-  }
-
-  // int64 local_index = 4;
-  if (this->local_index() != 0) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int64Size(
-        this->_internal_local_index());
-  }
-
-  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
-    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
-        _internal_metadata_, total_size, &_cached_size_);
-  }
-  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
-  SetCachedSize(cached_size);
-  return total_size;
-}
-
-void ReplicateAppendRequest::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
-// @@protoc_insertion_point(generalized_merge_from_start:sequencer_internal.ReplicateAppendRequest)
-  GOOGLE_DCHECK_NE(&from, this);
-  const ReplicateAppendRequest* source =
-      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<ReplicateAppendRequest>(
-          &from);
-  if (source == nullptr) {
-  // @@protoc_insertion_point(generalized_merge_from_cast_fail:sequencer_internal.ReplicateAppendRequest)
-    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
-  } else {
-  // @@protoc_insertion_point(generalized_merge_from_cast_success:sequencer_internal.ReplicateAppendRequest)
-    MergeFrom(*source);
-  }
-}
-
-void ReplicateAppendRequest::MergeFrom(const ReplicateAppendRequest& from) {
-// @@protoc_insertion_point(class_specific_merge_from_start:sequencer_internal.ReplicateAppendRequest)
-  GOOGLE_DCHECK_NE(&from, this);
-  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  (void) cached_has_bits;
-
-  if (from.record().size() > 0) {
-    _internal_set_record(from._internal_record());
-  }
-  if (from.client_id() != 0) {
-    _internal_set_client_id(from._internal_client_id());
-  }
-  if (from.req_id() != 0) {
-    _internal_set_req_id(from._internal_req_id());
-  }
-  if (from.local_index() != 0) {
-    _internal_set_local_index(from._internal_local_index());
-  }
-}
-
-void ReplicateAppendRequest::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
-// @@protoc_insertion_point(generalized_copy_from_start:sequencer_internal.ReplicateAppendRequest)
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
-}
-
-void ReplicateAppendRequest::CopyFrom(const ReplicateAppendRequest& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:sequencer_internal.ReplicateAppendRequest)
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
-}
-
-bool ReplicateAppendRequest::IsInitialized() const {
-  return true;
-}
-
-void ReplicateAppendRequest::InternalSwap(ReplicateAppendRequest* other) {
-  using std::swap;
-  _internal_metadata_.Swap<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(&other->_internal_metadata_);
-  record_.Swap(&other->record_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(ReplicateAppendRequest, local_index_)
-      + sizeof(ReplicateAppendRequest::local_index_)
-      - PROTOBUF_FIELD_OFFSET(ReplicateAppendRequest, client_id_)>(
-          reinterpret_cast<char*>(&client_id_),
-          reinterpret_cast<char*>(&other->client_id_));
-}
-
-::PROTOBUF_NAMESPACE_ID::Metadata ReplicateAppendRequest::GetMetadata() const {
-  return GetMetadataStatic();
-}
-
-
-// ===================================================================
-
-void ReplicateAppendReply::InitAsDefaultInstance() {
-}
-class ReplicateAppendReply::_Internal {
- public:
-};
-
-ReplicateAppendReply::ReplicateAppendReply(::PROTOBUF_NAMESPACE_ID::Arena* arena)
-  : ::PROTOBUF_NAMESPACE_ID::Message(arena) {
-  SharedCtor();
-  RegisterArenaDtor(arena);
-  // @@protoc_insertion_point(arena_constructor:sequencer_internal.ReplicateAppendReply)
-}
-ReplicateAppendReply::ReplicateAppendReply(const ReplicateAppendReply& from)
-  : ::PROTOBUF_NAMESPACE_ID::Message() {
-  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  message_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  if (!from._internal_message().empty()) {
-    message_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from._internal_message(),
-      GetArena());
-  }
-  ok_ = from.ok_;
-  // @@protoc_insertion_point(copy_constructor:sequencer_internal.ReplicateAppendReply)
-}
-
-void ReplicateAppendReply::SharedCtor() {
-  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_ReplicateAppendReply_sequencer_5finternal_2eproto.base);
-  message_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  ok_ = false;
-}
-
-ReplicateAppendReply::~ReplicateAppendReply() {
-  // @@protoc_insertion_point(destructor:sequencer_internal.ReplicateAppendReply)
-  SharedDtor();
-  _internal_metadata_.Delete<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
-}
-
-void ReplicateAppendReply::SharedDtor() {
-  GOOGLE_DCHECK(GetArena() == nullptr);
-  message_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-}
-
-void ReplicateAppendReply::ArenaDtor(void* object) {
-  ReplicateAppendReply* _this = reinterpret_cast< ReplicateAppendReply* >(object);
-  (void)_this;
-}
-void ReplicateAppendReply::RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena*) {
-}
-void ReplicateAppendReply::SetCachedSize(int size) const {
-  _cached_size_.Set(size);
-}
-const ReplicateAppendReply& ReplicateAppendReply::default_instance() {
-  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&::scc_info_ReplicateAppendReply_sequencer_5finternal_2eproto.base);
-  return *internal_default_instance();
-}
-
-
-void ReplicateAppendReply::Clear() {
-// @@protoc_insertion_point(message_clear_start:sequencer_internal.ReplicateAppendReply)
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  // Prevent compiler warnings about cached_has_bits being unused
-  (void) cached_has_bits;
-
-  message_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  ok_ = false;
-  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
-}
-
-const char* ReplicateAppendReply::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
-#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
-  ::PROTOBUF_NAMESPACE_ID::Arena* arena = GetArena(); (void)arena;
-  while (!ctx->Done(&ptr)) {
-    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
-    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
-    CHK_(ptr);
-    switch (tag >> 3) {
-      // bool ok = 1;
-      case 1:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 8)) {
-          ok_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
-          CHK_(ptr);
-        } else goto handle_unusual;
-        continue;
-      // string message = 2;
-      case 2:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 18)) {
-          auto str = _internal_mutable_message();
-          ptr = ::PROTOBUF_NAMESPACE_ID::internal::InlineGreedyStringParser(str, ptr, ctx);
-          CHK_(::PROTOBUF_NAMESPACE_ID::internal::VerifyUTF8(str, "sequencer_internal.ReplicateAppendReply.message"));
-          CHK_(ptr);
-        } else goto handle_unusual;
-        continue;
-      default: {
-      handle_unusual:
-        if ((tag & 7) == 4 || tag == 0) {
-          ctx->SetLastTag(tag);
-          goto success;
-        }
-        ptr = UnknownFieldParse(tag,
-            _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
-            ptr, ctx);
-        CHK_(ptr != nullptr);
-        continue;
-      }
-    }  // switch
-  }  // while
-success:
-  return ptr;
-failure:
-  ptr = nullptr;
-  goto success;
-#undef CHK_
-}
-
-::PROTOBUF_NAMESPACE_ID::uint8* ReplicateAppendReply::_InternalSerialize(
-    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
-  // @@protoc_insertion_point(serialize_to_array_start:sequencer_internal.ReplicateAppendReply)
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  (void) cached_has_bits;
-
-  // bool ok = 1;
-  if (this->ok() != 0) {
-    target = stream->EnsureSpace(target);
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteBoolToArray(1, this->_internal_ok(), target);
-  }
-
-  // string message = 2;
-  if (this->message().size() > 0) {
-    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
-      this->_internal_message().data(), static_cast<int>(this->_internal_message().length()),
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
-      "sequencer_internal.ReplicateAppendReply.message");
-    target = stream->WriteStringMaybeAliased(
-        2, this->_internal_message(), target);
-  }
-
-  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
-        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
-  }
-  // @@protoc_insertion_point(serialize_to_array_end:sequencer_internal.ReplicateAppendReply)
-  return target;
-}
-
-size_t ReplicateAppendReply::ByteSizeLong() const {
-// @@protoc_insertion_point(message_byte_size_start:sequencer_internal.ReplicateAppendReply)
-  size_t total_size = 0;
-
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  // Prevent compiler warnings about cached_has_bits being unused
-  (void) cached_has_bits;
-
-  // string message = 2;
-  if (this->message().size() > 0) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
-        this->_internal_message());
-  }
-
-  // bool ok = 1;
-  if (this->ok() != 0) {
-    total_size += 1 + 1;
-  }
-
-  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
-    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
-        _internal_metadata_, total_size, &_cached_size_);
-  }
-  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
-  SetCachedSize(cached_size);
-  return total_size;
-}
-
-void ReplicateAppendReply::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
-// @@protoc_insertion_point(generalized_merge_from_start:sequencer_internal.ReplicateAppendReply)
-  GOOGLE_DCHECK_NE(&from, this);
-  const ReplicateAppendReply* source =
-      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<ReplicateAppendReply>(
-          &from);
-  if (source == nullptr) {
-  // @@protoc_insertion_point(generalized_merge_from_cast_fail:sequencer_internal.ReplicateAppendReply)
-    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
-  } else {
-  // @@protoc_insertion_point(generalized_merge_from_cast_success:sequencer_internal.ReplicateAppendReply)
-    MergeFrom(*source);
-  }
-}
-
-void ReplicateAppendReply::MergeFrom(const ReplicateAppendReply& from) {
-// @@protoc_insertion_point(class_specific_merge_from_start:sequencer_internal.ReplicateAppendReply)
-  GOOGLE_DCHECK_NE(&from, this);
-  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
-  (void) cached_has_bits;
-
-  if (from.message().size() > 0) {
-    _internal_set_message(from._internal_message());
-  }
-  if (from.ok() != 0) {
-    _internal_set_ok(from._internal_ok());
-  }
-}
-
-void ReplicateAppendReply::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
-// @@protoc_insertion_point(generalized_copy_from_start:sequencer_internal.ReplicateAppendReply)
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
-}
-
-void ReplicateAppendReply::CopyFrom(const ReplicateAppendReply& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:sequencer_internal.ReplicateAppendReply)
-  if (&from == this) return;
-  Clear();
-  MergeFrom(from);
-}
-
-bool ReplicateAppendReply::IsInitialized() const {
-  return true;
-}
-
-void ReplicateAppendReply::InternalSwap(ReplicateAppendReply* other) {
-  using std::swap;
-  _internal_metadata_.Swap<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(&other->_internal_metadata_);
-  message_.Swap(&other->message_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  swap(ok_, other->ok_);
-}
-
-::PROTOBUF_NAMESPACE_ID::Metadata ReplicateAppendReply::GetMetadata() const {
-  return GetMetadataStatic();
-}
-
-
-// @@protoc_insertion_point(namespace_scope)
-}  // namespace sequencer_internal
-PROTOBUF_NAMESPACE_OPEN
-template<> PROTOBUF_NOINLINE ::sequencer_internal::ReplicateAppendRequest* Arena::CreateMaybeMessage< ::sequencer_internal::ReplicateAppendRequest >(Arena* arena) {
-  return Arena::CreateMessageInternal< ::sequencer_internal::ReplicateAppendRequest >(arena);
-}
-template<> PROTOBUF_NOINLINE ::sequencer_internal::ReplicateAppendReply* Arena::CreateMaybeMessage< ::sequencer_internal::ReplicateAppendReply >(Arena* arena) {
-  return Arena::CreateMessageInternal< ::sequencer_internal::ReplicateAppendReply >(arena);
-}
-PROTOBUF_NAMESPACE_CLOSE
-
-// @@protoc_insertion_point(global_scope)
-#include <google/protobuf/port_undef.inc>
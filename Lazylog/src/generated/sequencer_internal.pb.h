@@ -1,691 +0,0 @@
-// Generated by the protocol buffer compiler.  DO NOT EDIT!
-// source: sequencer_internal.proto
-
-#ifndef GOOGLE_PROTOBUF_INCLUDED_sequencer_5finternal_2eproto
-#define GOOGLE_PROTOBUF_INCLUDED_sequencer_5finternal_2eproto
-
-#include <limits>
-#include <string>
-
-#include <google/protobuf/port_def.inc>
-#if PROTOBUF_VERSION < 3012000
-#error This file was generated by a newer version of protoc which is
-#error incompatible with your Protocol Buffer headers. Please update
-#error your headers.
-#endif
-#if 3012004 < PROTOBUF_MIN_PROTOC_VERSION
-#error This file was generated by an older version of protoc which is
-#error incompatible with your Protocol Buffer headers. Please
-#error regenerate this file with a newer version of protoc.
-#endif
-
-#include <google/protobuf/port_undef.inc>
-#include <google/protobuf/io/coded_stream.h>
-#include <google/protobuf/arena.h>
-#include <google/protobuf/arenastring.h>
-#include <google/protobuf/generated_message_table_driven.h>
-#include <google/protobuf/generated_message_util.h>
-#include <google/protobuf/inlined_string_field.h>
-#include <google/protobuf/metadata_lite.h>
-#include <google/protobuf/generated_message_reflection.h>
-#include <google/protobuf/message.h>
-#include <google/protobuf/repeated_field.h>  // IWYU pragma: export
-#include <google/protobuf/extension_set.h>  // IWYU pragma: export
-#include <google/protobuf/unknown_field_set.h>
-// @@protoc_insertion_point(includes)
-#include <google/protobuf/port_def.inc>
-#define PROTOBUF_INTERNAL_EXPORT_sequencer_5finternal_2eproto
-PROTOBUF_NAMESPACE_OPEN
-namespace internal {
-class AnyMetadata;
-}  // namespace internal
-PROTOBUF_NAMESPACE_CLOSE
-
-// Internal implementation detail -- do not use these members.
-struct TableStruct_sequencer_5finternal_2eproto {
-  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTableField entries[]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::AuxillaryParseTableField aux[]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTable schema[2]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::FieldMetadata field_metadata[];
-  static const ::PROTOBUF_NAMESPACE_ID::internal::SerializationTable serialization_table[];
-  static const ::PROTOBUF_NAMESPACE_ID::uint32 offsets[];
-};
-extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_sequencer_5finternal_2eproto;
-namespace sequencer_internal {
-class ReplicateAppendReply;
-class ReplicateAppendReplyDefaultTypeInternal;
-extern ReplicateAppendReplyDefaultTypeInternal _ReplicateAppendReply_default_instance_;
-class ReplicateAppendRequest;
-class ReplicateAppendRequestDefaultTypeInternal;
-extern ReplicateAppendRequestDefaultTypeInternal _ReplicateAppendRequest_default_instance_;
-}  // namespace sequencer_internal
-PROTOBUF_NAMESPACE_OPEN
-template<> ::sequencer_internal::ReplicateAppendReply* Arena::CreateMaybeMessage<::sequencer_internal::ReplicateAppendReply>(Arena*);
-template<> ::sequencer_internal::ReplicateAppendRequest* Arena::CreateMaybeMessage<::sequencer_internal::ReplicateAppendRequest>(Arena*);
-PROTOBUF_NAMESPACE_CLOSE
-namespace sequencer_internal {
-
-// ===================================================================
-
-class ReplicateAppendRequest PROTOBUF_FINAL :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:sequencer_internal.ReplicateAppendRequest) */ {
- public:
-  inline ReplicateAppendRequest() : ReplicateAppendRequest(nullptr) {};
-  virtual ~ReplicateAppendRequest();
-
-  ReplicateAppendRequest(const ReplicateAppendRequest& from);
-  ReplicateAppendRequest(ReplicateAppendRequest&& from) noexcept
-    : ReplicateAppendRequest() {
-    *this = ::std::move(from);
-  }
-
-  inline ReplicateAppendRequest& operator=(const ReplicateAppendRequest& from) {
-    CopyFrom(from);
-    return *this;
-  }
-  inline ReplicateAppendRequest& operator=(ReplicateAppendRequest&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
-    } else {
-      CopyFrom(from);
-    }
-    return *this;
-  }
-
-  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
-    return GetDescriptor();
-  }
-  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
-  }
-  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
-  }
-  static const ReplicateAppendRequest& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
-  static inline const ReplicateAppendRequest* internal_default_instance() {
-    return reinterpret_cast<const ReplicateAppendRequest*>(
-               &_ReplicateAppendRequest_default_instance_);
-  }
-  static constexpr int kIndexInFileMessages =
-    0;
-
-  friend void swap(ReplicateAppendRequest& a, ReplicateAppendRequest& b) {
-    a.Swap(&b);
-  }
-  inline void Swap(ReplicateAppendRequest* other) {
-    if (other == this) return;
-    if (GetArena() == other->GetArena()) {
-      InternalSwap(other);
-    } else {
-      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
-    }
-  }
-  void UnsafeArenaSwap(ReplicateAppendRequest* other) {
-    if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
-    InternalSwap(other);
-  }
-
-  // implements Message ----------------------------------------------
-
-  inline ReplicateAppendRequest* New() const final {
-    return CreateMaybeMessage<ReplicateAppendRequest>(nullptr);
-  }
-
-  ReplicateAppendRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
-    return CreateMaybeMessage<ReplicateAppendRequest>(arena);
-  }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void CopyFrom(const ReplicateAppendRequest& from);
-  void MergeFrom(const ReplicateAppendRequest& from);
-  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
-  bool IsInitialized() const final;
-
-  size_t ByteSizeLong() const final;
-  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
-
-  private:
-  inline void SharedCtor();
-  inline void SharedDtor();
-  void SetCachedSize(int size) const final;
-  void InternalSwap(ReplicateAppendRequest* other);
-  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
-  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "sequencer_internal.ReplicateAppendRequest";
-  }
-  protected:
-  explicit ReplicateAppendRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  public:
-
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_sequencer_5finternal_2eproto);
-    return ::descriptor_table_sequencer_5finternal_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
-
-  public:
-
-  // nested types ----------------------------------------------------
-
-  // accessors -------------------------------------------------------
-
-  enum : int {
-    kRecordFieldNumber = 3,
-    kClientIdFieldNumber = 1,
-    kReqIdFieldNumber = 2,
-    kLocalIndexFieldNumber = 4,
-  };
-  // string record = 3;
-  void clear_record();
-  const std::string& record() const;
-  void set_record(const std::string& value);
-  void set_record(std::string&& value);
-  void set_record(const char* value);
-  void set_record(const char* value, size_t size);
-  std::string* mutable_record();
-  std::string* release_record();
-  void set_allocated_record(std::string* record);
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  std::string* unsafe_arena_release_record();
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  void unsafe_arena_set_allocated_record(
-      std::string* record);
-  private:
-  const std::string& _internal_record() const;
-  void _internal_set_record(const std::string& value);
-  std::string* _internal_mutable_record();
-  public:
-
-  // int32 client_id = 1;
-  void clear_client_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 client_id() const;
-  void set_client_id(::PROTOBUF_NAMESPACE_ID::int32 value);
-  private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_client_id() const;
-  void _internal_set_client_id(::PROTOBUF_NAMESPACE_ID::int32 value);
-  public:
-
-  // int32 req_id = 2;
-  void clear_req_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 req_id() const;
-  void set_req_id(::PROTOBUF_NAMESPACE_ID::int32 value);
-  private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_req_id() const;
-  void _internal_set_req_id(::PROTOBUF_NAMESPACE_ID::int32 value);
-  public:
-
-  // int64 local_index = 4;
-  void clear_local_index();
-  ::PROTOBUF_NAMESPACE_ID::int64 local_index() const;
-  void set_local_index(::PROTOBUF_NAMESPACE_ID::int64 value);
-  private:
-  ::PROTOBUF_NAMESPACE_ID::int64 _internal_local_index() const;
-  void _internal_set_local_index(::PROTOBUF_NAMESPACE_ID::int64 value);
-  public:
-
-  // @@protoc_insertion_point(class_scope:sequencer_internal.ReplicateAppendRequest)
- private:
-  class _Internal;
-
-  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
-  typedef void InternalArenaConstructable_;
-  typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr record_;
-  ::PROTOBUF_NAMESPACE_ID::int32 client_id_;
-  ::PROTOBUF_NAMESPACE_ID::int32 req_id_;
-  ::PROTOBUF_NAMESPACE_ID::int64 local_index_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  friend struct ::TableStruct_sequencer_5finternal_2eproto;
-};
-// -------------------------------------------------------------------
-
-class ReplicateAppendReply PROTOBUF_FINAL :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:sequencer_internal.ReplicateAppendReply) */ {
- public:
-  inline ReplicateAppendReply() : ReplicateAppendReply(nullptr) {};
-  virtual ~ReplicateAppendReply();
-
-  ReplicateAppendReply(const ReplicateAppendReply& from);
-  ReplicateAppendReply(ReplicateAppendReply&& from) noexcept
-    : ReplicateAppendReply() {
-    *this = ::std::move(from);
-  }
-
-  inline ReplicateAppendReply& operator=(const ReplicateAppendReply& from) {
-    CopyFrom(from);
-    return *this;
-  }
-  inline ReplicateAppendReply& operator=(ReplicateAppendReply&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
-    } else {
-      CopyFrom(from);
-    }
-    return *this;
-  }
-
-  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
-    return GetDescriptor();
-  }
-  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
-  }
-  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
-  }
-  static const ReplicateAppendReply& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
-  static inline const ReplicateAppendReply* internal_default_instance() {
-    return reinterpret_cast<const ReplicateAppendReply*>(
-               &_ReplicateAppendReply_default_instance_);
-  }
-  static constexpr int kIndexInFileMessages =
-    1;
-
-  friend void swap(ReplicateAppendReply& a, ReplicateAppendReply& b) {
-    a.Swap(&b);
-  }
-  inline void Swap(ReplicateAppendReply* other) {
-    if (other == this) return;
-    if (GetArena() == other->GetArena()) {
-      InternalSwap(other);
-    } else {
-      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
-    }
-  }
-  void UnsafeArenaSwap(ReplicateAppendReply* other) {
-    if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
-    InternalSwap(other);
-  }
-
-  // implements Message ----------------------------------------------
-
-  inline ReplicateAppendReply* New() const final {
-    return CreateMaybeMessage<ReplicateAppendReply>(nullptr);
-  }
-
-  ReplicateAppendReply* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
-    return CreateMaybeMessage<ReplicateAppendReply>(arena);
-  }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void CopyFrom(const ReplicateAppendReply& from);
-  void MergeFrom(const ReplicateAppendReply& from);
-  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
-  bool IsInitialized() const final;
-
-  size_t ByteSizeLong() const final;
-  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
-
-  private:
-  inline void SharedCtor();
-  inline void SharedDtor();
-  void SetCachedSize(int size) const final;
-  void InternalSwap(ReplicateAppendReply* other);
-  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
-  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "sequencer_internal.ReplicateAppendReply";
-  }
-  protected:
-  explicit ReplicateAppendReply(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  public:
-
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_sequencer_5finternal_2eproto);
-    return ::descriptor_table_sequencer_5finternal_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
-
-  public:
-
-  // nested types ----------------------------------------------------
-
-  // accessors -------------------------------------------------------
-
-  enum : int {
-    kMessageFieldNumber = 2,
-    kOkFieldNumber = 1,
-  };
-  // string message = 2;
-  void clear_message();
-  const std::string& message() const;
-  void set_message(const std::string& value);
-  void set_message(std::string&& value);
-  void set_message(const char* value);
-  void set_message(const char* value, size_t size);
-  std::string* mutable_message();
-  std::string* release_message();
-  void set_allocated_message(std::string* message);
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  std::string* unsafe_arena_release_message();
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  void unsafe_arena_set_allocated_message(
-      std::string* message);
-  private:
-  const std::string& _internal_message() const;
-  void _internal_set_message(const std::string& value);
-  std::string* _internal_mutable_message();
-  public:
-
-  // bool ok = 1;
-  void clear_ok();
-  bool ok() const;
-  void set_ok(bool value);
-  private:
-  bool _internal_ok() const;
-  void _internal_set_ok(bool value);
-  public:
-
-  // @@protoc_insertion_point(class_scope:sequencer_internal.ReplicateAppendReply)
- private:
-  class _Internal;
-
-  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
-  typedef void InternalArenaConstructable_;
-  typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
-  bool ok_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  friend struct ::TableStruct_sequencer_5finternal_2eproto;
-};
-// ===================================================================
-
-
-// ===================================================================
-
-#ifdef __GNUC__
-  #pragma GCC diagnostic push
-  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
-#endif  // __GNUC__
-// ReplicateAppendRequest
-
-// int32 client_id = 1;
-inline void ReplicateAppendRequest::clear_client_id() {
-  client_id_ = 0;
-}
-inline ::PROTOBUF_NAMESPACE_ID::int32 ReplicateAppendRequest::_internal_client_id() const {
-  return client_id_;
-}
-inline ::PROTOBUF_NAMESPACE_ID::int32 ReplicateAppendRequest::client_id() const {
-  // @@protoc_insertion_point(field_get:sequencer_internal.ReplicateAppendRequest.client_id)
-  return _internal_client_id();
-}
-inline void ReplicateAppendRequest::_internal_set_client_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  
-  client_id_ = value;
-}
-inline void ReplicateAppendRequest::set_client_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _internal_set_client_id(value);
-  // @@protoc_insertion_point(field_set:sequencer_internal.ReplicateAppendRequest.client_id)
-}
-
-// int32 req_id = 2;
-inline void ReplicateAppendRequest::clear_req_id() {
-  req_id_ = 0;
-}
-inline ::PROTOBUF_NAMESPACE_ID::int32 ReplicateAppendRequest::_internal_req_id() const {
-  return req_id_;
-}
-inline ::PROTOBUF_NAMESPACE_ID::int32 ReplicateAppendRequest::req_id() const {
-  // @@protoc_insertion_point(field_get:sequencer_internal.ReplicateAppendRequest.req_id)
-  return _internal_req_id();
-}
-inline void ReplicateAppendRequest::_internal_set_req_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  
-  req_id_ = value;
-}
-inline void ReplicateAppendRequest::set_req_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _internal_set_req_id(value);
-  // @@protoc_insertion_point(field_set:sequencer_internal.ReplicateAppendRequest.req_id)
-}
-
-// string record = 3;
-inline void ReplicateAppendRequest::clear_record() {
-  record_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-}
-inline const std::string& ReplicateAppendRequest::record() const {
-  // @@protoc_insertion_point(field_get:sequencer_internal.ReplicateAppendRequest.record)
-  return _internal_record();
-}
-inline void ReplicateAppendRequest::set_record(const std::string& value) {
-  _internal_set_record(value);
-  // @@protoc_insertion_point(field_set:sequencer_internal.ReplicateAppendRequest.record)
-}
-inline std::string* ReplicateAppendRequest::mutable_record() {
-  // @@protoc_insertion_point(field_mutable:sequencer_internal.ReplicateAppendRequest.record)
-  return _internal_mutable_record();
-}
-inline const std::string& ReplicateAppendRequest::_internal_record() const {
-  return record_.Get();
-}
-inline void ReplicateAppendRequest::_internal_set_record(const std::string& value) {
-  
-  record_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value, GetArena());
-}
-inline void ReplicateAppendRequest::set_record(std::string&& value) {
-  
-  record_.Set(
-    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:sequencer_internal.ReplicateAppendRequest.record)
-}
-inline void ReplicateAppendRequest::set_record(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  
-  record_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value),
-              GetArena());
-  // @@protoc_insertion_point(field_set_char:sequencer_internal.ReplicateAppendRequest.record)
-}
-inline void ReplicateAppendRequest::set_record(const char* value,
-    size_t size) {
-  
-  record_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:sequencer_internal.ReplicateAppendRequest.record)
-}
-inline std::string* ReplicateAppendRequest::_internal_mutable_record() {
-  
-  return record_.Mutable(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-}
-inline std::string* ReplicateAppendRequest::release_record() {
-  // @@protoc_insertion_point(field_release:sequencer_internal.ReplicateAppendRequest.record)
-  return record_.Release(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-}
-inline void ReplicateAppendRequest::set_allocated_record(std::string* record) {
-  if (record != nullptr) {
-    
-  } else {
-    
-  }
-  record_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), record,
-      GetArena());
-  // @@protoc_insertion_point(field_set_allocated:sequencer_internal.ReplicateAppendRequest.record)
-}
-inline std::string* ReplicateAppendRequest::unsafe_arena_release_record() {
-  // @@protoc_insertion_point(field_unsafe_arena_release:sequencer_internal.ReplicateAppendRequest.record)
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  
-  return record_.UnsafeArenaRelease(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      GetArena());
-}
-inline void ReplicateAppendRequest::unsafe_arena_set_allocated_record(
-    std::string* record) {
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  if (record != nullptr) {
-    
-  } else {
-    
-  }
-  record_.UnsafeArenaSetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      record, GetArena());
-  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:sequencer_internal.ReplicateAppendRequest.record)
-}
-
-// int64 local_index = 4;
-inline void ReplicateAppendRequest::clear_local_index() {
-  local_index_ = PROTOBUF_LONGLONG(0);
-}
-inline ::PROTOBUF_NAMESPACE_ID::int64 ReplicateAppendRequest::_internal_local_index() const {
-  return local_index_;
-}
-inline ::PROTOBUF_NAMESPACE_ID::int64 ReplicateAppendRequest::local_index() const {
-  // @@protoc_insertion_point(field_get:sequencer_internal.ReplicateAppendRequest.local_index)
-  return _internal_local_index();
-}
-inline void ReplicateAppendRequest::_internal_set_local_index(::PROTOBUF_NAMESPACE_ID::int64 value) {
-  
-  local_index_ = value;
-}
-inline void ReplicateAppendRequest::set_local_index(::PROTOBUF_NAMESPACE_ID::int64 value) {
-  _internal_set_local_index(value);
-  // @@protoc_insertion_point(field_set:sequencer_internal.ReplicateAppendRequest.local_index)
-}
-
-// -------------------------------------------------------------------
-
-// ReplicateAppendReply
-
-// bool ok = 1;
-inline void ReplicateAppendReply::clear_ok() {
-  ok_ = false;
-}
-inline bool ReplicateAppendReply::_internal_ok() const {
-  return ok_;
-}
-inline bool ReplicateAppendReply::ok() const {
-  // @@protoc_insertion_point(field_get:sequencer_internal.ReplicateAppendReply.ok)
-  return _internal_ok();
-}
-inline void ReplicateAppendReply::_internal_set_ok(bool value) {
-  
-  ok_ = value;
-}
-inline void ReplicateAppendReply::set_ok(bool value) {
-  _internal_set_ok(value);
-  // @@protoc_insertion_point(field_set:sequencer_internal.ReplicateAppendReply.ok)
-}
-
-// string message = 2;
-inline void ReplicateAppendReply::clear_message() {
-  message_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-}
-inline const std::string& ReplicateAppendReply::message() const {
-  // @@protoc_insertion_point(field_get:sequencer_internal.ReplicateAppendReply.message)
-  return _internal_message();
-}
-inline void ReplicateAppendReply::set_message(const std::string& value) {
-  _internal_set_message(value);
-  // @@protoc_insertion_point(field_set:sequencer_internal.ReplicateAppendReply.message)
-}
-inline std::string* ReplicateAppendReply::mutable_message() {
-  // @@protoc_insertion_point(field_mutable:sequencer_internal.ReplicateAppendReply.message)
-  return _internal_mutable_message();
-}
-inline const std::string& ReplicateAppendReply::_internal_message() const {
-  return message_.Get();
-}
-inline void ReplicateAppendReply::_internal_set_message(const std::string& value) {
-  
-  message_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value, GetArena());
-}
-inline void ReplicateAppendReply::set_message(std::string&& value) {
-  
-  message_.Set(
-    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:sequencer_internal.ReplicateAppendReply.message)
-}
-inline void ReplicateAppendReply::set_message(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  
-  message_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value),
-              GetArena());
-  // @@protoc_insertion_point(field_set_char:sequencer_internal.ReplicateAppendReply.message)
-}
-inline void ReplicateAppendReply::set_message(const char* value,
-    size_t size) {
-  
-  message_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:sequencer_internal.ReplicateAppendReply.message)
-}
-inline std::string* ReplicateAppendReply::_internal_mutable_message() {
-  
-  return message_.Mutable(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-}
-inline std::string* ReplicateAppendReply::release_message() {
-  // @@protoc_insertion_point(field_release:sequencer_internal.ReplicateAppendReply.message)
-  return message_.Release(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-}
-inline void ReplicateAppendReply::set_allocated_message(std::string* message) {
-  if (message != nullptr) {
-    
-  } else {
-    
-  }
-  message_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), message,
-      GetArena());
-  // @@protoc_insertion_point(field_set_allocated:sequencer_internal.ReplicateAppendReply.message)
-}
-inline std::string* ReplicateAppendReply::unsafe_arena_release_message() {
-  // @@protoc_insertion_point(field_unsafe_arena_release:sequencer_internal.ReplicateAppendReply.message)
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  
-  return message_.UnsafeArenaRelease(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      GetArena());
-}
-inline void ReplicateAppendReply::unsafe_arena_set_allocated_message(
-    std::string* message) {
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  if (message != nullptr) {
-    
-  } else {
-    
-  }
-  message_.UnsafeArenaSetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      message, GetArena());
-  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:sequencer_internal.ReplicateAppendReply.message)
-}
-
-#ifdef __GNUC__
-  #pragma GCC diagnostic pop
-#endif  // __GNUC__
-// -------------------------------------------------------------------
-
-
-// @@protoc_insertion_point(namespace_scope)
-
-}  // namespace sequencer_internal
-
-// @@protoc_insertion_point(global_scope)
-
-#include <google/protobuf/port_undef.inc>
-#endif  // GOOGLE_PROTOBUF_INCLUDED_GOOGLE_PROTOBUF_INCLUDED_sequencer_5finternal_2eproto
@@ -0,0 +1,130 @@
+#include "lazylog_client.h"
+#include "coordinator.h"
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+#include <grpcpp/grpcpp.h>
+
+int64_t retry_after_hint(const grpc::ClientContext &ctx) {
+    const auto &trailers = ctx.GetServerTrailingMetadata();
+    auto it = trailers.find("retry-after-ms");
+    if (it == trailers.end()) return 0;
+    try {
+        return std::stoll(std::string(it->second.data(), it->second.size()));
+    } catch (const std::exception &) {
+        return 0;
+    }
+}
+
+LazylogClient::LazylogClient(std::vector<std::string> seeds, Coordinator *coord)
+    : seeds_(std::move(seeds)), coord_(coord) {}
+
+std::string LazylogClient::leader() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return leader_;
+}
+
+std::shared_ptr<sequencer::SequencerService::Stub> LazylogClient::stub_for(const std::string &addr) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto &stub = stubs_[addr];
+    if (!stub) {
+        stub = sequencer::SequencerService::NewStub(
+            grpc::CreateChannel(addr, grpc::InsecureChannelCredentials()));
+    }
+    return stub;
+}
+
+std::string LazylogClient::discover_leader() {
+    if (!coord_) return "";
+    // election nodes are node-<10-digit sequence>; the lowest one leads
+    std::vector<std::string> nodes;
+    if (coord_->children("/lazylog/election", &nodes) != CoordRc::OK || nodes.empty()) return "";
+    std::string addr;
+    if (coord_->get("/lazylog/election/" + *std::min_element(nodes.begin(), nodes.end()), &addr) !=
+        CoordRc::OK) {
+        return "";
+    }
+    return addr;
+}
+
+std::string LazylogClient::next_candidate(const std::string &failed) {
+    std::string found = discover_leader();
+    if (!found.empty() && found != failed) return found;
+    std::lock_guard<std::mutex> lk(mu_);
+    for (size_t i = 0; i < seeds_.size(); ++i) {
+        const std::string &s = seeds_[next_seed_++ % seeds_.size()];
+        if (s != failed) return s;
+    }
+    return found.empty() && !seeds_.empty() ? seeds_[0] : found;
+}
+
+LazylogClient::Result LazylogClient::Append(const sequencer::AppendRequest &req) {
+    Result res;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    std::string target = leader();
+    if (target.empty()) target = next_candidate("");
+    std::set<std::string> tried;   // in this call; asking one again waits first
+
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (target.empty() || tried.count(target)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(backoff_ms));
+        }
+        if (target.empty()) {
+            res.message = "No replica to ask";
+            target = next_candidate("");
+            continue;
+        }
+        tried.insert(target);
+
+        sequencer::AppendReply reply;
+        grpc::ClientContext ctx;
+        ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(rpc_timeout_ms));
+        grpc::Status st = stub_for(target)->Append(&ctx, req, &reply);
+        res.leader = target;
+        if (st.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED) {
+            // the leader is busy, not gone: back to it once the hint passed
+            res.message = st.error_message();
+            res.throttled++;
+            int64_t hint = retry_after_hint(ctx);
+            auto wake = std::chrono::steady_clock::now() + std::chrono::milliseconds(hint ? hint : backoff_ms);
+            std::this_thread::sleep_until(std::min(wake, deadline));
+            tried.erase(target);
+            continue;
+        }
+        if (!st.ok()) {
+            res.message = st.error_message();
+            {
+                std::lock_guard<std::mutex> lk(mu_);
+                if (leader_ == target) leader_.clear();
+            }
+            target = next_candidate(target);
+            continue;
+        }
+        res.message = reply.message();
+        if (reply.success()) {
+            std::lock_guard<std::mutex> lk(mu_);
+            leader_ = target;
+            res.ok = true;
+            res.pos = reply.global_pos();
+            return res;
+        }
+
+        const std::string &hint = reply.leader_addr();
+        if (hint == target) {
+            // the leader itself refused; only a view change in progress or
+            // a lapsed lease (see SequencerServiceImpl::Append) passes
+            if (reply.status() != sequencer::APPEND_SEALED &&
+                reply.status() != sequencer::APPEND_LEASE_EXPIRED) {
+                return res;
+            }
+        } else if (!hint.empty()) {
+            res.redirects++;
+            target = hint;
+        } else {
+            target = next_candidate(target);
+        }
+    }
+    return res;
+}
@@ -0,0 +1,106 @@
+#include "local_cluster.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+LocalCluster::LocalCluster(int replicas, const ServerConfig &base)
+    : base_(base), ensemble_(InMemoryEnsemble::create()), replicas_(replicas) {}
+
+LocalCluster::~LocalCluster() {
+    for (auto &r : replicas_) r.server.reset();
+}
+
+bool LocalCluster::start_replica(int i) {
+    Replica &r = replicas_[i];
+    ServerConfig cfg = base_;
+    cfg.role = "follower";   // the election picks the leader
+    cfg.port = r.port;       // 0 on first start
+    cfg.followers.clear();   // membership comes from the ensemble
+    // one socket and one ring set each
+    if (!cfg.uds.empty()) cfg.uds += "-" + std::to_string(i);
+    if (!cfg.shm_name.empty()) cfg.shm_name += "-" + std::to_string(i);
+
+    std::unique_ptr<Coordinator> coord = ensemble_->connect();
+    r.session = static_cast<InMemoryCoordinator *>(coord.get())->session_id();
+    r.server.reset(new SequencerServer());
+    if (!r.server->Start(cfg, std::move(coord))) {
+        r.server.reset();
+        return false;
+    }
+    r.port = r.server->port();
+    r.addr = r.server->address();
+    std::cout << "[CLUSTER] replica " << i << " up at " << r.addr << "\n";
+    return true;
+}
+
+bool LocalCluster::Start() {
+    for (int i = 0; i < size(); ++i) {
+        if (!start_replica(i)) return false;
+    }
+    return true;
+}
+
+int LocalCluster::WaitForLeader(int timeout_ms, int other_than) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline) {
+        int leader = -1, serving = 0;
+        for (int i = 0; i < size(); ++i) {
+            if (!alive(i) || i == other_than) continue;
+            Sequencer &seq = replicas_[i].server->sequencer();
+            if (seq.is_leader.load() && !seq.sealed.load()) {
+                leader = i;
+                serving++;
+            }
+        }
+        if (serving == 1) return leader;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return -1;
+}
+
+int LocalCluster::WaitForFollowers(int timeout_ms) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    int leader;
+    while ((leader = WaitForLeader(timeout_ms)) >= 0) {
+        std::vector<std::string> followers = replicas_[leader].server->sequencer().get_followers();
+        bool all = true;
+        for (int i = 0; i < size() && all; ++i) {
+            if (i == leader || !alive(i)) continue;
+            all = std::find(followers.begin(), followers.end(), address(i)) != followers.end();
+        }
+        if (all) return leader;
+        if (std::chrono::steady_clock::now() >= deadline) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return -1;
+}
+
+void LocalCluster::Kill(int i) {
+    if (!alive(i)) return;
+    std::cout << "[CLUSTER] killing replica " << i << " (" << address(i) << ")\n";
+    replicas_[i].server->Shutdown();
+    replicas_[i].server.reset();
+}
+
+bool LocalCluster::Restart(int i) {
+    if (alive(i)) return true;
+    std::cout << "[CLUSTER] restarting replica " << i << " on port " << replicas_[i].port << "\n";
+    return start_replica(i);
+}
+
+void LocalCluster::Pause(int i) {
+    if (alive(i)) replicas_[i].server->Pause();
+}
+
+void LocalCluster::Resume(int i) {
+    if (alive(i)) replicas_[i].server->Resume();
+}
+
+void LocalCluster::Delay(int i, int ms) {
+    if (alive(i)) replicas_[i].server->SetDelay(ms);
+}
+
+void LocalCluster::ExpireSession(int i) {
+    if (alive(i)) ensemble_->expire(replicas_[i].session);
+}
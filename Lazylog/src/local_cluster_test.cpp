@@ -0,0 +1,1172 @@
+// Failover scenarios against an in-process 3-replica cluster (LocalCluster):
+// leader crash, restart of the crashed replica, leader stall and session
+// expiry. After every failover the new leader must continue the global order
+// exactly where the old one stopped. Two more clusters check view changes
+// over entries buffered past a gap and past a stalled follower. Then binary
+// records, sharded appends (record bytes on a shard, metadata through the
+// sequencer), and further clusters check the background log GC, checkpoint
+// recovery with request dedup, many named logs on one replica group, the TCP
+// replication transport, the Unix domain socket listener, the shared-memory
+// ingestion rings, leader discovery in LazylogClient, the batching Producer,
+// replication deadlines, admission control and client quotas.
+#include "local_cluster.h"
+#include "lazylog_client.h"
+#include "producer.h"
+#include "shard_server.h"
+#include "uds_target.h"
+#include "shm_ring.h"
+#include <grpcpp/grpcpp.h>
+#include "sequencer.grpc.pb.h"
+#include "shard.grpc.pb.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <unistd.h>
+
+static int g_failures = 0;
+
+#define EXPECT(cond, what)                                             \
+    do {                                                               \
+        if (!(cond)) {                                                 \
+            std::cerr << "[TEST] FAILED: " << what << "\n";            \
+            g_failures++;                                              \
+        }                                                              \
+    } while (0)
+
+// n appends to addr; returns the gp of the first one (-1 on any failure)
+static int64_t append_n(const std::string &addr, int n, int req_base, uint64_t log_id = 0) {
+    auto stub = sequencer::SequencerService::NewStub(
+        grpc::CreateChannel(addr, grpc::InsecureChannelCredentials()));
+    int64_t first = -1, prev = -1;
+    for (int i = 0; i < n; ++i) {
+        sequencer::AppendRequest req;
+        req.set_client_id(7);
+        req.set_req_id(req_base + i);
+        req.set_record("rec-" + std::to_string(req_base + i));
+        req.set_log_id(log_id);
+        sequencer::AppendReply reply;
+        grpc::ClientContext ctx;
+        ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+        grpc::Status st = stub->Append(&ctx, req, &reply);
+        if (!st.ok() || !reply.success()) {
+            std::cerr << "[TEST] append to " << addr << " failed: "
+                      << (st.ok() ? reply.message() : st.error_message()) << "\n";
+            return -1;
+        }
+        if (prev >= 0 && reply.global_pos() != prev + 1) {
+            std::cerr << "[TEST] gp jumped from " << prev << " to " << reply.global_pos() << "\n";
+            return -1;
+        }
+        if (first < 0) first = reply.global_pos();
+        prev = reply.global_pos();
+    }
+    return first;
+}
+
+static sequencer::StatsReply get_stats(const std::string &addr, uint64_t log_id = 0) {
+    auto stub = sequencer::SequencerService::NewStub(
+        grpc::CreateChannel(addr, grpc::InsecureChannelCredentials()));
+    sequencer::StatsRequest req;
+    req.set_log_id(log_id);
+    sequencer::StatsReply stats;
+    grpc::ClientContext ctx;
+    ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+    if (!stub->GetStats(&ctx, req, &stats).ok()) stats.set_log_entries(-1);
+    return stats;
+}
+
+// wait until pred(GetStats of log_id on addr) holds
+template <class Pred>
+static bool wait_stats(const std::string &addr, uint64_t log_id, int timeout_ms, Pred pred) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (pred(get_stats(addr, log_id))) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return false;
+}
+
+// wait until every replica holds at most max_entries log entries
+static bool wait_log_at_most(LocalCluster &c, int64_t max_entries, int timeout_ms) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline) {
+        bool all = true;
+        for (int i = 0; i < c.size() && all; ++i) {
+            int64_t n = get_stats(c.address(i)).log_entries();
+            all = n >= 0 && n <= max_entries;
+        }
+        if (all) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return false;
+}
+
+static void print_failover(LocalCluster &c, int leader) {
+    FailoverStats f;
+    {
+        Sequencer &seq = c.server(leader)->sequencer();
+        std::lock_guard<std::mutex> lk(seq.failover_mtx);
+        f = seq.last_failover;
+    }
+    std::cout << "[TEST] failover to replica " << leader << ": detect_ms=" << f.detect_ms
+              << " elect_ms=" << f.elect_ms << " seal_ms=" << f.seal_ms
+              << " total_ms=" << f.total_ms << "\n";
+}
+
+int main() {
+    ServerConfig base;
+    base.heartbeat_ms = 50;
+    base.lease_ms = 300;
+    base.view_change_timeout_ms = 150;
+
+    LocalCluster cluster(3, base);
+    if (!cluster.Start()) {
+        std::cerr << "[TEST] cluster did not start\n";
+        return 1;
+    }
+
+    int leader = cluster.WaitForFollowers(5000);
+    EXPECT(leader >= 0, "initial leader elected with both followers");
+    if (leader < 0) return 1;
+    int64_t next = 0;
+    EXPECT(append_n(cluster.address(leader), 100, 0) == next, "first batch starts at gp 0");
+    next += 100;
+
+    // 1) leader crash: its session ends, the next replica in line takes over
+    int old = leader;
+    cluster.Kill(old);
+    leader = cluster.WaitForLeader(5000);
+    EXPECT(leader >= 0 && leader != old, "new leader after crash");
+    if (leader < 0) return 1;
+    print_failover(cluster, leader);
+    EXPECT(append_n(cluster.address(leader), 100, 100) == next, "gp continues after crash");
+    next += 100;
+
+    // 2) the crashed replica comes back empty and catches up as a follower
+    EXPECT(cluster.Restart(old), "restart on the old port");
+    EXPECT(cluster.WaitForFollowers(5000) == leader, "restarted replica rejoined");
+    EXPECT(append_n(cluster.address(leader), 20, 200) == next, "appends with restarted replica");
+    next += 20;
+
+    // 3) leader stall: heartbeats stop, a follower preempts it after the
+    // lease; once resumed the stale leader must not serve appends
+    old = leader;
+    cluster.Pause(old);
+    leader = cluster.WaitForLeader(5000, old);
+    EXPECT(leader >= 0, "new leader after stall");
+    if (leader < 0) return 1;
+    print_failover(cluster, leader);
+    cluster.Resume(old);
+    EXPECT(append_n(cluster.address(leader), 50, 300) == next, "gp continues after stall");
+    next += 50;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT(append_n(cluster.address(old), 1, 400) < 0, "stalled leader fenced after resume");
+
+    // 4) session expiry of the leader while its process keeps running
+    old = leader;
+    cluster.ExpireSession(old);
+    leader = cluster.WaitForLeader(5000, old);
+    EXPECT(leader >= 0, "new leader after session expiry");
+    if (leader < 0) return 1;
+    EXPECT(append_n(cluster.address(leader), 10, 500) == next, "gp continues after expiry");
+    next += 10;
+
+    // GetStats on the current leader reflects the appends it served
+    std::this_thread::sleep_for(std::chrono::milliseconds(3 * base.heartbeat_ms));
+    sequencer::StatsReply stats = get_stats(cluster.address(leader));
+    EXPECT(stats.log_entries() >= 0, "GetStats");
+    EXPECT(stats.is_leader() && stats.appends_total() >= 10, "stats count the leader's appends");
+    EXPECT(stats.next_global_pos() == next && stats.last_ordered_gp() == next - 1,
+           "stats report the gp state");
+    EXPECT(stats.latency_size() == 5 && stats.latency(0).count() == stats.appends_total(),
+           "stats carry per-stage latencies");
+    for (const auto &f : stats.followers()) {
+        EXPECT(f.lag_entries() == 0 && f.rtt_us() >= 0, "follower " + f.addr() + " in sync");
+    }
+
+    // a binary record (not valid UTF-8) is ordered and replicated as-is
+    {
+        auto stub = sequencer::SequencerService::NewStub(
+            grpc::CreateChannel(cluster.address(leader), grpc::InsecureChannelCredentials()));
+        sequencer::AppendRequest req;
+        req.set_client_id(9);
+        req.set_req_id(1);
+        req.set_record(std::string("\xff\xfe\0\x80" "binary", 10));
+        sequencer::AppendReply reply;
+        grpc::ClientContext ctx;
+        EXPECT(stub->Append(&ctx, req, &reply).ok() && reply.success() &&
+               reply.global_pos() == next, "binary record appended");
+        next++;
+    }
+
+    // sharded append: the record goes to a replicated shard, the sequencer
+    // orders its metadata without holding the bytes
+    {
+        ShardServer backup, primary;
+        ShardConfig bcfg;
+        bcfg.port = 0;
+        EXPECT(backup.Start(bcfg), "shard backup up");
+        ShardConfig pcfg;
+        pcfg.port = 0;
+        pcfg.backups = {backup.address()};
+        EXPECT(primary.Start(pcfg), "shard primary up");
+
+        auto shard_stub = shard::ShardService::NewStub(
+            grpc::CreateChannel(primary.address(), grpc::InsecureChannelCredentials()));
+        shard::WriteRequest w;
+        w.set_client_id(8);
+        w.set_req_id(1);
+        w.set_record(std::string(4096, 's'));
+        shard::WriteReply wr;
+        grpc::ClientContext wctx;
+        EXPECT(shard_stub->Write(&wctx, w, &wr).ok() && wr.ok(), "shard write");
+        EXPECT(backup.size() == 1 && backup.bytes() == 4096, "shard write replicated to backup");
+
+        int64_t log_bytes = get_stats(cluster.address(leader)).log_bytes();
+        auto stub = sequencer::SequencerService::NewStub(
+            grpc::CreateChannel(cluster.address(leader), grpc::InsecureChannelCredentials()));
+        sequencer::AppendRequest req;
+        req.set_client_id(8);
+        req.set_req_id(1);
+        req.set_shard(1);
+        req.set_record_size(4096);
+        sequencer::AppendReply reply;
+        grpc::ClientContext actx;
+        EXPECT(stub->Append(&actx, req, &reply).ok() && reply.success() &&
+               reply.global_pos() == next, "metadata-only append ordered");
+        next++;
+        EXPECT(get_stats(cluster.address(leader)).log_bytes() == log_bytes,
+               "sequencer log holds no record bytes");
+
+        shard::ReadRequest r;
+        r.set_client_id(8);
+        r.set_req_id(1);
+        shard::ReadReply rr;
+        grpc::ClientContext rctx;
+        EXPECT(shard_stub->Read(&rctx, r, &rr).ok() && rr.ok() && rr.record().size() == 4096,
+               "record read back from its shard");
+    }
+
+    // 5) view change with entries a follower buffered past a gap: they
+    // were acked, so the new view installs them on every replica and none
+    // is left with a hole where they were
+    {
+        LocalCluster vc(3, base);
+        int l = vc.Start() ? vc.WaitForFollowers(5000) : -1;
+        EXPECT(l >= 0, "view-change cluster up");
+        if (l < 0) return 1;
+        EXPECT(append_n(vc.address(l), 10, 0) == 0, "appends before the gap");
+        // gp 11 one local index past the leader's next, as if the entry
+        // for gp 10 were still on its way to the followers
+        int64_t next_index;
+        {
+            Sequencer &lead = vc.server(l)->sequencer();
+            std::lock_guard<std::mutex> lk(lead.mtx);
+            next_index = lead.state.log.last_index() + 1;
+        }
+        for (int i = 0; i < 3; ++i) {
+            if (i == l) continue;
+            Sequencer &seq = vc.server(i)->sequencer();
+            sequencer_internal::ReplicateAppendRequest req;
+            req.set_client_id(41);
+            req.set_req_id(0);
+            req.set_record("past-gap");
+            req.set_local_index(next_index + 1);
+            req.set_global_pos(11);
+            req.set_view(seq.current_view());
+            sequencer_internal::ReplicateAppendReply reply;
+            seq.handle_replicate(&req, &reply);
+            EXPECT(reply.ok() && reply.message() == "Buffered",
+                   "replica " << i << " buffers the entry past the gap");
+        }
+        vc.Kill(l);
+        int nl = vc.WaitForLeader(5000);
+        EXPECT(nl >= 0, "leader after the view change");
+        if (nl < 0) return 1;
+        EXPECT(append_n(vc.address(nl), 1, 100) == 12, "new view continues after the buffered entry");
+        auto at = [&](int i, int64_t gp) {
+            Sequencer &seq = vc.server(i)->sequencer();
+            std::lock_guard<std::mutex> lk(seq.mtx);
+            int n = 0;
+            for (int64_t li = seq.state.log.first_index(); li <= seq.state.log.last_index(); ++li) {
+                const SequencerLog::Entry &e = seq.state.log.get((int)li);
+                if (e.global_pos == gp) n++;
+            }
+            return n;
+        };
+        for (int i = 0; i < 3; ++i) {
+            if (i == l) continue;
+            auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(1000);
+            while (at(i, 12) == 0 && std::chrono::steady_clock::now() < until) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            EXPECT(at(i, 10) == 1 && at(i, 11) == 1 && at(i, 12) == 1,
+                   "replica " << i << " holds gps 10..12 once each");
+        }
+    }
+
+    // 6) a follower stalled through a view change: it never saw SealView
+    // or NewView, so the new leader's indices are not its old leader's.
+    // A new-view ReplicateAppend at an index it held in the old view is
+    // buffered, not acked as already held, and it re-anchors by catch-up
+    {
+        LocalCluster sc(3, base);
+        int l = sc.Start() ? sc.WaitForFollowers(5000) : -1;
+        EXPECT(l >= 0, "stalled-follower cluster up");
+        if (l < 0) return 1;
+        EXPECT(append_n(sc.address(l), 10, 0) == 0, "appends before the view change");
+        int f = (l + 1) % 3;
+        sc.Pause(f);
+        sc.Kill(l);
+        int nl = sc.WaitForLeader(5000, f);
+        EXPECT(nl >= 0 && nl != f, "leader elected while the follower is stalled");
+        if (nl < 0) return 1;
+        // stands in for a new-view ReplicateAppend reaching f ahead of the
+        // SealView it missed: the new leader's entry at index 0, which f
+        // holds in the old view's numbering
+        {
+            Sequencer &seq = sc.server(f)->sequencer();
+            sequencer_internal::ReplicateAppendRequest req;
+            {
+                Sequencer &lead = sc.server(nl)->sequencer();
+                std::lock_guard<std::mutex> lk(lead.mtx);
+                const SequencerLog::Entry &e = lead.state.log.get(0);
+                req.set_client_id(e.client_id);
+                req.set_req_id(e.req_id);
+                req.set_record(e.record);
+                req.set_global_pos(e.global_pos);
+                req.set_view(lead.state.view);
+            }
+            req.set_local_index(0);
+            sequencer_internal::ReplicateAppendReply reply;
+            seq.handle_replicate(&req, &reply);
+            EXPECT(reply.ok() && reply.message() == "Buffered",
+                   "new-view entry at an old-view index is buffered, not taken as held");
+        }
+        sc.Resume(f);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));   // lease renewed
+        int64_t gp = append_n(sc.address(nl), 5, 100);
+        EXPECT(gp >= 10, "appends in the new view");
+        auto holds = [&](int i, int64_t g) {
+            Sequencer &seq = sc.server(i)->sequencer();
+            std::lock_guard<std::mutex> lk(seq.mtx);
+            int n = 0;
+            for (int64_t li = seq.state.log.first_index(); li <= seq.state.log.last_index(); ++li) {
+                if (seq.state.log.get((int)li).global_pos == g) n++;
+            }
+            return n;
+        };
+        auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(2000);
+        while (holds(f, gp + 4) == 0 && std::chrono::steady_clock::now() < until) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        bool whole = true;
+        for (int64_t g = 0; g < gp + 5; ++g) whole = whole && holds(f, g) == 1;
+        EXPECT(whole, "stalled follower holds every gp of both views once");
+    }
+
+    // 7) background GC on a fresh cluster: every replica truncates to the
+    // retention once all followers hold the entries, but not past a hold
+    {
+        ServerConfig gc_cfg = base;
+        gc_cfg.gc_interval_ms = 50;
+        gc_cfg.gc_step_entries = 8;
+        gc_cfg.gc_retain_entries = 16;
+        LocalCluster gc_cluster(3, gc_cfg);
+        int l = gc_cluster.Start() ? gc_cluster.WaitForFollowers(5000) : -1;
+        EXPECT(l >= 0, "GC cluster up");
+        if (l < 0) return 1;
+        Sequencer &lseq = gc_cluster.server(l)->sequencer();
+        lseq.set_gc_hold("test", 50);
+        EXPECT(append_n(gc_cluster.address(l), 200, 0) == 0, "appends on GC cluster");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10 * gc_cfg.gc_interval_ms));
+        sequencer::StatsReply held = get_stats(gc_cluster.address(l));
+        EXPECT(held.log_entries() == 150 && held.gc_gp() == 49, "GC stops at the hold");
+        lseq.clear_gc_hold("test");
+        EXPECT(wait_log_at_most(gc_cluster, gc_cfg.gc_retain_entries, 5000),
+               "every replica GC'd down to the retention");
+        EXPECT(get_stats(gc_cluster.address(l)).gc_gp() == 199 - gc_cfg.gc_retain_entries,
+               "leader GC watermark");
+        EXPECT(append_n(gc_cluster.address(l), 10, 200) == 200, "gp continues after GC");
+    }
+
+    // GC with no retention under concurrent appends: entries replicated
+    // but not yet ordered stay in the log, so every append gets its own gp
+    {
+        ServerConfig gc_cfg = base;
+        gc_cfg.gc_interval_ms = 1;
+        gc_cfg.gc_retain_entries = 0;
+        LocalCluster one(1, gc_cfg);
+        int l = one.Start() ? one.WaitForLeader(5000) : -1;
+        EXPECT(l >= 0, "single-replica GC cluster up");
+        if (l < 0) return 1;
+        const int threads = 16, per_thread = 3000;
+        std::vector<std::vector<int64_t>> gps(threads);
+        std::vector<std::thread> writers;
+        for (int t = 0; t < threads; ++t) {
+            writers.emplace_back([&, t] {
+                auto stub = sequencer::SequencerService::NewStub(
+                    grpc::CreateChannel(one.address(l), grpc::InsecureChannelCredentials()));
+                for (int i = 0; i < per_thread; ++i) {
+                    sequencer::AppendRequest req;
+                    req.set_client_id(100 + t);
+                    req.set_req_id(i);
+                    req.set_record("gc-" + std::to_string(i));
+                    sequencer::AppendReply reply;
+                    grpc::ClientContext ctx;
+                    ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+                    grpc::Status st = stub->Append(&ctx, req, &reply);
+                    gps[t].push_back(st.ok() && reply.success() ? reply.global_pos() : -1);
+                }
+            });
+        }
+        for (auto &w : writers) w.join();
+        std::vector<int64_t> all;
+        for (const auto &g : gps) all.insert(all.end(), g.begin(), g.end());
+        std::sort(all.begin(), all.end());
+        bool dense = true;
+        for (size_t i = 0; i < all.size(); ++i) dense = dense && all[i] == (int64_t)i;
+        EXPECT(dense, "concurrent appends under GC get distinct, dense gps");
+    }
+
+    // 8) checkpoints: a restarted follower recovers the gp state and dedup
+    // table from disk and fetches only the entries past its checkpoint; a
+    // retried request keeps its gp, also across a failover
+    {
+        char dir_tmpl[] = "/tmp/lazylog-ckpt-XXXXXX";
+        const char *dir = mkdtemp(dir_tmpl);
+        EXPECT(dir != nullptr, "checkpoint dir");
+        if (!dir) return 1;
+        ServerConfig ck_cfg = base;
+        ck_cfg.checkpoint_dir = dir;
+        ck_cfg.checkpoint_interval_ms = 50;
+        std::unique_ptr<LocalCluster> cluster_owner(new LocalCluster(3, ck_cfg));
+        LocalCluster &ck = *cluster_owner;
+        int l = ck.Start() ? ck.WaitForFollowers(5000) : -1;
+        EXPECT(l >= 0, "checkpoint cluster up");
+        if (l < 0) return 1;
+        EXPECT(append_n(ck.address(l), 30, 0) == 0, "appends on checkpoint cluster");
+        EXPECT(append_n(ck.address(l), 1, 29) == 29, "retried request keeps its gp");
+        EXPECT(append_n(ck.address(l), 1, 30) == 30, "no gp spent on the retry");
+
+        int f = (l + 1) % 3;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (get_stats(ck.address(f)).checkpoint_gp() != 30 &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        EXPECT(get_stats(ck.address(f)).checkpoint_gp() == 30, "follower checkpointed");
+        ck.Kill(f);
+        EXPECT(append_n(ck.address(l), 20, 31) == 31, "appends while follower down");
+        EXPECT(ck.Restart(f) && ck.WaitForFollowers(5000) == l, "follower restarted");
+        deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        sequencer::StatsReply fs;
+        while ((fs = get_stats(ck.address(f))).last_ordered_gp() != 50 &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        EXPECT(fs.last_ordered_gp() == 50 && fs.log_entries() == 20,
+               "restarted follower fetched only the suffix past its checkpoint");
+
+        ck.Kill(l);
+        l = ck.WaitForLeader(5000);
+        EXPECT(l >= 0, "leader after failover");
+        if (l < 0) return 1;
+        EXPECT(append_n(ck.address(l), 1, 50) == 50, "retry after failover keeps its gp");
+        EXPECT(append_n(ck.address(l), 1, 51) == 51, "gp continues after failover");
+        cluster_owner.reset();   // stop the checkpoint writers first
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    // 9) named logs: each one numbers its entries from 0 and dedups on its
+    // own, a GC hold on one log pins only that log's position, and the
+    // counters survive a follower restart from a checkpoint and a failover
+    {
+        char dir_tmpl[] = "/tmp/lazylog-logs-XXXXXX";
+        const char *dir = mkdtemp(dir_tmpl);
+        EXPECT(dir != nullptr, "checkpoint dir");
+        if (!dir) return 1;
+        ServerConfig logs_cfg = base;
+        logs_cfg.checkpoint_dir = dir;
+        logs_cfg.checkpoint_interval_ms = 50;
+        logs_cfg.gc_interval_ms = 50;
+        logs_cfg.gc_retain_entries = 0;
+        std::unique_ptr<LocalCluster> cluster_owner(new LocalCluster(3, logs_cfg));
+        LocalCluster &lc = *cluster_owner;
+        int l = lc.Start() ? lc.WaitForFollowers(5000) : -1;
+        EXPECT(l >= 0, "named-log cluster up");
+        if (l < 0) return 1;
+        lc.server(l)->sequencer().set_log_gc_hold(1, "test", 5);
+
+        bool dense = true;
+        for (int i = 0; i < 10; ++i) {
+            dense = dense && append_n(lc.address(l), 1, i, 1) == i;
+            dense = dense && append_n(lc.address(l), 1, i, 2) == i;
+        }
+        EXPECT(dense, "interleaved logs are numbered independently");
+        EXPECT(append_n(lc.address(l), 1, 9, 1) == 9, "retry in a named log keeps its position");
+        const int IDLE = 500;
+        bool idle_ok = true;
+        for (int i = 0; i < IDLE; ++i) idle_ok = idle_ok && append_n(lc.address(l), 1, 0, 100 + i) == 0;
+        EXPECT(idle_ok, "one entry in each of many logs");
+        EXPECT(get_stats(lc.address(l)).logs() == IDLE + 2, "leader tracks every log");
+
+        auto gc_at = [](int64_t pos) {
+            return [pos](const sequencer::StatsReply &st) { return st.log().gc_pos() == pos; };
+        };
+        EXPECT(wait_stats(lc.address(l), 1, 5000, gc_at(4)), "log GC stops at the log's hold");
+        EXPECT(get_stats(lc.address(l), 2).log().gc_pos() == 4, "entries behind the hold stay");
+        lc.server(l)->sequencer().clear_log_gc_hold(1, "test");
+        EXPECT(wait_stats(lc.address(l), 2, 5000, gc_at(9)), "log GC past the cleared hold");
+
+        int f = (l + 1) % 3;
+        lc.Kill(f);
+        EXPECT(append_n(lc.address(l), 5, 10, 1) == 10, "named log appends while follower down");
+        EXPECT(lc.Restart(f) && lc.WaitForFollowers(5000) == l, "follower restarted");
+        EXPECT(wait_stats(lc.address(f), 1, 5000, [](const sequencer::StatsReply &st) {
+                   return st.log().next_pos() == 15;
+               }), "restarted follower knows the named log's position");
+
+        lc.Kill(l);
+        l = lc.WaitForLeader(5000);
+        EXPECT(l >= 0, "leader after failover");
+        if (l < 0) return 1;
+        EXPECT(append_n(lc.address(l), 1, 14, 1) == 14, "named log retry after failover");
+        EXPECT(append_n(lc.address(l), 1, 15, 1) == 15, "named log continues after failover");
+        EXPECT(append_n(lc.address(l), 1, 10, 2) == 10, "other log continues after failover");
+        EXPECT(append_n(lc.address(l), 1, 1, 100) == 1, "idle log continues after failover");
+        cluster_owner.reset();
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    // 10) TCP replication transport: followers get entries over their TCP
+    // port, a restarted follower (on a new TCP port) is reconnected, and
+    // the order continues across a failover
+    {
+        ServerConfig tcp_cfg = base;
+        tcp_cfg.repl_transport = "tcp";
+        std::unique_ptr<LocalCluster> cluster_owner(new LocalCluster(3, tcp_cfg));
+        LocalCluster &tc = *cluster_owner;
+        int l = tc.Start() ? tc.WaitForFollowers(5000) : -1;
+        EXPECT(l >= 0, "tcp cluster up");
+        if (l < 0) return 1;
+        auto over_tcp = [&](int leader, int follower) {
+            return tc.server(leader)->sequencer().tcp_transport->connect(tc.address(follower));
+        };
+        // routes arrive with the first heartbeat acks
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        int f = (l + 1) % 3;
+        EXPECT(over_tcp(l, f) && over_tcp(l, (l + 2) % 3), "leader connected to followers over tcp");
+        EXPECT(append_n(tc.address(l), 50, 0) == 0, "appends over tcp");
+        auto holds = [](int64_t n) {
+            return [n](const sequencer::StatsReply &st) { return st.log().next_pos() == n; };
+        };
+        EXPECT(wait_stats(tc.address(f), 0, 5000, holds(50)), "follower holds tcp-replicated entries");
+
+        tc.Kill(f);
+        EXPECT(append_n(tc.address(l), 10, 50) == 50, "tcp appends while follower down");
+        EXPECT(tc.Restart(f) && tc.WaitForFollowers(5000) == l, "tcp follower restarted");
+        EXPECT(append_n(tc.address(l), 10, 60) == 60, "appends after follower restart");
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        EXPECT(over_tcp(l, f), "leader reconnected to the restarted follower");
+        EXPECT(wait_stats(tc.address(f), 0, 5000, holds(70)), "restarted follower caught up");
+
+        tc.Kill(l);
+        l = tc.WaitForLeader(5000);
+        EXPECT(l >= 0, "tcp leader after failover");
+        if (l < 0) return 1;
+        EXPECT(append_n(tc.address(l), 10, 70) == 70, "tcp order continues after failover");
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        for (int i = 0; i < 3; ++i) {
+            if (i != l && tc.alive(i)) EXPECT(over_tcp(l, i), "new leader replicates over tcp");
+        }
+        EXPECT(append_n(tc.address(l), 10, 80) == 80, "tcp appends from the new leader");
+    }
+
+    // 11) Unix domain socket listener: appends over the leader's abstract
+    // socket and over TCP share one order
+    {
+        ServerConfig uds_cfg = base;
+        uds_cfg.uds = "@lazylog-test-" + std::to_string(getpid());
+        LocalCluster uc(3, uds_cfg);
+        int l = uc.Start() ? uc.WaitForFollowers(5000) : -1;
+        EXPECT(l >= 0, "uds cluster up");
+        if (l < 0) return 1;
+        std::string uds_addr = uds_target(uds_cfg.uds + "-" + std::to_string(l));
+        EXPECT(append_n(uds_addr, 10, 0) == 0, "appends over uds");
+        EXPECT(append_n(uc.address(l), 10, 10) == 10, "tcp appends continue the uds ones");
+        EXPECT(append_n(uds_addr, 1, 19) == 19, "retry over uds of a tcp append keeps its gp");
+    }
+
+    // 12) shared-memory ingestion: a producer's batch is ordered densely in
+    // between gRPC appends, retries dedup, followers refuse, and rings are
+    // handed out one per producer
+    {
+        ServerConfig shm_cfg = base;
+        shm_cfg.shm_name = "lazylog-test-" + std::to_string(getpid());
+        shm_cfg.shm_rings = 2;
+        shm_cfg.shm_ring_bytes = 4096;   // small, so the ring wraps
+        LocalCluster sc(3, shm_cfg);
+        int l = sc.Start() ? sc.WaitForFollowers(5000) : -1;
+        EXPECT(l >= 0, "shm cluster up");
+        if (l < 0) return 1;
+        auto rings_of = [&](int i) { return shm_cfg.shm_name + "-" + std::to_string(i); };
+        // one append, waiting for its ack
+        auto shm_append = [](ShmProducer &p, int req_id, uint64_t log_id) {
+            ShmProducer::Ack ack{0, 0, -1, -1};
+            std::string rec = "shm-" + std::to_string(req_id);
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            while (!p.try_append(9, req_id, rec.data(), rec.size(), log_id) &&
+                   std::chrono::steady_clock::now() < deadline) {}
+            while (p.poll(&ack, 1) == 0 && std::chrono::steady_clock::now() < deadline) {}
+            return ack;
+        };
+
+        ShmProducer p;
+        EXPECT(p.attach(rings_of(l)), "producer attaches to the leader's rings");
+        const int N = 200;
+        std::string rec(100, 'r');
+        std::vector<ShmProducer::Ack> acks;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        for (int sent = 0; (int)acks.size() < N && std::chrono::steady_clock::now() < deadline;) {
+            while (sent < N && p.try_append(9, sent, rec.data(), rec.size())) sent++;
+            ShmProducer::Ack a[64];
+            size_t n = p.poll(a, 64);
+            acks.insert(acks.end(), a, a + n);
+        }
+        bool dense = (int)acks.size() == N;
+        for (int i = 0; dense && i < N; ++i) {
+            dense = acks[i].status == shm_ring::OK && acks[i].req_id == i && acks[i].pos == i;
+        }
+        EXPECT(dense, "shm appends are ordered densely and acked in order");
+        EXPECT(append_n(sc.address(l), 10, 0) == N, "grpc appends continue after the shm ones");
+        ShmProducer::Ack dup = shm_append(p, N - 1, 0);
+        EXPECT(dup.status == shm_ring::DUPLICATE && dup.pos == N - 1, "shm retry gets its position");
+        ShmProducer::Ack named = shm_append(p, N, 3);
+        EXPECT(named.status == shm_ring::OK && named.pos == 0, "shm append to a named log");
+        EXPECT(wait_stats(sc.address((l + 1) % 3), 0, 5000, [&](const sequencer::StatsReply &st) {
+                   // the named log's entry took gp N + 10
+                   return st.log().next_pos() == N + 11;
+               }), "followers hold the shm appends");
+
+        ShmProducer q, r;
+        EXPECT(q.attach(rings_of(l)), "second producer gets the second ring");
+        EXPECT(!r.attach(rings_of(l)), "no ring left for a third producer");
+        p.detach();
+        EXPECT(r.attach(rings_of(l)), "a detached ring is handed out again");
+        EXPECT(shm_append(r, N + 1, 0).pos == N + 11, "reattached ring appends");
+
+        ShmProducer f;
+        int fi = (l + 1) % 3;
+        EXPECT(f.attach(rings_of(fi)), "producer attaches to a follower's rings");
+        int32_t st = shm_append(f, 0, 0).status;
+        EXPECT(st == shm_ring::SEALED || st == shm_ring::NOT_LEADER, "follower refuses shm appends");
+    }
+
+    // 13) leader discovery: a follower's rejection names the leader, a
+    // client seeded with a follower is redirected, and after the leader
+    // dies a client with only its address finds the successor through the
+    // coordinator
+    {
+        LocalCluster dc(3, base);
+        int l = dc.Start() ? dc.WaitForFollowers(5000) : -1;
+        EXPECT(l >= 0, "discovery cluster up");
+        if (l < 0) return 1;
+        int f = (l + 1) % 3;
+        auto req = [](int client_id, int req_id) {
+            sequencer::AppendRequest r;
+            r.set_client_id(client_id);
+            r.set_req_id(req_id);
+            r.set_record("disc-" + std::to_string(req_id));
+            return r;
+        };
+
+        {
+            auto stub = sequencer::SequencerService::NewStub(
+                grpc::CreateChannel(dc.address(f), grpc::InsecureChannelCredentials()));
+            sequencer::AppendRequest r = req(11, 0);
+            sequencer::AppendReply reply;
+            grpc::ClientContext ctx;
+            ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+            bool rpc_ok = stub->Append(&ctx, r, &reply).ok();
+            EXPECT(rpc_ok && !reply.success() && reply.leader_addr() == dc.address(l) &&
+                       reply.view() == dc.server(l)->sequencer().current_view(),
+                   "follower rejection names the leader and its view");
+        }
+
+        LazylogClient c({dc.address(f)});
+        LazylogClient::Result r = c.Append(req(11, 0));
+        EXPECT(r.ok && r.pos == 0 && r.redirects == 1, "client seeded with a follower is redirected");
+        EXPECT(c.leader() == dc.address(l), "client caches the leader");
+        r = c.Append(req(11, 1));
+        EXPECT(r.ok && r.pos == 1 && r.redirects == 0, "next append goes straight to the leader");
+
+        std::unique_ptr<Coordinator> coord = dc.ensemble().connect();
+        LazylogClient z({dc.address(l)}, coord.get());
+        EXPECT(z.discover_leader() == dc.address(l), "coordinator names the leader");
+        EXPECT(z.Append(req(12, 0)).pos == 2, "client seeded with the leader");
+
+        dc.Kill(l);
+        r = z.Append(req(12, 1));
+        int nl = dc.WaitForLeader(5000);
+        EXPECT(nl >= 0 && nl != l, "successor elected");
+        EXPECT(r.ok && r.pos == 3, "append after the leader died continues the order");
+        EXPECT(nl >= 0 && z.leader() == dc.address(nl), "client found the successor");
+        coord->close();
+    }
+
+    // 14) Producer: pipelined batches are ordered as appended, a resent
+    // batch gets the positions it had even after later batches, and a
+    // producer keeps its order across a leader failover
+    {
+        LocalCluster pc(3, base);
+        int l = pc.Start() ? pc.WaitForFollowers(5000) : -1;
+        EXPECT(l >= 0, "producer cluster up");
+        if (l < 0) return 1;
+
+        auto stub = sequencer::SequencerService::NewStub(
+            grpc::CreateChannel(pc.address(l), grpc::InsecureChannelCredentials()));
+        auto send = [&](const std::vector<int> &first_reqs) {
+            std::vector<sequencer::AppendBatchReply> replies;
+            grpc::ClientContext ctx;
+            ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+            auto stream = stub->AppendStream(&ctx);
+            for (int first : first_reqs) {
+                sequencer::AppendBatch b;
+                b.set_client_id(21);
+                b.set_first_req_id(first);
+                for (int i = 0; i < 10; ++i) b.add_records("b-" + std::to_string(first + i));
+                stream->Write(b);
+            }
+            stream->WritesDone();
+            sequencer::AppendBatchReply r;
+            while (stream->Read(&r)) replies.push_back(r);
+            stream->Finish();
+            return replies;
+        };
+        std::vector<sequencer::AppendBatchReply> first = send({0, 10, 20});
+        bool dense = first.size() == 3;
+        for (size_t k = 0; dense && k < 3; ++k) {
+            dense = first[k].success() && first[k].positions_size() == 10;
+            for (int i = 0; dense && i < 10; ++i) dense = first[k].positions(i) == (int64_t)(10 * k + i);
+        }
+        EXPECT(dense, "stream batches ordered densely in stream order");
+        std::vector<sequencer::AppendBatchReply> again = send({0, 10, 20});
+        bool same = again.size() == 3;
+        for (size_t k = 0; same && k < 3; ++k) {
+            same = again[k].success() && again[k].positions_size() == 10 &&
+                   again[k].positions(0) == (int64_t)(10 * k) && again[k].positions(9) == (int64_t)(10 * k + 9);
+        }
+        EXPECT(same, "resent batches keep their positions");
+        EXPECT(append_n(pc.address(l), 1, 0) == 30, "resent batches were not appended again");
+
+        Producer p({pc.address((l + 1) % 3)}, 22);
+        p.linger_ms = 1;
+        p.batch_records = 16;
+        std::vector<std::future<Producer::Result>> futs;
+        for (int i = 0; i < 200; ++i) futs.push_back(p.append("p-" + std::to_string(i)));
+        p.flush();
+        bool ordered = true;
+        for (int i = 0; i < 200; ++i) {
+            Producer::Result r = futs[i].get();
+            ordered = ordered && r.ok && r.pos == 31 + i;
+        }
+        EXPECT(ordered, "producer records ordered densely in append order");
+
+        futs.clear();
+        for (int i = 0; i < 300; ++i) {
+            futs.push_back(p.append("q-" + std::to_string(i)));
+            if (i == 100) pc.Kill(l);
+        }
+        p.flush();
+        int64_t prev = -1;
+        int failed = 0;
+        bool increasing = true;
+        for (auto &f : futs) {
+            Producer::Result r = f.get();
+            if (!r.ok) {
+                failed++;
+                continue;
+            }
+            increasing = increasing && r.pos > prev;
+            prev = r.pos;
+        }
+        EXPECT(failed == 0, "producer appends survive the failover");
+        EXPECT(increasing, "producer order kept across the failover");
+        int nl = pc.WaitForLeader(5000);
+        EXPECT(nl >= 0 && append_n(pc.address(nl), 1, 1) == prev + 1, "nothing ordered after the last record");
+        p.close();
+        EXPECT(!p.append("late").get().ok, "append after close fails");
+    }
+
+    // 15) replication deadlines: an append stuck on a stalled follower
+    // fails after repl_timeout_ms, or with the client's deadline (also a
+    // stream's) if that is sooner, instead of hanging, and its retry is
+    // ordered once, at the gp it was appended with; with hedging on,
+    // appends are no slower while the followers answer in time, and
+    // appends through a slow follower still replicate in order
+    {
+        ServerConfig rt_cfg = base;
+        // stalls shorter than the lease, so the leader keeps it
+        rt_cfg.repl_timeout_ms = 150;
+        rt_cfg.repl_hedge = true;
+        LocalCluster rc(3, rt_cfg);
+        int l = rc.Start() ? rc.WaitForFollowers(5000) : -1;
+        EXPECT(l >= 0, "deadline cluster up");
+        if (l < 0) return 1;
+        int f = (l + 1) % 3;
+        Sequencer &leader = rc.server(l)->sequencer();
+        auto stub = sequencer::SequencerService::NewStub(
+            grpc::CreateChannel(rc.address(l), grpc::InsecureChannelCredentials()));
+        // one append with the given client deadline; returns its latency in ms
+        auto timed_append = [&](int req_id, int deadline_ms, grpc::Status *st,
+                                 sequencer::AppendReply *reply) {
+            sequencer::AppendRequest req;
+            req.set_client_id(31);
+            req.set_req_id(req_id);
+            req.set_record("dl-" + std::to_string(req_id));
+            grpc::ClientContext ctx;
+            ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(deadline_ms));
+            auto t0 = std::chrono::steady_clock::now();
+            *st = stub->Append(&ctx, req, reply);
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - t0).count();
+        };
+        EXPECT(append_n(rc.address(l), 10, 0) == 0, "appends before the stall");
+
+        grpc::Status st;
+        sequencer::AppendReply reply;
+        int64_t before = leader.metrics.replicate_us.snapshot().count();
+        rc.Pause(f);
+        timed_append(100, 50, &st, &reply);
+        EXPECT(st.error_code() == grpc::StatusCode::DEADLINE_EXCEEDED, "client deadline passes");
+        auto wait_until = std::chrono::steady_clock::now() + std::chrono::milliseconds(1000);
+        while (leader.metrics.replicate_us.snapshot().count() == before &&
+               std::chrono::steady_clock::now() < wait_until) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        HdrHistogram repl = leader.metrics.replicate_us.snapshot();
+        EXPECT(repl.count() > before && repl.max() < 120000,
+               "leader stops replicating at the client's deadline");
+        rc.Resume(f);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));   // lease renewed
+
+        // the same for a batch on a stream with a deadline
+        before = leader.metrics.replicate_us.snapshot().count();
+        rc.Pause(f);
+        {
+            grpc::ClientContext ctx;
+            ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(50));
+            auto s = stub->AppendStream(&ctx);
+            sequencer::AppendBatch batch;
+            batch.set_client_id(32);
+            batch.set_first_req_id(0);
+            batch.add_records("dl-stream");
+            sequencer::AppendBatchReply batch_reply;
+            s->Write(batch);
+            s->Read(&batch_reply);
+            EXPECT(s->Finish().error_code() == grpc::StatusCode::DEADLINE_EXCEEDED,
+                   "stream deadline passes");
+        }
+        wait_until = std::chrono::steady_clock::now() + std::chrono::milliseconds(1000);
+        while (leader.metrics.replicate_us.snapshot().count() == before &&
+               std::chrono::steady_clock::now() < wait_until) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        repl = leader.metrics.replicate_us.snapshot();
+        EXPECT(repl.count() > before && repl.max() < 120000,
+               "leader stops replicating a stream batch at the stream's deadline");
+        rc.Resume(f);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));   // lease renewed
+
+        rc.Pause(f);
+        int64_t ms = timed_append(101, 5000, &st, &reply);
+        EXPECT(st.ok() && !reply.success() && reply.status() == sequencer::APPEND_REPLICATION_FAILED && ms < 1000,
+               "append on a stalled follower fails after repl_timeout_ms");
+        rc.Resume(f);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));   // lease renewed
+
+        // its retry is ordered once, at the gp the failed append had
+        timed_append(101, 2000, &st, &reply);
+        EXPECT(st.ok() && reply.success(), "retry of the failed append");
+        auto copies = [&](int i, int64_t *gp) {
+            Sequencer &seq = rc.server(i)->sequencer();
+            std::lock_guard<std::mutex> lk(seq.mtx);
+            int n = 0;
+            for (int64_t li = seq.state.log.first_index(); li <= seq.state.log.last_index(); ++li) {
+                const SequencerLog::Entry &e = seq.state.log.get((int)li);
+                if (e.client_id == 31 && e.req_id == 101) {
+                    n++;
+                    *gp = e.global_pos;
+                }
+            }
+            return n;
+        };
+        for (int i = 0; i < 3; ++i) {
+            int64_t gp = -1;
+            auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(1000);
+            while (copies(i, &gp) == 0 && std::chrono::steady_clock::now() < until) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            EXPECT(copies(i, &gp) == 1 && gp == reply.global_pos(),
+                   "replica " << i << " holds the retried append once");
+        }
+        // the appends that gave up at the client's deadline were never
+        // retried; they are ordered once every follower holds them
+        int64_t abandoned_pos;
+        EXPECT(leader.find_duplicate(0, 31, 100, &abandoned_pos) &&
+                   leader.find_duplicate(0, 32, 0, &abandoned_pos),
+               "abandoned appends ordered after the followers caught up");
+
+        EXPECT(append_n(rc.address(l), 1100, 200) >= 0, "appends after the stalls");
+        // with the round-trip windows full, hedging must not slow appends
+        // the followers answer in time (rounds alternate, so load on the
+        // machine hits both alike)
+        HdrHistogram hedged, plain;
+        for (int round = 0; round < 8; ++round) {
+            bool on = round % 2 == 0;
+            leader.set_repl_hedge(on);
+            for (int i = 0; i < 50; ++i) {
+                auto t0 = std::chrono::steady_clock::now();
+                timed_append(3000 + round * 50 + i, 2000, &st, &reply);
+                (on ? hedged : plain).record(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - t0).count());
+            }
+        }
+        leader.set_repl_hedge(true);
+        int64_t hedged_us = hedged.value_at_percentile(50), plain_us = plain.value_at_percentile(50);
+        std::cout << "[TEST] append p50 hedge on " << hedged_us << "us, off " << plain_us << "us\n";
+        EXPECT(hedged_us < plain_us * 2 + 200, "hedging keeps append latency");
+        rc.Delay(f, 20);
+        int64_t first = append_n(rc.address(l), 10, 2000);
+        rc.Delay(f, 0);
+        EXPECT(first >= 0, "hedged appends through a slow follower");
+        EXPECT(wait_stats(rc.address(f), 0, 5000, [&](const sequencer::StatsReply &s) {
+                   return s.log().next_pos() == first + 10;
+               }), "slow follower holds the hedged entries");
+    }
+
+    // 16) admission control: while a stalled follower holds appends in
+    // flight, one past the limit is refused with RESOURCE_EXHAUSTED and a
+    // retry-after hint, and LazylogClient and Producer wait refusals out
+    // and get through once the follower is back
+    {
+        ServerConfig ac_cfg = base;
+        ac_cfg.max_inflight_entries = 2;
+        ac_cfg.admission_wait_ms = 0;
+        LocalCluster ac(3, ac_cfg);
+        int l = ac.Start() ? ac.WaitForFollowers(5000) : -1;
+        EXPECT(l >= 0, "admission cluster up");
+        if (l < 0) return 1;
+        int f = (l + 1) % 3;
+        EXPECT(append_n(ac.address(l), 10, 0) == 0, "appends under the limit");
+
+        // stalls stay well inside the lease
+        ac.Pause(f);
+        std::vector<std::thread> holders;
+        for (int i = 0; i < 2; ++i) holders.emplace_back([&, i] { append_n(ac.address(l), 1, 10 + i); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        auto stub = sequencer::SequencerService::NewStub(
+            grpc::CreateChannel(ac.address(l), grpc::InsecureChannelCredentials()));
+        sequencer::AppendRequest req;
+        req.set_client_id(41);
+        req.set_req_id(0);
+        req.set_record("over");
+        sequencer::AppendReply reply;
+        grpc::ClientContext ctx;
+        ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+        grpc::Status st = stub->Append(&ctx, req, &reply);
+        EXPECT(st.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED && retry_after_hint(ctx) > 0,
+               "append past the limit refused with a retry-after hint");
+        LazylogClient c({ac.address(l)});
+        LazylogClient::Result r;
+        std::thread client([&] { r = c.Append(req); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(80));
+        ac.Resume(f);
+        for (auto &t : holders) t.join();
+        client.join();
+        EXPECT(r.ok && r.throttled >= 1, "client gets through after waiting out refusals");
+        int64_t rejects = get_stats(ac.address(l)).overload_rejects_total();
+        EXPECT(rejects >= 2, "refusals counted");
+
+        // batches of 4 only fit with nothing else in flight
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));   // lease renewed
+        Producer p1({ac.address(l)}, 43), p2({ac.address(l)}, 44);
+        std::vector<std::future<Producer::Result>> f1, f2;
+        ac.Pause(f);
+        for (Producer *p : {&p1, &p2}) {
+            p->linger_ms = 1;
+            p->batch_records = 4;
+        }
+        for (int i = 0; i < 20; ++i) {
+            f1.push_back(p1.append("p1-" + std::to_string(i)));
+            f2.push_back(p2.append("p2-" + std::to_string(i)));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(80));
+        ac.Resume(f);
+        p1.flush();
+        p2.flush();
+        auto in_order = [](std::vector<std::future<Producer::Result>> &futs) {
+            int64_t prev = -1;
+            for (auto &fut : futs) {
+                Producer::Result res = fut.get();
+                if (!res.ok || res.pos <= prev) return false;
+                prev = res.pos;
+            }
+            return true;
+        };
+        EXPECT(in_order(f1) && in_order(f2), "producers get through in order despite refusals");
+        sequencer::StatsReply stats = get_stats(ac.address(l));
+        EXPECT(stats.overload_rejects_total() > rejects, "a producer batch was refused");
+        EXPECT(stats.inflight_entries() == 0 && stats.inflight_bytes() == 0, "nothing left in flight");
+    }
+
+    // 17) client quotas: a client past its burst is refused with a
+    // retry-after hint while other clients go on, duplicates and appends
+    // refused by admission control spend no tokens, and in the shm drain a
+    // throttled producer's records wait in its ring without holding up
+    // another producer's
+    {
+        ServerConfig q_cfg = base;
+        q_cfg.client_burst_ms = 500;
+        q_cfg.client_quotas = "51:20:0,52:20:0,53:20:0,61:100:0";
+        q_cfg.max_inflight_entries = 1;
+        q_cfg.admission_wait_ms = 0;
+        q_cfg.shm_name = "lazylog-quota-" + std::to_string(getpid());
+        q_cfg.shm_rings = 2;
+        q_cfg.shm_ring_bytes = 1 << 16;
+        LocalCluster qc(3, q_cfg);
+        int l = qc.Start() ? qc.WaitForFollowers(5000) : -1;
+        EXPECT(l >= 0, "quota cluster up");
+        if (l < 0) return 1;
+
+        auto stub = sequencer::SequencerService::NewStub(
+            grpc::CreateChannel(qc.address(l), grpc::InsecureChannelCredentials()));
+        sequencer::AppendRequest req;
+        req.set_client_id(51);
+        req.set_record("q");
+        int ok = 0, refused = 0;
+        int64_t hint = 0;
+        for (int i = 0; i < 15; ++i) {
+            req.set_req_id(i);
+            sequencer::AppendReply reply;
+            grpc::ClientContext ctx;
+            ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+            grpc::Status st = stub->Append(&ctx, req, &reply);
+            if (st.ok() && reply.success()) {
+                ok++;
+            } else if (st.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED) {
+                refused++;
+                hint = retry_after_hint(ctx);
+            }
+        }
+        // a burst of 10 records, plus what refills during the loop
+        EXPECT(ok >= 10 && ok < 15 && ok + refused == 15 && hint > 0,
+               "client past its burst refused with a retry-after hint");
+        EXPECT(append_n(qc.address(l), 50, 0) >= 0, "a client without a quota is not slowed");
+        // empty the bucket again, whatever refilled meanwhile
+        for (int i = 15; i < 45; ++i) {
+            req.set_req_id(i);
+            sequencer::AppendReply reply;
+            grpc::ClientContext ctx;
+            ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+            if (stub->Append(&ctx, req, &reply).error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED) break;
+        }
+        LazylogClient c({qc.address(l)});
+        req.set_req_id(100);
+        LazylogClient::Result r = c.Append(req);
+        EXPECT(r.ok && r.throttled >= 1, "throttled client gets through after the hint");
+        sequencer::StatsReply stats = get_stats(qc.address(l));
+        EXPECT(stats.quota_rejects_total() >= refused && stats.quota_clients() >= 2, "quota stats");
+
+        // client 52 resends a batch of its whole burst on a stream: the
+        // copies are answered as duplicates and cost nothing
+        {
+            grpc::ClientContext ctx;
+            auto s = stub->AppendStream(&ctx);
+            sequencer::AppendBatch batch;
+            batch.set_client_id(52);
+            batch.set_first_req_id(0);
+            for (int i = 0; i < 10; ++i) batch.add_records("d");
+            bool all_ok = true;
+            for (int round = 0; round < 4; ++round) {
+                sequencer::AppendBatchReply reply;
+                all_ok = all_ok && s->Write(batch) && s->Read(&reply) && reply.success();
+            }
+            s->WritesDone();
+            EXPECT(all_ok && s->Finish().ok(), "resent batches are duplicates, not over quota");
+        }
+
+        // client 53 is refused by admission while a stalled follower holds
+        // another append in flight, then still has its whole burst
+        int f = (l + 1) % 3;
+        qc.Pause(f);
+        std::thread held([&] { append_n(qc.address(l), 1, 1000); });
+        EXPECT(wait_stats(qc.address(l), 0, 1000, [](const sequencer::StatsReply &s) {
+                   return s.inflight_entries() == 1;
+               }), "an append held in flight");
+        req.set_client_id(53);
+        int overloaded = 0;
+        for (int i = 0; i < 12; ++i) {
+            req.set_req_id(i);
+            sequencer::AppendReply reply;
+            grpc::ClientContext ctx;
+            ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+            grpc::Status st = stub->Append(&ctx, req, &reply);
+            overloaded += st.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED &&
+                          st.error_message() == "Too many appends in flight";
+        }
+        qc.Resume(f);
+        held.join();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));   // lease renewed
+        int admitted = 0;
+        for (int i = 0; i < 10; ++i) {
+            req.set_req_id(i);
+            sequencer::AppendReply reply;
+            grpc::ClientContext ctx;
+            ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+            admitted += stub->Append(&ctx, req, &reply).ok() && reply.success();
+        }
+        EXPECT(overloaded == 12 && admitted == 10, "appends refused by admission spend no tokens");
+
+        // client 61 may burst 50 records, then 100/s
+        ShmProducer noisy, quiet;
+        EXPECT(noisy.attach(q_cfg.shm_name + "-" + std::to_string(l)) &&
+                   quiet.attach(q_cfg.shm_name + "-" + std::to_string(l)),
+               "producers attach");
+        const int N = 150;
+        for (int i = 0; i < N; ++i) noisy.try_append(61, i, "noisy", 5);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        for (int i = 0; i < 10; ++i) quiet.try_append(62, i, "quiet", 5);
+        std::vector<ShmProducer::Ack> noisy_acks, quiet_acks;
+        auto collect = [](ShmProducer &p, std::vector<ShmProducer::Ack> &acks) {
+            ShmProducer::Ack a[64];
+            size_t n = p.poll(a, 64);
+            acks.insert(acks.end(), a, a + n);
+        };
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (quiet_acks.size() < 10 && std::chrono::steady_clock::now() < deadline) collect(quiet, quiet_acks);
+        collect(noisy, noisy_acks);
+        EXPECT(quiet_acks.size() == 10 && noisy_acks.size() < (size_t)N,
+               "quiet producer answered while the noisy one is throttled");
+        deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (noisy_acks.size() < (size_t)N && std::chrono::steady_clock::now() < deadline) {
+            collect(noisy, noisy_acks);
+        }
+        bool in_order = noisy_acks.size() == (size_t)N;
+        for (int i = 0; in_order && i < N; ++i) {
+            in_order = noisy_acks[i].status == shm_ring::OK && noisy_acks[i].req_id == i &&
+                       (i == 0 || noisy_acks[i].pos > noisy_acks[i - 1].pos);
+        }
+        EXPECT(in_order, "throttled shm records ordered once their tokens came");
+    }
+
+    std::cout << "[TEST] " << (g_failures ? "FAILED" : "passed") << " (" << g_failures
+              << " failures)\n";
+    return g_failures ? 1 : 0;
+}
@@ -16,29 +16,57 @@
 #include <string>
 
 int main(int argc, char** argv) {
-    std::string role = "leader";
-    int port = 50051;
-    std::vector<std::string> followers;
+    ServerConfig cfg;
 
     for (int i=1; i<argc; i++){
         std::string a = argv[i];
-        if (a.rfind("--role=",0)==0) role = a.substr(7);
-        if (a.rfind("--port=",0)==0) port = std::stoi(a.substr(7));
+        if (a.rfind("--role=",0)==0) cfg.role = a.substr(7);
+        if (a.rfind("--port=",0)==0) cfg.port = std::stoi(a.substr(7));
         if (a.rfind("--followers=",0)==0) {
             std::string followers_arg = a.substr(12);
             // parse followers into vector
             size_t start = 0, end;
             while ((end = followers_arg.find(',', start)) != std::string::npos) {
-                followers.push_back(followers_arg.substr(start, end-start));
+                cfg.followers.push_back(followers_arg.substr(start, end-start));
                 start = end+1;
             }
             if (start < followers_arg.size())
-                followers.push_back(followers_arg.substr(start));
+                cfg.followers.push_back(followers_arg.substr(start));
         }
+        if (a.rfind("--zk=",0)==0) cfg.zk_addr = a.substr(5);
+        if (a.rfind("--zk_session_timeout_ms=",0)==0) cfg.zk_session_timeout_ms = std::stoi(a.substr(24));
+        if (a.rfind("--heartbeat_ms=",0)==0) cfg.heartbeat_ms = std::stoi(a.substr(15));
+        if (a.rfind("--lease_ms=",0)==0) cfg.lease_ms = std::stoi(a.substr(11));
+        if (a.rfind("--view_change_timeout_ms=",0)==0) cfg.view_change_timeout_ms = std::stoi(a.substr(25));
+        if (a.rfind("--gc_interval_ms=",0)==0) cfg.gc_interval_ms = std::stoi(a.substr(17));
+        if (a.rfind("--gc_step_entries=",0)==0) cfg.gc_step_entries = std::stoi(a.substr(18));
+        if (a.rfind("--gc_retain_entries=",0)==0) cfg.gc_retain_entries = std::stoi(a.substr(20));
+        if (a.rfind("--checkpoint_dir=",0)==0) cfg.checkpoint_dir = a.substr(17);
+        if (a.rfind("--checkpoint_interval_ms=",0)==0) cfg.checkpoint_interval_ms = std::stoi(a.substr(25));
+        if (a.rfind("--uds=",0)==0) cfg.uds = a.substr(6);
+        if (a.rfind("--shm_name=",0)==0) cfg.shm_name = a.substr(11);
+        if (a.rfind("--shm_rings=",0)==0) cfg.shm_rings = std::stoi(a.substr(12));
+        if (a.rfind("--shm_ring_bytes=",0)==0) cfg.shm_ring_bytes = std::stoi(a.substr(17));
+        if (a.rfind("--max_logs=",0)==0) cfg.max_logs = std::stoi(a.substr(11));
+        if (a.rfind("--max_inflight_entries=",0)==0) cfg.max_inflight_entries = std::stoll(a.substr(23));
+        if (a.rfind("--max_inflight_bytes=",0)==0) cfg.max_inflight_bytes = std::stoll(a.substr(21));
+        if (a.rfind("--admission_wait_ms=",0)==0) cfg.admission_wait_ms = std::stoi(a.substr(20));
+        if (a.rfind("--client_records_per_s=",0)==0) cfg.client_records_per_s = std::stoll(a.substr(23));
+        if (a.rfind("--client_bytes_per_s=",0)==0) cfg.client_bytes_per_s = std::stoll(a.substr(21));
+        if (a.rfind("--client_burst_ms=",0)==0) cfg.client_burst_ms = std::stoi(a.substr(18));
+        if (a.rfind("--client_quotas=",0)==0) cfg.client_quotas = a.substr(16);
+        if (a.rfind("--quota_slots=",0)==0) cfg.quota_slots = std::stoi(a.substr(14));
+        if (a.rfind("--repl_transport=",0)==0) cfg.repl_transport = a.substr(17);
+        if (a.rfind("--repl_tcp_port=",0)==0) cfg.repl_tcp_port = std::stoi(a.substr(16));
+        if (a.rfind("--repl_tcp_timeout_ms=",0)==0) cfg.repl_tcp_timeout_ms = std::stoi(a.substr(22));
+        if (a.rfind("--repl_timeout_ms=",0)==0) cfg.repl_timeout_ms = std::stoi(a.substr(18));
+        if (a.rfind("--repl_hedge=",0)==0) cfg.repl_hedge = std::stoi(a.substr(13)) != 0;
+        if (a.rfind("--trace_sample=",0)==0) cfg.trace_sample = std::stoi(a.substr(15));
+        if (a.rfind("--trace_dir=",0)==0) cfg.trace_dir = a.substr(12);
     }
 
     SequencerServer server;
-    server.Run(role, port, followers);
+    server.Run(cfg);
 
     return 0;
 }
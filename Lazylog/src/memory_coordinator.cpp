@@ -0,0 +1,209 @@
+#include "memory_coordinator.h"
+#include <cstdio>
+
+std::shared_ptr<InMemoryEnsemble> InMemoryEnsemble::create() {
+    return std::shared_ptr<InMemoryEnsemble>(new InMemoryEnsemble());
+}
+
+InMemoryEnsemble::InMemoryEnsemble() {
+    nodes_["/"] = Node();
+    dispatcher_ = std::thread([this] { dispatch_loop(); });
+}
+
+InMemoryEnsemble::~InMemoryEnsemble() {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        stop_ = true;
+    }
+    events_cv_.notify_all();
+    dispatcher_.join();
+}
+
+std::unique_ptr<Coordinator> InMemoryEnsemble::connect() {
+    int64_t id;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        id = next_session_++;
+    }
+    return std::unique_ptr<Coordinator>(new InMemoryCoordinator(shared_from_this(), id));
+}
+
+void InMemoryEnsemble::dispatch_loop() {
+    for (;;) {
+        Event ev;
+        {
+            std::unique_lock<std::mutex> lk(mu_);
+            events_cv_.wait(lk, [&] { return stop_ || !events_.empty(); });
+            if (stop_) return;
+            ev = std::move(events_.front());
+            events_.pop_front();
+        }
+        std::lock_guard<std::mutex> dk(dispatch_mu_);
+        {
+            // a closed session gets no more callbacks, even ones already queued
+            std::lock_guard<std::mutex> lk(mu_);
+            if (closed_.count(ev.session)) continue;
+        }
+        if (ev.expired_fn) ev.expired_fn();
+        if (ev.fn) ev.fn(ev.type, ev.path);
+    }
+}
+
+std::string InMemoryEnsemble::parent_of(const std::string &path) {
+    size_t slash = path.find_last_of('/');
+    return slash == 0 || slash == std::string::npos ? "/" : path.substr(0, slash);
+}
+
+bool InMemoryEnsemble::has_children_locked(const std::string &path) {
+    std::string prefix = path == "/" ? "/" : path + "/";
+    auto it = nodes_.upper_bound(prefix);
+    if (path == "/") return it != nodes_.end();
+    return it != nodes_.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+}
+
+void InMemoryEnsemble::fire_locked(std::map<std::string, std::vector<Watch>> &table,
+                                   const std::string &path, CoordEvent type) {
+    auto it = table.find(path);
+    if (it == table.end()) return;
+    for (auto &w : it->second) events_.push_back({w.session, std::move(w.fn), nullptr, type, path});
+    table.erase(it);
+    events_cv_.notify_one();
+}
+
+void InMemoryEnsemble::delete_node_locked(const std::string &path) {
+    nodes_.erase(path);
+    fire_locked(exists_watches_, path, CoordEvent::DELETED);
+    fire_locked(child_watches_, path, CoordEvent::DELETED);
+    fire_locked(child_watches_, parent_of(path), CoordEvent::CHILD);
+}
+
+void InMemoryEnsemble::end_session(int64_t session, bool expired) {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (closed_.count(session) || (expired && expired_.count(session))) return;
+        if (expired) expired_.insert(session);
+        else closed_.insert(session);
+
+        std::vector<std::string> owned;
+        for (auto &kv : nodes_)
+            if (kv.second.owner == session) owned.push_back(kv.first);
+        for (auto &p : owned) delete_node_locked(p);
+
+        // the session's own watches: dropped on close, told about expiry
+        for (auto *table : {&exists_watches_, &child_watches_}) {
+            for (auto it = table->begin(); it != table->end();) {
+                auto &ws = it->second;
+                for (auto w = ws.begin(); w != ws.end();) {
+                    if (w->session != session) {
+                        ++w;
+                        continue;
+                    }
+                    if (expired)
+                        events_.push_back({session, std::move(w->fn), nullptr,
+                                           CoordEvent::SESSION_EXPIRED, it->first});
+                    w = ws.erase(w);
+                }
+                it = ws.empty() ? table->erase(it) : std::next(it);
+            }
+        }
+        auto l = expiry_listeners_.find(session);
+        if (l != expiry_listeners_.end()) {
+            if (expired)
+                events_.push_back({session, nullptr, std::move(l->second),
+                                   CoordEvent::SESSION_EXPIRED, ""});
+            expiry_listeners_.erase(l);
+        }
+    }
+    events_cv_.notify_one();
+    // wait out a callback that may be running for this session right now
+    if (!expired) {
+        std::lock_guard<std::mutex> dk(dispatch_mu_);
+    }
+}
+
+void InMemoryEnsemble::expire(int64_t session) {
+    fprintf(stderr, "[ZK] expiring in-memory session %lld\n", (long long)session);
+    end_session(session, true);
+}
+
+bool InMemoryEnsemble::dead_locked(int64_t session) const {
+    return expired_.count(session) || closed_.count(session);
+}
+
+bool InMemoryEnsemble::session_expired(int64_t session) {
+    std::lock_guard<std::mutex> lk(mu_);
+    return dead_locked(session);
+}
+
+void InMemoryEnsemble::on_session_expired(int64_t session, std::function<void()> fn) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (dead_locked(session)) return;
+    expiry_listeners_[session] = std::move(fn);
+}
+
+CoordRc InMemoryEnsemble::create(int64_t session, const std::string &path, const std::string &data,
+                                 int flags, std::string *created_path) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (dead_locked(session)) return CoordRc::SESSION_EXPIRED;
+    if (path.empty() || path[0] != '/') return CoordRc::ERROR;
+    auto parent = nodes_.find(parent_of(path));
+    if (parent == nodes_.end()) return CoordRc::NO_NODE;
+    if (parent->second.owner != 0) return CoordRc::ERROR;   // ephemerals have no children
+
+    std::string name = path;
+    if (flags & Coordinator::SEQUENTIAL) {
+        char suffix[16];
+        snprintf(suffix, sizeof(suffix), "%010lld", (long long)parent->second.next_seq++);
+        name += suffix;
+    }
+    if (nodes_.count(name)) return CoordRc::NODE_EXISTS;
+    Node n;
+    n.data = data;
+    n.owner = (flags & Coordinator::EPHEMERAL) ? session : 0;
+    nodes_[name] = n;
+    if (created_path) *created_path = name;
+    fire_locked(exists_watches_, name, CoordEvent::CREATED);
+    fire_locked(child_watches_, parent_of(name), CoordEvent::CHILD);
+    return CoordRc::OK;
+}
+
+CoordRc InMemoryEnsemble::remove(int64_t session, const std::string &path) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (dead_locked(session)) return CoordRc::SESSION_EXPIRED;
+    if (!nodes_.count(path)) return CoordRc::NO_NODE;
+    if (has_children_locked(path)) return CoordRc::NOT_EMPTY;
+    delete_node_locked(path);
+    return CoordRc::OK;
+}
+
+CoordRc InMemoryEnsemble::get(int64_t session, const std::string &path, std::string *data) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (dead_locked(session)) return CoordRc::SESSION_EXPIRED;
+    auto it = nodes_.find(path);
+    if (it == nodes_.end()) return CoordRc::NO_NODE;
+    if (data) *data = it->second.data;
+    return CoordRc::OK;
+}
+
+CoordRc InMemoryEnsemble::exists(int64_t session, const std::string &path, CoordWatch watch) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (dead_locked(session)) return CoordRc::SESSION_EXPIRED;
+    if (watch) exists_watches_[path].push_back({session, std::move(watch)});
+    return nodes_.count(path) ? CoordRc::OK : CoordRc::NO_NODE;
+}
+
+CoordRc InMemoryEnsemble::children(int64_t session, const std::string &path,
+                                   std::vector<std::string> *out, CoordWatch watch) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (dead_locked(session)) return CoordRc::SESSION_EXPIRED;
+    if (!nodes_.count(path)) return CoordRc::NO_NODE;
+    std::string prefix = path == "/" ? "/" : path + "/";
+    out->clear();
+    for (auto it = nodes_.upper_bound(prefix); it != nodes_.end(); ++it) {
+        if (it->first.compare(0, prefix.size(), prefix) != 0) break;
+        std::string rest = it->first.substr(prefix.size());
+        if (rest.find('/') == std::string::npos) out->push_back(rest);
+    }
+    if (watch) child_watches_[path].push_back({session, std::move(watch)});
+    return CoordRc::OK;
+}
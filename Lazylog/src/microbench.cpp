@@ -0,0 +1,207 @@
+// Microbenchmarks for SequencerLog and Sequencer internals.
+//
+// Each case runs for every thread count x record size requested and prints
+// one line (and optionally one JSON object per line) with ns/op and ops/s,
+// so a change to the log's data structures can be compared against a
+// baseline run. Sequencer's per-entry logging is silenced while timing.
+//
+//   seq_microbench --threads=1,4,16,64 --sizes=16,4096,65536 --json=base.jsonl
+//   seq_microbench --filter=gc
+#include "sequencer.h"
+#include "sequencer_log.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchOptions {
+    std::vector<int> threads = {1, 2, 4, 8, 16, 32, 64};
+    std::vector<int> sizes = {16, 256, 4096, 65536};
+    int64_t ops = 200000;             // per case, capped by max_bytes / size
+    int64_t max_bytes = 256LL << 20;  // keeps 64 KB cases within memory
+    std::string filter;
+    std::string json_path;
+};
+
+struct Result {
+    std::string name;
+    int threads;
+    int size;
+    int64_t ops;
+    double seconds;
+};
+
+static std::vector<Result> g_results;
+
+static std::vector<int> parse_list(const std::string &s) {
+    std::vector<int> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) out.push_back(std::stoi(item));
+    return out;
+}
+
+// Run fn(thread_index, begin, end) on `threads` threads over [0, ops) and
+// return the wall time of the parallel section only.
+static double run_parallel(int threads, int64_t ops,
+                           const std::function<void(int, int64_t, int64_t)> &fn) {
+    std::vector<std::thread> ts;
+    std::mutex start_mu;
+    start_mu.lock();
+    for (int t = 0; t < threads; ++t) {
+        int64_t b = ops * t / threads, e = ops * (t + 1) / threads;
+        ts.emplace_back([&, t, b, e] {
+            { std::lock_guard<std::mutex> go(start_mu); }
+            fn(t, b, e);
+        });
+    }
+    Clock::time_point start = Clock::now();
+    start_mu.unlock();
+    for (auto &th : ts) th.join();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void report(const std::string &name, int threads, int size, int64_t ops, double secs) {
+    printf("%-28s threads=%-3d size=%-6d ops=%-8lld %10.1f ns/op %12.0f ops/s\n",
+           name.c_str(), threads, size, (long long)ops, secs * 1e9 / ops, ops / secs);
+    fflush(stdout);
+    g_results.push_back({name, threads, size, ops, secs});
+}
+
+static int64_t ops_for(const BenchOptions &o, int size) {
+    return std::max<int64_t>(1, std::min<int64_t>(o.ops, o.max_bytes / std::max(size, 1)));
+}
+
+// ---- SequencerLog (guarded by one mutex, as Sequencer does) ----
+
+static void bench_log_append(const BenchOptions &o, int threads, int size) {
+    SequencerLog log;
+    std::mutex mu;
+    std::string record(size, 'x');
+    int64_t ops = ops_for(o, size);
+    double secs = run_parallel(threads, ops, [&](int t, int64_t b, int64_t e) {
+        for (int64_t i = b; i < e; ++i) {
+            std::lock_guard<std::mutex> lk(mu);
+            log.append({t, (int)i, record});
+        }
+    });
+    report("log_append", threads, size, ops, secs);
+}
+
+static void bench_log_get(const BenchOptions &o, int threads, int size) {
+    SequencerLog log;
+    std::mutex mu;
+    int64_t n = ops_for(o, size);
+    for (int64_t i = 0; i < n; ++i) log.append({1, (int)i, std::string(size, 'x')});
+    double secs = run_parallel(threads, n, [&](int t, int64_t b, int64_t e) {
+        std::mt19937_64 rng(t + 1);
+        size_t sink = 0;
+        for (int64_t i = b; i < e; ++i) {
+            std::lock_guard<std::mutex> lk(mu);
+            sink += log.get((int)(rng() % n)).record.size();
+        }
+        if (sink == 42) printf(" ");
+    });
+    report("log_get", threads, size, n, secs);
+}
+
+// GC in chunks of 1024 entries from the front, until the log is empty
+static void bench_log_gc(const BenchOptions &o, int size) {
+    SequencerLog log;
+    int64_t n = ops_for(o, size);
+    for (int64_t i = 0; i < n; ++i) log.append({1, (int)i, std::string(size, 'x')});
+    Clock::time_point start = Clock::now();
+    for (int64_t upto = 1023; ; upto += 1024) {
+        log.gc_up_to((int)std::min(upto, n - 1));
+        if (upto >= n - 1) break;
+    }
+    report("log_gc_up_to", 1, size, n, std::chrono::duration<double>(Clock::now() - start).count());
+}
+
+// ---- Sequencer ----
+
+static void bench_assign_global_pos(const BenchOptions &o, int threads, int size) {
+    Sequencer seq;
+    int64_t n = ops_for(o, size);
+    std::string record(size, 'x');
+    for (int64_t i = 0; i < n; ++i) seq.append_local_entry(1, (int)i, record);
+    double secs = run_parallel(threads, n, [&](int, int64_t b, int64_t e) {
+        for (int64_t i = b; i < e; ++i) seq.assign_global_pos((int)i);
+    });
+    report("seq_assign_global_pos", threads, size, n, secs);
+}
+
+// gc_up_to against a large local_to_gp map, advancing in steps of 1024 gps
+static void bench_seq_gc(const BenchOptions &o, int size) {
+    Sequencer seq;
+    int64_t n = ops_for(o, size);
+    std::string record(size, 'x');
+    for (int64_t i = 0; i < n; ++i) {
+        int li = seq.append_local_entry(1, (int)i, record);
+        seq.assign_global_pos(li);
+    }
+    int calls = 0;
+    Clock::time_point start = Clock::now();
+    for (int64_t gp = 1023; ; gp += 1024) {
+        seq.gc_up_to((int)std::min(gp, n - 1));
+        calls++;
+        if (gp >= n - 1) break;
+    }
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    report("seq_gc_up_to(entries)", 1, size, n, secs);
+    report("seq_gc_up_to(calls)", 1, size, calls, secs);
+}
+
+int main(int argc, char **argv) {
+    BenchOptions o;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a.rfind("--threads=", 0) == 0) o.threads = parse_list(a.substr(10));
+        else if (a.rfind("--sizes=", 0) == 0) o.sizes = parse_list(a.substr(8));
+        else if (a.rfind("--ops=", 0) == 0) o.ops = std::stoll(a.substr(6));
+        else if (a.rfind("--filter=", 0) == 0) o.filter = a.substr(9);
+        else if (a.rfind("--json=", 0) == 0) o.json_path = a.substr(7);
+        else {
+            std::cerr << "unknown flag " << a << "\n";
+            return 2;
+        }
+    }
+    auto want = [&](const std::string &name) {
+        return o.filter.empty() || name.find(o.filter) != std::string::npos;
+    };
+
+    // Sequencer logs every append/order/GC on std::cout; drop it while timing
+    std::streambuf *saved = std::cout.rdbuf(nullptr);
+
+    for (int size : o.sizes) {
+        for (int t : o.threads) {
+            if (want("log_append")) bench_log_append(o, t, size);
+            if (want("log_get")) bench_log_get(o, t, size);
+            if (want("assign_global_pos")) bench_assign_global_pos(o, t, size);
+        }
+        if (want("log_gc")) bench_log_gc(o, size);
+        if (want("seq_gc")) bench_seq_gc(o, size);
+    }
+
+    std::cout.rdbuf(saved);
+    std::cout.clear();
+
+    if (!o.json_path.empty()) {
+        std::ofstream f(o.json_path);
+        for (const auto &r : g_results) {
+            f << "{\"name\":\"" << r.name << "\",\"threads\":" << r.threads << ",\"size\":" << r.size
+              << ",\"ops\":" << r.ops << ",\"seconds\":" << r.seconds
+              << ",\"ns_per_op\":" << r.seconds * 1e9 / r.ops << "}\n";
+        }
+    }
+    return 0;
+}
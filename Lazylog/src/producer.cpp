@@ -0,0 +1,225 @@
+#include "producer.h"
+#include <algorithm>
+
+Producer::Producer(std::vector<std::string> seeds, int client_id, uint64_t log_id, Coordinator *coord)
+    : router_(std::move(seeds), coord), client_id_(client_id), log_id_(log_id) {}
+
+Producer::~Producer() { close(); }
+
+std::future<Producer::Result> Producer::append(std::string record) {
+    std::unique_lock<std::mutex> lk(mu_);
+    answered_.wait(lk, [&] { return buffered_ < max_buffered || closing_; });
+    if (closing_ || closed_) {
+        std::promise<Result> p;
+        p.set_value(Result{false, -1, "Producer is closed"});
+        return p.get_future();
+    }
+    if (!started_) {
+        started_ = true;
+        sender_ = std::thread([this] { run(); });
+    }
+    if (open_.done.empty()) {
+        open_.created = Clock::now();
+        open_.msg.set_client_id(client_id_);
+        open_.msg.set_log_id(log_id_);
+        open_.msg.set_first_req_id(next_req_id);
+    }
+    next_req_id++;
+    open_.bytes += record.size();
+    open_.msg.add_records(std::move(record));
+    open_.done.emplace_back();
+    std::future<Result> f = open_.done.back().get_future();
+    buffered_++;
+    if (open_.done.size() >= batch_records || open_.bytes >= batch_bytes) {
+        seal_locked();
+    } else if (open_.done.size() == 1) {
+        cv_.notify_all();   // start the linger clock
+    }
+    return f;
+}
+
+void Producer::flush() {
+    std::unique_lock<std::mutex> lk(mu_);
+    seal_locked();
+    answered_.wait(lk, [&] { return buffered_ == 0; });
+}
+
+void Producer::close() {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (closed_) return;
+    }
+    flush();
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        closing_ = true;
+    }
+    cv_.notify_all();
+    answered_.notify_all();
+    if (sender_.joinable()) sender_.join();
+    std::lock_guard<std::mutex> lk(mu_);
+    closed_ = true;
+}
+
+void Producer::seal_locked() {
+    if (open_.done.empty()) return;
+    ready_.push_back(std::move(open_));
+    open_ = Batch();
+    cv_.notify_all();
+}
+
+void Producer::fail_locked(Batch &b, const std::string &why) {
+    for (auto &p : b.done) p.set_value(Result{false, -1, why});
+    buffered_ -= b.done.size();
+    answered_.notify_all();
+}
+
+void Producer::run() {
+    const auto linger = std::chrono::milliseconds(linger_ms);
+    const auto timeout = std::chrono::milliseconds(delivery_timeout_ms);
+    std::unique_lock<std::mutex> lk(mu_);
+    while (true) {
+        Clock::time_point now = Clock::now();
+        if (!open_.done.empty() && now >= open_.created + linger) seal_locked();
+        if (broken_) {
+            reset_stream(lk);
+            continue;
+        }
+        // a stream that stopped answering is dropped like a broken one
+        if (!in_flight_.empty() && now >= in_flight_.front().created + timeout) {
+            broken_ = true;
+            continue;
+        }
+        while (!ready_.empty() && now >= ready_.front().created + timeout) {
+            fail_locked(ready_.front(), "Timed out");
+            ready_.pop_front();
+        }
+
+        if (!ready_.empty() && (int)in_flight_.size() < max_in_flight) {
+            if (!stream_ && !open_stream(lk)) continue;
+            in_flight_.push_back(std::move(ready_.front()));
+            ready_.pop_front();
+            // only this thread writes, and a batch is not answered (and
+            // destroyed) before it was serialized and sent
+            const sequencer::AppendBatch &msg = in_flight_.back().msg;
+            Stream *stream = stream_.get();
+            lk.unlock();
+            bool ok = stream->Write(msg);
+            lk.lock();
+            if (!ok) broken_ = true;
+            continue;
+        }
+        if (closing_ && open_.done.empty() && ready_.empty() && in_flight_.empty()) break;
+
+        Clock::time_point wake = now + std::chrono::milliseconds(100);
+        if (!open_.done.empty()) wake = std::min(wake, open_.created + linger);
+        if (!in_flight_.empty()) wake = std::min(wake, in_flight_.front().created + timeout);
+        cv_.wait_until(lk, wake);
+    }
+    reset_stream(lk);
+}
+
+bool Producer::open_stream(std::unique_lock<std::mutex> &lk) {
+    std::string target = target_, failed = failed_;
+    lk.unlock();
+    // the coordinator lookup may take a round trip; not under mu_
+    if (target.empty()) target = router_.next_candidate(failed);
+    std::unique_ptr<sequencer::SequencerService::Stub> stub;
+    std::unique_ptr<grpc::ClientContext> ctx;
+    std::unique_ptr<Stream> stream;
+    if (!target.empty()) {
+        stub = sequencer::SequencerService::NewStub(
+            grpc::CreateChannel(target, grpc::InsecureChannelCredentials()));
+        ctx.reset(new grpc::ClientContext);
+        stream = stub->AppendStream(ctx.get());
+    }
+    lk.lock();
+    target_ = target;
+    if (!stream) {
+        cv_.wait_for(lk, std::chrono::milliseconds(backoff_ms));
+        return false;
+    }
+    stub_ = std::move(stub);
+    ctx_ = std::move(ctx);
+    stream_ = std::move(stream);
+    acked_on_stream_ = 0;
+    ended_ = false;
+    hint_.clear();
+    reader_ = std::thread([this, s = stream_.get()] { read_replies(s); });
+    return true;
+}
+
+void Producer::reset_stream(std::unique_lock<std::mutex> &lk) {
+    int64_t retry_after_ms = -1;   // >= 0: the leader refused for overload
+    if (stream_) {
+        std::unique_ptr<grpc::ClientContext> ctx = std::move(ctx_);
+        std::unique_ptr<Stream> stream = std::move(stream_);
+        std::thread reader = std::move(reader_);
+        bool ended = ended_;
+        lk.unlock();
+        // a stream the replica ended keeps its status (cancelling would
+        // replace it with CANCELLED)
+        if (!ended) ctx->TryCancel();
+        reader.join();
+        grpc::Status st = stream->Finish();
+        if (st.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED) retry_after_ms = retry_after_hint(*ctx);
+        lk.lock();
+    }
+    broken_ = false;
+    // unanswered batches go first, in the order they were sent
+    while (!in_flight_.empty()) {
+        ready_.push_front(std::move(in_flight_.back()));
+        in_flight_.pop_back();
+    }
+    if (closing_ && ready_.empty()) return;
+
+    if (retry_after_ms >= 0) {
+        // busy, not gone: back to the same replica once the hint passed
+        auto until = Clock::now() + std::chrono::milliseconds(retry_after_ms ? retry_after_ms : backoff_ms);
+        while (Clock::now() < until) cv_.wait_until(lk, until);
+        return;
+    }
+
+    // go where the last rejection pointed, else to the next candidate;
+    // pause first unless redirected or this stream got something through
+    bool redirected = !hint_.empty() && hint_ != target_;
+    bool progress = acked_on_stream_ > 0;
+    failed_ = target_;
+    target_ = hint_;   // a leader that refused for now names itself
+    hint_.clear();
+    if (!redirected && !progress) cv_.wait_for(lk, std::chrono::milliseconds(backoff_ms));
+}
+
+void Producer::read_replies(Stream *stream) {
+    sequencer::AppendBatchReply r;
+    bool ended = true;
+    while (stream->Read(&r)) {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (in_flight_.empty() || in_flight_.front().msg.first_req_id() != r.first_req_id()) {
+            ended = false;
+            break;
+        }
+        Batch b = std::move(in_flight_.front());
+        in_flight_.pop_front();
+        if (r.success() && r.positions_size() == (int)b.done.size()) {
+            for (size_t i = 0; i < b.done.size(); ++i) {
+                b.done[i].set_value(Result{true, r.positions((int)i), r.message()});
+            }
+            buffered_ -= b.done.size();
+            acked_on_stream_++;
+            answered_.notify_all();
+        } else if (r.status() == sequencer::APPEND_NOT_LEADER || r.status() == sequencer::APPEND_SEALED ||
+                   r.status() == sequencer::APPEND_LEASE_EXPIRED) {
+            // resent once the stream is replaced (the replica ends it)
+            hint_ = r.leader_addr();
+            in_flight_.push_front(std::move(b));
+        } else {
+            fail_locked(b, r.message());
+        }
+        cv_.notify_all();   // room for another batch in flight
+    }
+    std::lock_guard<std::mutex> lk(mu_);
+    broken_ = true;
+    ended_ = ended;
+    cv_.notify_all();
+}
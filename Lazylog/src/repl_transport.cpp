@@ -0,0 +1,370 @@
+#include "repl_transport.h"
+#include "sequencer.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <grpcpp/alarm.h>
+#include <grpcpp/grpcpp.h>
+#include "generated/sequencer_internal.grpc.pb.h"
+
+using sequencer_internal::ReplicateAppendRequest;
+using sequencer_internal::ReplicateAppendReply;
+
+static const char *const REPLICATE_APPEND_METHOD = "/sequencer_internal.SequencerInternal/ReplicateAppend";
+
+// attempts per follower, not counting hedges
+static const int MAX_ATTEMPTS = 5;
+static const int64_t BACKOFF_FIRST_US = 10 * 1000;
+static const int64_t BACKOFF_MAX_US = 200 * 1000;
+// first-attempt round trips per p99 estimate
+static const int64_t RTT_WINDOW = 1024;
+// bound when the caller gives none
+static const int64_t DEFAULT_DEADLINE_US = 1000 * 1000;
+
+static std::chrono::system_clock::time_point to_system(int64_t steady_us) {
+    return std::chrono::system_clock::now() + std::chrono::microseconds(steady_us - steady_now_us());
+}
+
+namespace {
+
+class GrpcReplicationCall : public ReplicationCall {
+public:
+    GrpcReplicationCall(GrpcReplicationTransport *transport,
+                        const GrpcReplicationTransport::StubFor &stub_for,
+                        const GrpcReplicationTransport::StubFor &spare_stub_for,
+                        const std::vector<std::string> &addrs, int64_t view)
+        : transport_(transport), stub_for_(stub_for), spare_stub_for_(spare_stub_for), view_(view),
+          req_(google::protobuf::Arena::CreateMessage<ReplicateAppendRequest>(&arena_)) {
+        for (const auto &addr : addrs) {
+            followers_.emplace_back();
+            followers_.back().ack.addr = addr;
+        }
+    }
+
+    // cancel what is still on the wire or pending; callbacks and alarms
+    // refer to this
+    ~GrpcReplicationCall() override {
+        std::vector<grpc::ClientContext *> running;
+        std::vector<grpc::Alarm *> pending;
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            stopping_ = true;
+            for (auto &f : followers_) {
+                for (auto &a : f.attempts) running.push_back(&a.ctx);
+                collect_timers_locked(f, &pending);
+            }
+        }
+        for (auto *ctx : running) ctx->TryCancel();
+        for (auto *alarm : pending) alarm->Cancel();
+        std::unique_lock<std::mutex> lk(mu_);
+        cv_.wait(lk, [&] { return outstanding_ == 0; });
+    }
+
+    // req_ holds every field but the record, which stays in the log entry
+    ReplicateAppendRequest *request() { return req_; }
+    void set_record(const std::string *record) { record_ = record; }
+
+    // serialized here, outside the sequencer lock, once for all followers;
+    // the first attempt goes to every follower at once
+    void send(int64_t deadline_us) override {
+        if (sent_) return;
+        sent_ = true;
+        deadline_us_ = deadline_us ? deadline_us : steady_now_us() + DEFAULT_DEADLINE_US;
+        serialize();
+        if (!serialize_status_.ok()) {
+            std::cerr << "[REPL] cannot serialize local_idx=" << req_->local_index() << ": "
+                      << serialize_status_.error_message() << "\n";
+            return;
+        }
+        unfinished_ = (int)followers_.size();
+        bool hedge = transport_->hedge.load();
+        for (size_t i = 0; i < followers_.size(); ++i) {
+            Follower &f = followers_[i];
+            f.ack.start_us = steady_now_us();
+            start_attempt(i, false);
+            int64_t after = hedge ? transport_->hedge_after_us(f.ack.addr) : 0;
+            if (after > 0 && f.ack.start_us + after < deadline_us_) {
+                arm(i, f.ack.start_us + after, [this, i] { on_hedge_timer(i); });
+            }
+        }
+    }
+
+    std::vector<ReplicateAck> wait() override {
+        send(0);
+        std::vector<ReplicateAck> acks;
+        if (!serialize_status_.ok()) {
+            for (auto &f : followers_) {
+                acks.push_back(f.ack);
+                acks.back().error = serialize_status_.error_message();
+            }
+            return acks;
+        }
+        std::unique_lock<std::mutex> lk(mu_);
+        cv_.wait(lk, [&] { return unfinished_ == 0 || fenced_ >= 0; });
+        if (fenced_ >= 0) {
+            // follower moved to a newer view: the caller steps down
+            acks.push_back(followers_[fenced_].ack);
+            return acks;
+        }
+        for (auto &f : followers_) {
+            acks.push_back(f.ack);
+            if (!f.ack.ok) {
+                std::cerr << "[REPL:" << f.ack.addr << "] " << f.ack.attempts << " attempts failed, last: "
+                          << f.ack.error << "\n";
+            }
+        }
+        return acks;
+    }
+
+private:
+    // the other fields, then the record field (3) as a slice over the
+    // entry's bytes; field order does not matter to the parser
+    void serialize() {
+        std::string head;
+        if (!req_->SerializeToString(&head)) {
+            serialize_status_ = grpc::Status(grpc::StatusCode::INTERNAL, "cannot serialize request");
+            return;
+        }
+        if (record_ == nullptr || record_->empty()) {
+            grpc::Slice slice(head);
+            payload_ = grpc::ByteBuffer(&slice, 1);
+            return;
+        }
+        using google::protobuf::io::CodedOutputStream;
+        uint8_t prefix[10];
+        uint8_t *end = CodedOutputStream::WriteTagToArray(
+            (ReplicateAppendRequest::kRecordFieldNumber << 3) | 2, prefix);
+        end = CodedOutputStream::WriteVarint32ToArray((uint32_t)record_->size(), end);
+        head.append(reinterpret_cast<const char *>(prefix), end - prefix);
+        grpc::Slice slices[2] = {
+            grpc::Slice(head),
+            grpc::Slice(record_->data(), record_->size(), grpc::Slice::STATIC_SLICE)};
+        payload_ = grpc::ByteBuffer(slices, 2);
+    }
+
+    struct Attempt {
+        grpc::ClientContext ctx;
+        grpc::ByteBuffer reply_buf;
+        int64_t start_us = 0;
+        bool hedge = false;
+    };
+    struct Timer {
+        grpc::Alarm alarm;
+        bool set = false;   // Cancel() only after Set()
+    };
+    struct Follower {
+        ReplicateAck ack;
+        std::deque<Attempt> attempts;   // ClientContext cannot move
+        std::deque<Timer> timers;
+        int running = 0;
+        bool done = false;
+        int64_t backoff_us = BACKOFF_FIRST_US;
+    };
+
+    void start_attempt(size_t i, bool hedge) {
+        Follower &f = followers_[i];
+        Attempt *a;
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            if (stopping_ || f.done) return;
+            f.attempts.emplace_back();
+            a = &f.attempts.back();
+            a->start_us = steady_now_us();
+            a->hedge = hedge;
+            a->ctx.set_deadline(to_system(deadline_us_));
+            f.running++;
+            outstanding_++;
+            f.ack.attempts++;
+            if (hedge) f.ack.hedges++;
+        }
+        // not under mu_: a call that fails at once may run its callback here
+        std::shared_ptr<grpc::GenericStub> stub = (hedge ? spare_stub_for_ : stub_for_)(f.ack.addr);
+        stub->UnaryCall(&a->ctx, REPLICATE_APPEND_METHOD, grpc::StubOptions(), &payload_, &a->reply_buf,
+                        [this, i, a](grpc::Status st) { on_reply(i, a, std::move(st)); });
+    }
+
+    void on_reply(size_t i, Attempt *a, grpc::Status st) {
+        ReplicateAppendReply reply;
+        if (st.ok()) st = grpc::SerializationTraits<ReplicateAppendReply>::Deserialize(&a->reply_buf, &reply);
+        int64_t now = steady_now_us();
+        Follower &f = followers_[i];
+        bool retry = false, sample = false, finished;
+        int64_t retry_at = 0;
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            f.running--;
+            if (!f.done && !stopping_) {
+                if (st.ok() && reply.ok()) {
+                    f.ack.ok = true;
+                    f.ack.view = reply.view();
+                    finish_locked(f, now);
+                    sample = !a->hedge && f.ack.attempts == 1;
+                } else if (st.ok() && reply.view() > view_) {
+                    f.ack.view = reply.view();
+                    f.ack.error = reply.message();
+                    fenced_ = (int)i;
+                    finish_locked(f, now);
+                } else {
+                    f.ack.view = reply.view();
+                    f.ack.error = st.ok() ? reply.message() : st.error_message();
+                    // a hedge still running may yet succeed
+                    if (f.running == 0) {
+                        if (f.ack.attempts - f.ack.hedges < MAX_ATTEMPTS &&
+                            now + f.backoff_us < deadline_us_) {
+                            retry = true;
+                            retry_at = now + f.backoff_us;
+                            f.backoff_us = std::min(f.backoff_us * 2, BACKOFF_MAX_US);
+                        } else {
+                            finish_locked(f, now);
+                        }
+                    }
+                }
+                finished = f.done;
+            } else {
+                finished = false;
+            }
+        }
+        // no attempt starts once f is done, so f.attempts stays put; the
+        // other attempt need not run to its deadline, nor a pending hedge
+        // to its time (the destructor waits for both)
+        if (finished) {
+            for (auto &other : f.attempts) {
+                if (&other != a) other.ctx.TryCancel();
+            }
+            std::vector<grpc::Alarm *> pending;
+            {
+                std::lock_guard<std::mutex> lk(mu_);
+                collect_timers_locked(f, &pending);
+            }
+            for (auto *alarm : pending) alarm->Cancel();
+        }
+        if (sample) transport_->note_round_trip(f.ack.addr, now - a->start_us);
+        if (retry) arm(i, retry_at, [this, i] { start_attempt(i, false); });
+        done_one();
+    }
+
+    // a hedge only while the first attempt is the one still running
+    void on_hedge_timer(size_t i) {
+        bool go;
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            Follower &f = followers_[i];
+            go = !f.done && f.running == 1 && f.ack.attempts == 1;
+        }
+        if (go) start_attempt(i, true);
+    }
+
+    // run fn at steady time at_us on a gRPC thread, unless follower i is
+    // done or the call stops first
+    void arm(size_t i, int64_t at_us, std::function<void()> fn) {
+        Follower &f = followers_[i];
+        Timer *t;
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            if (stopping_ || f.done) return;
+            f.timers.emplace_back();
+            t = &f.timers.back();
+            outstanding_++;
+        }
+        t->alarm.Set(to_system(at_us), [this, fn](bool fired) {
+            bool stopping;
+            {
+                std::lock_guard<std::mutex> lk(mu_);
+                stopping = stopping_;
+            }
+            if (fired && !stopping) fn();
+            done_one();
+        });
+        // whoever ended f meanwhile skipped this timer, not yet set
+        bool cancel;
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            t->set = true;
+            cancel = stopping_ || f.done;
+        }
+        if (cancel) t->alarm.Cancel();
+    }
+
+    // f's timers that may still be pending; Cancel() outside mu_, since a
+    // cancelled alarm's callback takes it
+    void collect_timers_locked(Follower &f, std::vector<grpc::Alarm *> *out) {
+        for (auto &t : f.timers) {
+            if (t.set) out->push_back(&t.alarm);
+        }
+    }
+
+    void finish_locked(Follower &f, int64_t now) {
+        f.done = true;
+        f.ack.done_us = now;
+        unfinished_--;
+        cv_.notify_all();
+    }
+
+    void done_one() {
+        std::lock_guard<std::mutex> lk(mu_);
+        outstanding_--;
+        cv_.notify_all();
+    }
+
+    GrpcReplicationTransport *transport_;
+    const GrpcReplicationTransport::StubFor &stub_for_;
+    const GrpcReplicationTransport::StubFor &spare_stub_for_;
+    int64_t view_;
+    google::protobuf::Arena arena_;
+    ReplicateAppendRequest *req_;
+    const std::string *record_ = nullptr;
+
+    bool sent_ = false;
+    int64_t deadline_us_ = 0;
+    grpc::Status serialize_status_;
+    grpc::ByteBuffer payload_;
+    std::deque<Follower> followers_;
+    std::mutex mu_;
+    std::condition_variable cv_;
+    int unfinished_ = 0;     // followers without a final answer
+    int outstanding_ = 0;    // RPCs and alarms whose callback has not run
+    int fenced_ = -1;        // follower that reported a newer view
+    bool stopping_ = false;
+};
+
+}  // namespace
+
+int64_t GrpcReplicationTransport::hedge_after_us(const std::string &addr) {
+    std::lock_guard<std::mutex> lk(rtt_mu_);
+    auto it = rtt_.find(addr);
+    return it == rtt_.end() ? 0 : it->second.p99_us;
+}
+
+void GrpcReplicationTransport::note_round_trip(const std::string &addr, int64_t us) {
+    std::lock_guard<std::mutex> lk(rtt_mu_);
+    RoundTrips &r = rtt_[addr];
+    r.window.record(us);
+    if (r.window.count() >= RTT_WINDOW) {
+        r.p99_us = r.window.value_at_percentile(99);
+        r.window = HdrHistogram();
+    }
+}
+
+std::unique_ptr<ReplicationCall> GrpcReplicationTransport::begin(const std::vector<std::string> &addrs,
+                                                                 int64_t local_index,
+                                                                 const SequencerLog::Entry &e,
+                                                                 int64_t view, uint64_t trace_id) {
+    std::unique_ptr<GrpcReplicationCall> call(
+        new GrpcReplicationCall(this, stub_for_, spare_stub_for_, addrs, view));
+    ReplicateAppendRequest *req = call->request();
+    req->set_client_id(e.client_id);
+    req->set_req_id(e.req_id);
+    call->set_record(&e.record);
+    req->set_local_index(local_index);
+    req->set_global_pos(e.global_pos);
+    req->set_view(view);
+    req->set_trace_id(trace_id);
+    req->set_shard(e.shard);
+    req->set_log_id(e.log_id);
+    req->set_log_pos(e.log_pos);
+    return call;
+}
@@ -7,122 +7,1384 @@
 #include <iostream>
 #include <algorithm>          // for std::max
 #include <vector>
+#include <map>
+#include <set>
+#include <condition_variable>
+#include <climits>
 
-int Sequencer::append_local_entry(int client_id, int req_id, const std::string &record) {
-    std::lock_guard<std::mutex> lk(mtx);
-    int local_idx = state.log.append({client_id, req_id, record});
-    std::cout << "[LOCAL] Appended local idx " << local_idx << "\n";
-    std::cout << "[APPEND] client=" << client_id
-              << " req=" << req_id
-              << " local_idx=" << local_idx
-              << " record=" << record << "\n";
+using sequencer_internal::LogEntry;
+
+static LogEntry to_log_entry(const SequencerLog::Entry &e) {
+    LogEntry le;
+    le.set_client_id(e.client_id);
+    le.set_req_id(e.req_id);
+    le.set_record(e.record);
+    le.set_global_pos(e.global_pos);
+    le.set_shard(e.shard);
+    le.set_log_id(e.log_id);
+    le.set_log_pos(e.log_pos);
+    return le;
+}
+
+static SequencerLog::Entry from_log_entry(const LogEntry &e) {
+    return {e.client_id(), e.req_id(), e.record(), e.global_pos(), e.shard(), e.log_id(), e.log_pos()};
+}
+
+// moves the record out of e instead of copying it
+static SequencerLog::Entry from_log_entry(LogEntry &&e) {
+    return {e.client_id(), e.req_id(), std::move(*e.mutable_record()), e.global_pos(), e.shard(),
+            e.log_id(), e.log_pos()};
+}
+
+// One in-flight unary call of a parallel fan-out to the followers.
+template <class Reply>
+struct FanOutCall {
+    std::string addr;
+    grpc::ClientContext ctx;
+    Reply reply;
+    grpc::Status status;
+    int64_t done_us = 0;   // steady clock, when the call completed
+};
+
+/*
+  Issue one async unary call per address and wait until all of them have
+  completed or hit the deadline, so a dead follower costs at most
+  timeout_ms instead of delaying the others. start(stub, call, done) must
+  start the RPC on call->ctx / call->reply and invoke done(status).
+*/
+template <class Reply, class StartFn>
+static std::vector<std::unique_ptr<FanOutCall<Reply>>>
+fan_out(const std::vector<std::string> &addrs, int timeout_ms, StartFn start,
+        const std::function<std::shared_ptr<sequencer_internal::SequencerInternal::Stub>(const std::string&)> &stub_for)
+{
+    std::vector<std::unique_ptr<FanOutCall<Reply>>> calls;
+    if (addrs.empty()) return calls;
+
+    std::mutex done_mtx;
+    std::condition_variable done_cv;
+    int pending = (int)addrs.size();
+
+    auto deadline = std::chrono::system_clock::now() + std::chrono::milliseconds(timeout_ms);
+    for (const auto &addr : addrs) {
+        calls.emplace_back(new FanOutCall<Reply>());
+        FanOutCall<Reply> *c = calls.back().get();
+        c->addr = addr;
+        c->ctx.set_deadline(deadline);
+        start(stub_for(addr), c, [&, c](grpc::Status status) {
+            std::lock_guard<std::mutex> lk(done_mtx);
+            c->status = status;
+            c->done_us = steady_now_us();
+            if (--pending == 0) done_cv.notify_one();
+        });
+    }
+
+    std::unique_lock<std::mutex> lk(done_mtx);
+    done_cv.wait(lk, [&] { return pending == 0; });
+    return calls;
+}
+
+std::shared_ptr<sequencer_internal::SequencerInternal::Stub> Sequencer::stub_for(const std::string &addr) {
+    std::lock_guard<std::mutex> lk(stubs_mtx);
+    auto it = stubs.find(addr);
+    if (it != stubs.end()) return it->second;
+    // peers come and go (failover, joins); keep reconnect backoff short so
+    // a replica that was down is usable again within a second of restarting
+    grpc::ChannelArguments args;
+    args.SetInt(GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS, 100);
+    args.SetInt(GRPC_ARG_MAX_RECONNECT_BACKOFF_MS, 1000);
+    auto channel = grpc::CreateCustomChannel(addr, grpc::InsecureChannelCredentials(), args);
+    std::shared_ptr<sequencer_internal::SequencerInternal::Stub> stub =
+        sequencer_internal::SequencerInternal::NewStub(channel);
+    stubs.emplace(addr, stub);
+    channels.emplace(addr, channel);
+    generic_stubs.emplace(addr, std::make_shared<grpc::GenericStub>(channel));
+    return stub;
+}
+
+std::shared_ptr<grpc::GenericStub> Sequencer::generic_stub_for(const std::string &addr) {
+    stub_for(addr);
+    std::lock_guard<std::mutex> lk(stubs_mtx);
+    return generic_stubs[addr];
+}
+
+std::shared_ptr<grpc::GenericStub> Sequencer::spare_stub_for(const std::string &addr) {
+    std::lock_guard<std::mutex> lk(stubs_mtx);
+    auto it = spare_stubs.find(addr);
+    if (it != spare_stubs.end()) return it->second;
+    // a local subchannel pool keeps this channel off the connection the
+    // cached one uses, so a stuck connection does not hold up the hedge
+    grpc::ChannelArguments args;
+    args.SetInt(GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS, 100);
+    args.SetInt(GRPC_ARG_MAX_RECONNECT_BACKOFF_MS, 1000);
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    auto stub = std::make_shared<grpc::GenericStub>(
+        grpc::CreateCustomChannel(addr, grpc::InsecureChannelCredentials(), args));
+    spare_stubs.emplace(addr, stub);
+    return stub;
+}
+
+bool Sequencer::prewarm(const std::string &addr, int timeout_ms) {
+    stub_for(addr);
+    std::shared_ptr<grpc::Channel> channel;
+    {
+        std::lock_guard<std::mutex> lk(stubs_mtx);
+        channel = channels[addr];
+    }
+    return channel->WaitForConnected(std::chrono::system_clock::now() +
+                                     std::chrono::milliseconds(timeout_ms));
+}
+
+std::vector<std::string> Sequencer::get_followers() {
+    std::lock_guard<std::mutex> lk(followers_mtx);
+    return followers;
+}
+
+void Sequencer::set_followers(const std::vector<std::string> &addrs) {
+    std::lock_guard<std::mutex> lk(followers_mtx);
+    followers = addrs;
+    has_followers.store(!followers.empty());
+}
+
+static int64_t request_key(int client_id, int req_id) {
+    return ((int64_t)client_id << 32) | (uint32_t)req_id;
+}
+
+int Sequencer::join_unordered_locked(uint64_t log_id, int client_id, int req_id) {
+    auto log = logs.find(log_id);
+    if (log == logs.end()) return -1;
+    auto it = log->second.unordered.find(request_key(client_id, req_id));
+    if (it == log->second.unordered.end()) return -1;
+    in_flight[it->second]++;
+    return it->second;
+}
+
+int Sequencer::append_local_entry(int client_id, int req_id, const std::string &record,
+                                  int shard, uint64_t trace_id, uint64_t log_id) {
+    int64_t start_us = steady_now_us(), locked_us;
+    int local_idx;
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        locked_us = steady_now_us();
+        local_idx = join_unordered_locked(log_id, client_id, req_id);
+        if (local_idx >= 0) {
+            std::cout << "[APPEND] client=" << client_id << " req=" << req_id
+                      << " retried, replicating local_idx=" << local_idx << " again\n";
+        } else {
+            // gp follows local order within the view, so it is fixed at append time
+            // and travels with the entry to the followers
+            int64_t gp = state.view_gp_base + (state.log.last_index() + 1 - state.view_local_base);
+            // the default log's positions are the gps themselves
+            int64_t pos = log_id == 0 ? gp : logs[log_id].next_pos++;
+            // the only copy of the record on the leader: out of the request
+            local_idx = state.log.append(SequencerLog::Entry{client_id, req_id, record, gp, shard, log_id, pos});
+            in_flight[local_idx] = 1;
+            logs[log_id].unordered[request_key(client_id, req_id)] = local_idx;
+            next_global_pos.store(gp + 1);
+            std::cout << "[LOCAL] Appended local idx " << local_idx << "\n";
+            std::cout << "[APPEND] client=" << client_id
+                      << " req=" << req_id
+                      << " local_idx=" << local_idx
+                      << " record_bytes=" << record.size() << "\n";
+        }
+    }
+    if (trace_id) {
+        int64_t end_us = steady_now_us();
+        tracer.span(trace_id, "append_local_entry", start_us, end_us,
+                    "local_idx=" + std::to_string(local_idx));
+        tracer.span(trace_id, "lock_wait", start_us, locked_us);
+    }
     return local_idx;
 }
 
+void Sequencer::append_local_batch(const std::vector<BatchRecord> &recs, std::vector<int> *indices) {
+    std::lock_guard<std::mutex> lk(mtx);
+    int first = state.log.last_index() + 1;
+    for (const auto &r : recs) {
+        int li = join_unordered_locked(r.log_id, r.client_id, r.req_id);
+        if (li < 0) {
+            int64_t gp = state.view_gp_base + (state.log.last_index() + 1 - state.view_local_base);
+            int64_t pos = r.log_id == 0 ? gp : logs[r.log_id].next_pos++;
+            li = state.log.append(SequencerLog::Entry{r.client_id, r.req_id, std::string(r.data, r.len),
+                                                      gp, 0, r.log_id, pos});
+            in_flight[li] = 1;
+            logs[r.log_id].unordered[request_key(r.client_id, r.req_id)] = li;
+            next_global_pos.store(gp + 1);
+        }
+        indices->push_back(li);
+    }
+    std::cout << "[APPEND] batch of " << recs.size() << " at local_idx=" << first << "\n";
+}
+
+void Sequencer::append_mirrored_locked(LogEntry &&e) {
+    int li = state.log.append(from_log_entry(std::move(e)));
+    local_to_gp[li] = e.global_pos();
+    note_ordered_locked(e.log_id(), e.client_id(), e.req_id(), e.log_pos());
+    state.last_ordered_gp = std::max(state.last_ordered_gp, e.global_pos());
+    if (e.global_pos() + 1 > next_global_pos.load()) next_global_pos.store(e.global_pos() + 1);
+    leader_next_index++;
+}
+
+void Sequencer::drain_pending_locked() {
+    while (!pending.empty() && pending.begin()->first <= leader_next_index) {
+        if (pending.begin()->first == leader_next_index) append_mirrored_locked(std::move(pending.begin()->second));
+        pending.erase(pending.begin());
+    }
+}
+
+void Sequencer::handle_replicate(sequencer_internal::ReplicateAppendRequest *reqp,
+                                 sequencer_internal::ReplicateAppendReply *reply) {
+    const sequencer_internal::ReplicateAppendRequest &req = *reqp;
+    int64_t start_us = steady_now_us(), locked_us;
+    bool gap = false;
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        locked_us = steady_now_us();
+        reply->set_view(std::max(state.view, req.view()));
+        if (req.view() < state.view) {
+            std::cerr << "[FOLLOWER] Rejected ReplicateAppend from stale view " << req.view()
+                      << " (current " << state.view << ")\n";
+            reply->set_ok(false);
+            reply->set_message("Stale view");
+            return;
+        }
+        enter_view_locked(req.view());
+
+        LogEntry e;
+        e.set_client_id(req.client_id());
+        e.set_req_id(req.req_id());
+        e.set_record(std::move(*reqp->mutable_record()));
+        e.set_global_pos(req.global_pos());
+        e.set_shard(req.shard());
+        e.set_log_id(req.log_id());
+        e.set_log_pos(req.log_pos());
+
+        if (leader_next_index >= 0 && req.local_index() == leader_next_index) {
+            append_mirrored_locked(std::move(e));
+            drain_pending_locked();
+            std::cout << "[FOLLOWER] Received ReplicateAppend local_idx=" << state.log.last_index() << "\n";
+        } else if (leader_next_index >= 0 && req.local_index() < leader_next_index) {
+            // retry of an entry we already hold
+        } else {
+            pending.emplace(req.local_index(), std::move(e));
+            gap = true;
+        }
+    }
+    if (gap) start_catch_up();
+    reply->set_ok(true);
+    reply->set_message(gap ? "Buffered" : "OK");
+    if (req.trace_id()) {
+        tracer.span(req.trace_id(), "handle_replicate", start_us, steady_now_us(),
+                    "leader_idx=" + std::to_string(req.local_index()) + (gap ? " buffered" : ""));
+        tracer.span(req.trace_id(), "lock_wait", start_us, locked_us);
+    }
+}
+
 /*
   Replicate to all follower addresses in followers vector.
-  Simple synchronous unary RPC no batching for now.
+  Synchronous: the entries go to every follower, then we wait for all acks.
+  Followers reachable over the TCP transport get them there, the rest over
+  gRPC; every send starts before any wait.
 */
-bool Sequencer::replicate_to_followers(int local_index) {
-    // read entry
-    SequencerLog::Entry e = state.log.get(local_index);
+bool Sequencer::replicate_to_followers(int local_index, uint64_t trace_id, int64_t deadline_us) {
+    return replicate_range(local_index, 1, trace_id, deadline_us);
+}
+
+bool Sequencer::replicate_range(int first_index, int count, uint64_t trace_id, int64_t deadline_us) {
+    int64_t start_us = steady_now_us();
+    int64_t bound_us = start_us + (int64_t)repl_timeout_ms * 1000;
+    if (deadline_us > 0 && deadline_us < bound_us) bound_us = deadline_us;
 
     // require at least zero followers -> that's okay (single node)
+    std::vector<std::string> followers = get_followers();
     if (followers.empty()) {
         std::cout << "[REPL] No followers configured. Treating as replicated locally.\n";
         return true;
     }
 
-    std::cout << "[REPL] Replicating local_idx=" << local_index 
-              << " to " << followers.size() << " followers\n";
-
-    // For each follower, create stub and call ReplicateAppend
-    int success_count = 0;
+    std::vector<std::string> over_tcp, over_grpc;
     for (const auto &addr : followers) {
-        // Create channel and stub
-        auto channel = grpc::CreateChannel(addr, grpc::InsecureChannelCredentials());
-        auto stub = sequencer_internal::SequencerInternal::NewStub(channel);
+        if (tcp_transport && tcp_transport->connect(addr)) over_tcp.push_back(addr);
+        else over_grpc.push_back(addr);
+    }
 
-        sequencer_internal::ReplicateAppendRequest req;
-        req.set_client_id(e.client_id);
-        req.set_req_id(e.req_id);
-        req.set_record(e.record);
-        req.set_local_index(local_index);
+    std::cout << "[REPL] Replicating local_idx=" << first_index;
+    if (count > 1) std::cout << ".." << first_index + count - 1;
+    std::cout << " to " << followers.size() << " followers\n";
 
-        sequencer_internal::ReplicateAppendReply reply;
-        grpc::ClientContext ctx;
-        // retry basic loop (2 tries)
-        bool ok = false;
-        for (int attempt=0; attempt<2 && !ok; ++attempt) {
-            grpc::Status status = stub->ReplicateAppend(&ctx, req, &reply);
-            if (status.ok() && reply.ok()) {
-                ok = true;
-            } else {
-                std::cerr << "[REPL:" << addr << "] attempt " << attempt << " failed: "
-                          << (status.ok() ? reply.message() : status.error_message()) << "\n";
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // the calls may point at the entries' records instead of copying them:
+    // they stay in place (the log is a deque, and in_flight keeps GC off
+    // them) while sending holds off a snapshot install until the calls are
+    // gone
+    std::vector<std::unique_ptr<ReplicationCall>> calls;
+    int64_t view;
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        view = state.view;
+        sending++;
+        for (int i = first_index; i < first_index + count; ++i) {
+            const SequencerLog::Entry &e = state.log.get(i);
+            if (!over_tcp.empty()) calls.push_back(tcp_transport->begin(over_tcp, i, e, view, trace_id));
+            if (!over_grpc.empty()) calls.push_back(grpc_transport->begin(over_grpc, i, e, view, trace_id));
+        }
+    }
+
+    for (auto &call : calls) call->send(bound_us);
+    std::vector<ReplicateAck> acks;
+    for (auto &call : calls) {
+        for (auto &ack : call->wait()) acks.push_back(std::move(ack));
+    }
+    calls.clear();
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        sending--;
+    }
+
+    int success_count = 0;
+    for (const auto &ack : acks) {
+        if (ack.ok) {
+            success_count++;
+        } else if (ack.view > view) {
+            // follower moved to a newer view: we are no longer leader
+            fence_if_superseded(ack.view);
+            if (trace_id) {
+                tracer.span(trace_id, "ReplicateAppend", ack.start_us, ack.done_us, ack.addr + " fenced");
             }
+            return false;
+        } else {
+            std::cerr << "[REPL:" << ack.addr << "] failed: " << ack.error << "\n";
+        }
+        // one span per follower, so a slow one stands out in the trace
+        if (trace_id) {
+            tracer.span(trace_id, "ReplicateAppend", ack.start_us, ack.done_us,
+                        ack.addr + " attempts=" + std::to_string(ack.attempts) +
+                        (ack.hedges ? " hedged" : "") + (ack.ok ? "" : " failed"));
         }
-        if (ok) success_count++;
     }
 
-    bool all_ok = (success_count == (int)followers.size());
-    std::cout << "[REPL] replication result: " << success_count << "/" << followers.size() << "\n";
+    // every entry acked by every follower
+    int expected = (int)followers.size() * count;
+    bool all_ok = (success_count == expected);
+    std::cout << "[REPL] replication result: " << success_count << "/" << expected << "\n";
+    if (trace_id) {
+        tracer.span(trace_id, "replicate_to_followers", start_us, steady_now_us(),
+                    std::to_string(success_count) + "/" + std::to_string(expected) + " acked");
+    }
     return all_ok;
 }
 
-int Sequencer::assign_global_pos(int local_index) {
-    // Use atomic monotonic counter to avoid races and ensure strictly increasing gp
-    int64_t gp = next_global_pos.fetch_add(1, std::memory_order_relaxed);
+// the entry at local_index is ordered at the gp it was appended with
+const SequencerLog::Entry &Sequencer::order_locked(int local_index) {
+    const SequencerLog::Entry &e = state.log.get(local_index);
+    local_to_gp[local_index] = e.global_pos;
+    auto log = logs.find(e.log_id);
+    if (log != logs.end()) log->second.unordered.erase(request_key(e.client_id, e.req_id));
+    note_ordered_locked(e.log_id, e.client_id, e.req_id, e.log_pos);
+    state.last_ordered_gp = std::max(state.last_ordered_gp, e.global_pos);
+    state.stable_gp = std::max(state.stable_gp, e.global_pos);
+    return e;
+}
 
-    std::cout << "[GLOBAL] Assigned GP=" << gp 
-          << " for local_idx=" << local_index << "\n";
+// an append is done with the entry at local_index
+void Sequencer::release_locked(int local_index) {
+    auto it = in_flight.find(local_index);
+    if (it == in_flight.end()) return;
+    it->second = std::max(it->second - 1, 0);
+    if (it->second == 0 && local_to_gp.count(local_index)) in_flight.erase(it);
+}
+
+void Sequencer::abandon_entries(const std::vector<int> &indices) {
+    std::lock_guard<std::mutex> lk(mtx);
+    for (int li : indices) release_locked(li);
+}
+
+void Sequencer::order_held_locked(const std::vector<std::string> &followers) {
+    int64_t held = INT64_MAX;   // local indices below it are on every follower
+    for (const auto &addr : followers) {
+        auto it = follower_next.find(addr);
+        if (it == follower_next.end() || it->second < 0) return;
+        held = std::min(held, it->second);
+    }
+    for (auto it = in_flight.begin(); it != in_flight.end() && it->first < held;) {
+        if (it->second > 0) {
+            ++it;
+            continue;
+        }
+        const SequencerLog::Entry &e = order_locked(it->first);
+        std::cout << "[ORDER] Ordered abandoned local_idx " << it->first << " at gp " << e.global_pos
+                  << ", held by every follower\n";
+        it = in_flight.erase(it);
+    }
+}
 
+void Sequencer::assign_global_range(const std::vector<int> &indices, std::vector<int64_t> *positions) {
+    int64_t last_gp = -1;
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        for (int li : indices) {
+            const SequencerLog::Entry &e = order_locked(li);
+            positions->push_back(e.log_pos);
+            last_gp = std::max(last_gp, e.global_pos);
+            release_locked(li);
+        }
+    }
+    std::cout << "[ORDER] Assigned global_pos .." << last_gp << " to " << indices.size()
+              << " entries from local_index " << indices.front() << "\n";
+}
+
+bool Sequencer::append_batch(const std::vector<BatchRecord> &recs, std::vector<int64_t> *positions,
+                             int64_t deadline_us) {
+    int64_t start_us = steady_now_us();
+    std::vector<int> indices;
+    append_local_batch(recs, &indices);
+    int64_t appended_us = steady_now_us();
+    // a replication round per run of consecutive entries; only retries of
+    // failed appends split a batch
+    bool ok = true;
+    for (size_t i = 0, j; ok && i < indices.size(); i = j) {
+        for (j = i + 1; j < indices.size() && indices[j] == indices[j - 1] + 1; ++j) {}
+        ok = replicate_range(indices[i], (int)(j - i), 0, deadline_us);
+    }
+    int64_t replicated_us = steady_now_us();
+    // stage latencies are per batch here, not per record
+    metrics.local_append_us.record(appended_us - start_us);
+    metrics.replicate_us.record(replicated_us - appended_us);
+    if (!ok) {
+        abandon_entries(indices);
+        return false;
+    }
+
+    assign_global_range(indices, positions);
+    int64_t done_us = steady_now_us();
+    int64_t bytes = 0;
+    for (const auto &r : recs) bytes += (int64_t)r.len;
+    metrics.order_us.record(done_us - replicated_us);
+    metrics.append_us.record(done_us - start_us);
+    metrics.appends.add((int64_t)recs.size());
+    metrics.append_bytes.add(bytes);
+    return true;
+}
+
+int Sequencer::assign_global_pos(int local_index, uint64_t trace_id) {
+    // gp was fixed when the entry was appended in this view (see
+    // append_local_entry); ordering it here makes it visible to clients
+    int64_t gp, pos;
+    int shard;
+    int64_t start_us = steady_now_us(), locked_us;
 
     // record mapping local_index -> gp
     {
         std::lock_guard<std::mutex> lk(mtx);
-        local_to_gp[local_index] = gp;
-        // update state last ordered / stable
-        state.last_ordered_gp = gp;
-        state.stable_gp = gp;
+        locked_us = steady_now_us();
+        const SequencerLog::Entry &e = order_locked(local_index);
+        gp = e.global_pos;
+        pos = e.log_pos;
+        shard = e.shard;
+        release_locked(local_index);
     }
 
-    // For demo: shard is only for logging, not used to compute gp
-    const int NUM_SHARDS = 2;
-    int shard = (int)(gp % NUM_SHARDS);
+    std::cout << "[GLOBAL] Assigned GP=" << gp 
+          << " for local_idx=" << local_index << "\n";
 
-    std::cout << "[ORDER] Assigned global_pos " << gp << " to local_index " << local_index
-              << " (shard=" << shard << ")\n";
-    return (int)gp;
+    // the record itself is either inline or on the shard the client wrote it to
+    std::cout << "[ORDER] Assigned global_pos " << gp << " to local_index " << local_index;
+    if (pos != gp) std::cout << " (log pos " << pos << ")";
+    if (shard > 0) std::cout << " (shard=" << shard << ")";
+    std::cout << "\n";
+    if (trace_id) {
+        tracer.span(trace_id, "assign_global_pos", start_us, steady_now_us(),
+                    "gp=" + std::to_string(gp));
+        tracer.span(trace_id, "lock_wait", start_us, locked_us);
+    }
+    return (int)pos;
 }
 
 void Sequencer::gc_up_to(int gp) {
+    int dropped = gc_step(gp, INT_MAX);
+    if (dropped > 0) {
+        std::cout << "[GC] GC done up to gp " << gp << " (" << dropped << " entries)\n";
+    } else {
+        std::cout << "[GC] Nothing to GC for gp " << gp << "\n";
+    }
+}
+
+int Sequencer::gc_step(int64_t gp, int max_entries) {
+    int64_t start_us = steady_now_us();
+    int dropped = 0;
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        // entries still being replicated have a gp but are not ordered yet;
+        // appends finish out of order, so one may still be in flight below
+        // last_ordered_gp
+        gp = std::min(gp, state.last_ordered_gp);
+        int64_t first = state.log.first_index();
+        int64_t last = first - 1;   // last local index to drop
+        int64_t end = in_flight.empty() ? state.log.last_index() : in_flight.begin()->first - 1;
+        int64_t last_gp = state.gc_gp;
+        while (dropped < max_entries && last < end) {
+            const SequencerLog::Entry &e = state.log.get((int)last + 1);
+            if (e.global_pos > gp) break;
+            // the log is shared, so a hold on one log stops GC for all
+            // entries behind it too
+            auto it = logs.find(e.log_id);
+            if (it != logs.end()) {
+                LogState &ls = it->second;
+                bool held = false;
+                for (const auto &h : ls.gc_holds) held = held || e.log_pos >= h.second;
+                if (held) break;
+                ls.gc_pos = std::max(ls.gc_pos, e.log_pos);
+            }
+            last_gp = e.global_pos;
+            ++last;
+            ++dropped;
+        }
+        if (dropped == 0) return 0;
+
+        state.gc_gp = std::max(state.gc_gp, last_gp);
+        for (int64_t li = first; li <= last; ++li) local_to_gp.erase((int)li);
+        state.log.gc_up_to((int)last);
+    }
+    metrics.gc_runs.add();
+    metrics.gc_entries.add(dropped);
+    metrics.gc_us.record(steady_now_us() - start_us);
+    return dropped;
+}
+
+int64_t Sequencer::gc_safe_gp(int retain_entries) {
+    bool leader = is_leader.load();
+    std::vector<std::string> fs = leader ? get_followers() : std::vector<std::string>();
+
     std::lock_guard<std::mutex> lk(mtx);
+    int64_t first = state.log.first_index(), last = state.log.last_index();
+    if (first > last) return -1;
+    // gp of the entry at local index li, or of the entry before the log
+    auto gp_at = [&](int64_t li) -> int64_t {
+        if (li < first) return state.log.get((int)first).global_pos - 1;
+        return state.log.get((int)std::min(li, last)).global_pos;
+    };
 
-    // Remove mapping entries with gp' <= gp; find maximum local_index we can drop
-    int max_local_to_gc = -1;
-    std::vector<int> to_erase;
-    for (auto &kv : local_to_gp) {
-        int local_idx = kv.first;
-        int64_t mapped_gp = kv.second;
-        if (mapped_gp <= gp) {
-            max_local_to_gc = std::max(max_local_to_gc, local_idx);
-            to_erase.push_back(local_idx);
+    int64_t safe = std::min(state.last_ordered_gp, gp_at(last - retain_entries));
+    if (leader) {
+        // a follower whose position is unknown will take a snapshot anyway
+        for (const auto &addr : fs) {
+            auto it = follower_next.find(addr);
+            if (it == follower_next.end()) return -1;
+            if (it->second >= 0) safe = std::min(safe, gp_at(it->second - 1));
         }
+    } else {
+        safe = std::min(safe, leader_gc_gp.load());
     }
+    for (const auto &kv : gc_holds) safe = std::min(safe, kv.second - 1);
+    return safe;
+}
+
+void Sequencer::set_gc_hold(const std::string &name, int64_t keep_from_gp) {
+    std::lock_guard<std::mutex> lk(mtx);
+    gc_holds[name] = keep_from_gp;
+}
+
+void Sequencer::clear_gc_hold(const std::string &name) {
+    std::lock_guard<std::mutex> lk(mtx);
+    gc_holds.erase(name);
+}
+
+void Sequencer::set_log_gc_hold(uint64_t log_id, const std::string &name, int64_t keep_from_pos) {
+    std::lock_guard<std::mutex> lk(mtx);
+    logs[log_id].gc_holds[name] = keep_from_pos;
+}
+
+void Sequencer::clear_log_gc_hold(uint64_t log_id, const std::string &name) {
+    std::lock_guard<std::mutex> lk(mtx);
+    auto it = logs.find(log_id);
+    if (it != logs.end()) it->second.gc_holds.erase(name);
+}
+
+/*
+  Heartbeat all followers in parallel so one dead follower cannot delay the
+  others past their lease. Renews the leader lease when every follower
+  acked, matching the all-followers replication rule.
+*/
+int Sequencer::heartbeat_followers(int timeout_ms) {
+    std::vector<std::string> followers = get_followers();
+    if (followers.empty()) return 0;
 
-    // erase mapping entries
-    for (int li : to_erase) {
-        local_to_gp.erase(li);
+    sequencer_internal::HeartbeatRequest req;
+    req.set_leader_addr(self_addr);
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        req.set_view(state.view);
+        req.set_last_local_index(state.log.last_index());
+        req.set_gc_gp(state.gc_gp);
     }
 
-    if (max_local_to_gc >= 0) {
-        // GC local log up to the computed local index
-        state.log.gc_up_to(max_local_to_gc);
-        state.stable_gp = gp;
-        std::cout << "[GC] GC done up to gp " << gp << " (local_index " << max_local_to_gc << ")\n";
-    } else {
-        std::cout << "[GC] Nothing to GC for gp " << gp << "\n";
+    int64_t sent_us = steady_now_us();
+    using Call = FanOutCall<sequencer_internal::HeartbeatReply>;
+    auto calls = fan_out<sequencer_internal::HeartbeatReply>(followers, timeout_ms,
+        [&](std::shared_ptr<sequencer_internal::SequencerInternal::Stub> stub, Call *c,
+            std::function<void(grpc::Status)> done) {
+            stub->async()->Heartbeat(&c->ctx, &req, &c->reply, std::move(done));
+        },
+        [this](const std::string &a) { return stub_for(a); });
+
+    int acks = 0;
+    int64_t now_ms = steady_now_ms();
+    for (auto &c : calls) {
+        if (c->status.ok() && c->reply.ok()) {
+            acks++;
+            // lag against the index the heartbeat advertised; -1 while the
+            // follower does not know its position yet
+            int64_t lag = c->reply.next_index() >= 0
+                              ? req.last_local_index() + 1 - c->reply.next_index() : -1;
+            metrics.note_follower(c->addr, lag, c->done_us - sent_us, now_ms);
+            if (tcp_transport) tcp_transport->set_route(c->addr, c->reply.repl_port());
+            std::lock_guard<std::mutex> lk(mtx);
+            follower_next[c->addr] = c->reply.next_index();
+        } else if (c->status.ok()) {
+            fence_if_superseded(c->reply.view());
+        }
     }
+
+    if (acks == (int)followers.size()) {
+        renew_lease(sent_us / 1000);
+        std::lock_guard<std::mutex> lk(mtx);
+        order_held_locked(followers);
+    }
+    return acks;
+}
+
+void Sequencer::run_view_change(int64_t min_view, int timeout_ms) {
+    std::vector<std::string> followers = get_followers();
+
+    int64_t from_gp;
+    int64_t view;
+    std::vector<LogEntry> own_pending;   // acked past a gap while we followed
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        from_gp = state.last_ordered_gp;
+        view = std::max(state.view + 1, min_view);
+        for (auto &kv : pending) {
+            if (kv.second.global_pos() > from_gp) own_pending.push_back(std::move(kv.second));
+        }
+        pending.clear();
+    }
+
+    // ---- phase 1: seal the old view and collect every replica's tail ----
+    sequencer_internal::SealViewRequest seal;
+    seal.set_from_gp(from_gp);
+    seal.set_leader_addr(self_addr);
+
+    using SealCall = FanOutCall<sequencer_internal::SealViewReply>;
+    std::vector<std::unique_ptr<SealCall>> sealed_calls;
+    // a replica already in a higher view rejects us; retry once above it
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        seal.set_view(view);
+        sealed_calls = fan_out<sequencer_internal::SealViewReply>(followers, timeout_ms,
+            [&](std::shared_ptr<sequencer_internal::SequencerInternal::Stub> stub, SealCall *c,
+                std::function<void(grpc::Status)> done) {
+                stub->async()->SealView(&c->ctx, &seal, &c->reply, std::move(done));
+            },
+            [this](const std::string &a) { return stub_for(a); });
+
+        int64_t highest = -1;
+        for (auto &c : sealed_calls) {
+            if (c->status.ok() && !c->reply.ok())
+                highest = std::max(highest, c->reply.view());
+        }
+        if (highest < 0) break;
+        view = highest + 1;
+    }
+
+    int64_t next_local = 0;
+
+    // ---- adopt the highest ordered tail ----
+    std::map<int64_t, LogEntry> tail;                       // gp -> entry
+    std::vector<std::set<int64_t>> held(sealed_calls.size()); // gps in each replica's log
+    int64_t max_gp = from_gp;
+    for (const auto &e : own_pending) {
+        tail.emplace(e.global_pos(), e);
+        max_gp = std::max(max_gp, e.global_pos());
+    }
+    for (size_t i = 0; i < sealed_calls.size(); ++i) {
+        auto &c = sealed_calls[i];
+        if (!c->status.ok() || !c->reply.ok()) {
+            std::cerr << "[VIEW] seal of " << c->addr << " failed: "
+                      << (c->status.ok() ? "newer view" : c->status.error_message()) << "\n";
+            continue;
+        }
+        std::cout << "[VIEW] " << c->addr << " sealed: max_local_index=" << c->reply.max_local_index()
+                  << " last_ordered_gp=" << c->reply.last_ordered_gp()
+                  << " tail=" << c->reply.entries_size() << "\n";
+        max_gp = std::max(max_gp, c->reply.last_ordered_gp());
+        for (const auto &e : c->reply.entries()) {
+            if (e.global_pos() <= from_gp) continue;
+            tail.emplace(e.global_pos(), e);
+            held[i].insert(e.global_pos());
+            max_gp = std::max(max_gp, e.global_pos());
+        }
+        // the replica dropped these when it sealed; NewView sends them back
+        for (const auto &e : c->reply.pending()) {
+            if (e.global_pos() <= from_gp) continue;
+            tail.emplace(e.global_pos(), e);
+            max_gp = std::max(max_gp, e.global_pos());
+        }
+    }
+
+    // gps handed out by the old leader that no survivor holds were never
+    // acknowledged; fill them with no-op entries so the sequence has no gaps
+    int fillers = 0;
+    for (int64_t g = from_gp + 1; g <= max_gp; ++g) {
+        if (tail.count(g)) continue;
+        LogEntry noop;
+        noop.set_client_id(-1);
+        noop.set_req_id(-1);
+        noop.set_global_pos(g);
+        noop.set_log_pos(g);
+        tail.emplace(g, noop);
+        fillers++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        state.view = view;
+        for (const auto &kv : tail) {
+            const LogEntry &e = kv.second;
+            int li = state.log.append(from_log_entry(e));
+            local_to_gp[li] = e.global_pos();
+            note_ordered_locked(e.log_id(), e.client_id(), e.req_id(), e.log_pos());
+        }
+        state.last_ordered_gp = max_gp;
+        state.stable_gp = max_gp;
+        state.view_local_base = state.log.last_index() + 1;
+        next_local = state.view_local_base;
+        state.view_gp_base = max_gp + 1;
+        next_global_pos.store(max_gp + 1);
+    }
+
+    // ---- phase 2: install the recovered tail on every sealed replica ----
+    std::vector<std::string> sealed_addrs;
+    std::vector<sequencer_internal::NewViewRequest> installs;
+    for (size_t i = 0; i < sealed_calls.size(); ++i) {
+        auto &c = sealed_calls[i];
+        if (!c->status.ok() || !c->reply.ok()) continue;
+        sequencer_internal::NewViewRequest nv;
+        nv.set_view(view);
+        nv.set_leader_addr(self_addr);
+        nv.set_next_global_pos(max_gp + 1);
+        // a replica behind our own ordered prefix (e.g. one that registered
+        // just before the election) is not anchored; it state-transfers
+        nv.set_next_local_index(c->reply.last_ordered_gp() < from_gp ? -1 : next_local);
+        for (const auto &kv : tail) {
+            if (!held[i].count(kv.first)) *nv.add_entries() = kv.second;
+        }
+        sealed_addrs.push_back(c->addr);
+        installs.push_back(std::move(nv));
+    }
+
+    using NewViewCall = FanOutCall<sequencer_internal::NewViewReply>;
+    size_t next_install = 0;
+    auto opened = fan_out<sequencer_internal::NewViewReply>(sealed_addrs, timeout_ms,
+        [&](std::shared_ptr<sequencer_internal::SequencerInternal::Stub> stub, NewViewCall *c,
+            std::function<void(grpc::Status)> done) {
+            stub->async()->NewView(&c->ctx, &installs[next_install++], &c->reply, std::move(done));
+        },
+        [this](const std::string &a) { return stub_for(a); });
+
+    int installed = 0;
+    for (auto &c : opened) {
+        if (c->status.ok() && c->reply.ok()) installed++;
+    }
+
+    std::cout << "[VIEW] view " << view << " ready: recovered " << tail.size()
+              << " tail entries (" << fillers << " no-op fillers), next gp " << (max_gp + 1)
+              << ", installed on " << installed << "/" << followers.size() << " followers\n";
+}
+
+void Sequencer::handle_seal_view(const sequencer_internal::SealViewRequest &req,
+                                 sequencer_internal::SealViewReply *reply) {
+    std::lock_guard<std::mutex> lk(mtx);
+    reply->set_max_local_index(state.log.last_index());
+    reply->set_last_ordered_gp(state.last_ordered_gp);
+    if (req.view() <= state.view) {
+        reply->set_ok(false);
+        reply->set_view(state.view);
+        return;
+    }
+
+    state.view = req.view();
+    leader_addr = req.leader_addr();
+    // the leader index space changes with the view; NewView re-anchors it
+    leader_next_index = -1;
+    if (is_leader.load()) {
+        // a newer leader exists; stop serving before it opens its view
+        become_follower();
+        std::cout << "[VIEW] deposed by " << req.leader_addr() << "\n";
+    }
+    sealed.store(true);
+
+    // entries are appended in (near) gp order, so the tail past from_gp sits
+    // at the end of the log
+    std::vector<LogEntry> tail;
+    for (int64_t i = state.log.last_index(); i >= state.log.first_index(); --i) {
+        const SequencerLog::Entry &e = state.log.get((int)i);
+        if (e.global_pos <= req.from_gp()) break;
+        tail.push_back(to_log_entry(e));
+    }
+    for (auto it = tail.rbegin(); it != tail.rend(); ++it) *reply->add_entries() = *it;
+    // buffered entries past a gap were acked too, so they count; they are
+    // numbered in the old leader's index space, so they go, and NewView
+    // installs them in the log
+    for (auto &kv : pending) {
+        if (kv.second.global_pos() > req.from_gp()) *reply->add_pending() = std::move(kv.second);
+    }
+    pending.clear();
+
+    reply->set_ok(true);
+    reply->set_view(state.view);
+    std::cout << "[VIEW] sealed into view " << state.view << " for " << req.leader_addr()
+              << ", returned " << tail.size() << " tail entries\n";
+}
+
+void Sequencer::handle_new_view(const sequencer_internal::NewViewRequest &req,
+                                sequencer_internal::NewViewReply *reply) {
+    std::lock_guard<std::mutex> lk(mtx);
+    if (req.view() < state.view) {
+        reply->set_ok(false);
+        reply->set_view(state.view);
+        return;
+    }
+    state.view = req.view();
+    for (const auto &e : req.entries()) {
+        int li = state.log.append(from_log_entry(e));
+        local_to_gp[li] = e.global_pos();
+        note_ordered_locked(e.log_id(), e.client_id(), e.req_id(), e.log_pos());
+        state.last_ordered_gp = std::max(state.last_ordered_gp, e.global_pos());
+    }
+    next_global_pos.store(req.next_global_pos());
+    state.last_ordered_gp = std::max(state.last_ordered_gp, req.next_global_pos() - 1);
+    leader_addr = req.leader_addr();
+    leader_next_index = req.next_local_index();
+    reply->set_ok(true);
+    reply->set_view(state.view);
+    std::cout << "[VIEW] installed view " << state.view << " from " << req.leader_addr()
+              << " (+" << req.entries_size() << " entries, next gp " << req.next_global_pos() << ")\n";
+}
+
+bool Sequencer::accept_view(int64_t view) {
+    std::lock_guard<std::mutex> lk(mtx);
+    if (view < state.view) return false;
+    enter_view_locked(view);
+    return true;
+}
+
+// A view this replica was not sealed into (it missed SealView/NewView,
+// e.g. while stalled): the leader's index space changed under it, so, as
+// in handle_seal_view, it forgets where it stood in the old one. What
+// arrives next is buffered until catch-up re-anchors it from a snapshot.
+void Sequencer::enter_view_locked(int64_t view) {
+    if (view <= state.view) return;
+    std::cout << "[FOLLOWER] view " << state.view << " -> " << view << " without a view change here\n";
+    state.view = view;
+    leader_next_index = -1;
+    pending.clear();
+    leader_addr.clear();
+}
+
+void Sequencer::fence_if_superseded(int64_t view) {
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        if (view <= state.view) return;
+        state.view = view;
+    }
+    if (is_leader.load()) {
+        become_follower();
+        seal_view();
+        std::cout << "[VIEW] fenced: a replica is in view " << view << ", stepping down\n";
+    }
+}
+
+grpc::Status Sequencer::serve_fetch(const sequencer_internal::FetchEntriesRequest &req,
+                                    grpc::ServerWriter<sequencer_internal::FetchEntriesReply> *writer) {
+    const int BATCH = 512;
+    int64_t from = req.from_index();
+    int64_t sent = 0;
+    while (true) {
+        sequencer_internal::FetchEntriesReply batch;
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            if (!is_leader.load())
+                return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION, "not leader");
+            if (from < state.log.first_index())
+                return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION, "compacted");
+            batch.set_first_index(from);
+            for (int64_t i = from; i <= state.log.last_index() && batch.entries_size() < BATCH; ++i) {
+                *batch.add_entries() = to_log_entry(state.log.get((int)i));
+            }
+        }
+        if (batch.entries_size() == 0) break;   // caught up to our current end
+        if (!writer->Write(batch)) break;
+        from += batch.entries_size();
+        sent += batch.entries_size();
+    }
+    std::cout << "[CATCHUP] served " << sent << " entries from local_idx " << req.from_index() << "\n";
+    return grpc::Status::OK;
+}
+
+void Sequencer::fill_snapshot(const sequencer_internal::SnapshotRequest &req,
+                              sequencer_internal::SnapshotReply *reply) {
+    std::lock_guard<std::mutex> lk(mtx);
+    reply->set_ok(is_leader.load());
+    reply->set_view(state.view);
+    int64_t first = state.log.first_index(), last = state.log.last_index();
+    int64_t from = first;
+    if (req.resume_gp() > 0) {
+        // the caller's checkpoint covers gps below resume_gp; the suffix it
+        // lacks sits at the end of the log. Never skip unordered entries.
+        int64_t resume = std::min(req.resume_gp(), state.last_ordered_gp + 1);
+        from = last + 1;
+        while (from > first && state.log.get((int)from - 1).global_pos >= resume) --from;
+    }
+    reply->set_first_index(from);
+    // everything before from is GC'd (ordered and persisted) or covered by
+    // the caller's checkpoint
+    int64_t gp_before = from > first ? state.log.get((int)from - 1).global_pos
+                      : first <= last ? state.log.get((int)first).global_pos - 1
+                      : state.last_ordered_gp;
+    reply->set_last_ordered_gp(gp_before);
+    reply->set_next_global_pos(gp_before + 1);
+    // entries of a named log may all sit in the GC'd prefix, so the
+    // counters travel with the snapshot
+    for (const auto &kv : logs) {
+        if (kv.first == 0) continue;
+        sequencer_internal::LogCounter *c = reply->add_logs();
+        c->set_log_id(kv.first);
+        c->set_next_pos(kv.second.next_pos);
+        c->set_gc_pos(kv.second.gc_pos);
+    }
+}
+
+int64_t Sequencer::note_leader_progress(const std::string &addr, int64_t leader_last_index) {
+    bool lagging;
+    int64_t next;
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        leader_addr = addr;
+        // entries in flight make us look one or two behind for a moment;
+        // only act when the same lag is still there a heartbeat later
+        // (a replica that does not know its position syncs even with an
+        // empty leader log, or it could never report a next index and join)
+        lagging = leader_next_index < 0;
+        if (leader_next_index >= 0 && leader_next_index <= leader_last_index) {
+            lagging = (lag_seen_at_heartbeat == leader_next_index);
+            lag_seen_at_heartbeat = leader_next_index;
+        } else {
+            lag_seen_at_heartbeat = -1;
+        }
+        next = leader_next_index;
+    }
+    if (lagging) start_catch_up();
+    return next;
+}
+
+void Sequencer::start_catch_up() {
+    bool expected = false;
+    if (!catching_up.compare_exchange_strong(expected, true)) return;
+    spawn_background([this] {
+        catch_up();
+        catching_up.store(false);
+    });
+}
+
+void Sequencer::spawn_background(std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lk(background_mtx);
+        if (stopping.load()) return;
+        background_tasks++;
+    }
+    std::thread([this, fn] {
+        fn();
+        std::lock_guard<std::mutex> lk(background_mtx);
+        if (--background_tasks == 0) background_cv.notify_all();
+    }).detach();
+}
+
+void Sequencer::stop_background() {
+    std::unique_lock<std::mutex> lk(background_mtx);
+    stopping.store(true);
+    background_cv.wait(lk, [&] { return background_tasks == 0; });
+}
+
+/*
+  Follower catch-up. Streams the missing range from the leader; live
+  ReplicateAppends keep arriving meanwhile and are buffered in pending (or
+  appended directly once we reach them), so the leader never waits on us.
+  A replica that does not know where it stands in the leader's log, or
+  whose gap was already GC'd by the leader, first installs a snapshot and
+  restarts its log at the leader's first retained index.
+*/
+void Sequencer::catch_up() {
+    bool must_fetch = true;
+    for (int round = 0; round < 8; ++round) {
+        std::string leader;
+        int64_t from, view, resume;
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            if (stopping.load() || is_leader.load() || leader_addr.empty()) return;
+            // done once the fetched range met the live stream without a gap
+            if (!must_fetch && leader_next_index >= 0 && pending.empty()) return;
+            leader = leader_addr;
+            from = leader_next_index;
+            view = state.view;
+            resume = resume_gp;
+        }
+        auto stub = stub_for(leader);
+
+        if (from < 0) {
+            sequencer_internal::SnapshotRequest sreq;
+            sreq.set_view(view);
+            sreq.set_resume_gp(resume);
+            sequencer_internal::SnapshotReply snap;
+            grpc::ClientContext ctx;
+            ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+            grpc::Status st = stub->GetSnapshot(&ctx, sreq, &snap);
+            if (!st.ok() || !snap.ok() || snap.view() < view) {
+                std::cerr << "[CATCHUP] snapshot from " << leader << " failed: "
+                          << (st.ok() ? "not leader" : st.error_message()) << "\n";
+                return;
+            }
+            std::unique_lock<std::mutex> lk(mtx);
+            // a round begun while this node still led may read the log yet
+            if (sending > 0) {
+                lk.unlock();
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+            state.view = snap.view();
+            state.log.reset(snap.first_index());
+            local_to_gp.clear();
+            in_flight.clear();
+            for (auto &kv : logs) kv.second.unordered.clear();
+            state.last_ordered_gp = snap.last_ordered_gp();
+            next_global_pos.store(snap.next_global_pos());
+            for (const auto &c : snap.logs()) {
+                LogState &ls = logs[c.log_id()];
+                ls.next_pos = std::max(ls.next_pos, c.next_pos());
+            }
+            leader_next_index = snap.first_index();
+            resume_gp = 0;
+            std::cout << "[CATCHUP] installed snapshot from " << leader << ": first_index="
+                      << snap.first_index() << " last_ordered_gp=" << snap.last_ordered_gp() << "\n";
+            drain_pending_locked();
+            must_fetch = true;
+            continue;
+        }
+        must_fetch = false;
+
+        sequencer_internal::FetchEntriesRequest freq;
+        freq.set_from_index(from);
+        freq.set_view(view);
+        grpc::ClientContext ctx;
+        ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(30));
+        std::unique_ptr<grpc::ClientReader<sequencer_internal::FetchEntriesReply>> reader(
+            stub->FetchEntries(&ctx, freq));
+
+        sequencer_internal::FetchEntriesReply batch;
+        int64_t fetched = 0;
+        while (reader->Read(&batch)) {
+            if (stopping.load()) ctx.TryCancel();
+            std::lock_guard<std::mutex> lk(mtx);
+            for (int k = 0; k < batch.entries_size(); ++k) {
+                if (batch.first_index() + k == leader_next_index) {
+                    append_mirrored_locked(std::move(*batch.mutable_entries(k)));
+                    fetched++;
+                }
+            }
+            drain_pending_locked();
+        }
+        grpc::Status st = reader->Finish();
+        std::cout << "[CATCHUP] fetched " << fetched << " entries from " << leader
+                  << " starting at local_idx " << from << "\n";
+        if (st.error_code() == grpc::StatusCode::FAILED_PRECONDITION &&
+            st.error_message() == "compacted") {
+            std::lock_guard<std::mutex> lk(mtx);
+            leader_next_index = -1;   // restart from a snapshot
+            continue;
+        }
+        if (!st.ok()) {
+            std::cerr << "[CATCHUP] fetch from " << leader << " failed: " << st.error_message() << "\n";
+            return;
+        }
+    }
+}
+
+void Sequencer::note_ordered_locked(uint64_t log_id, int client_id, int req_id, int64_t pos) {
+    if (client_id < 0) return;   // view-change no-op
+    LogState &ls = logs[log_id];
+    ls.next_pos = std::max(ls.next_pos, pos + 1);
+    if (track_dedup_changes) dedup_dirty[log_id].insert(client_id);
+    auto it = ls.dedup.find(client_id);
+    if (it == ls.dedup.end()) {
+        ls.dedup.emplace(client_id, DedupEntry{req_id, pos, 1, {}});
+        return;
+    }
+    DedupEntry &d = it->second;
+    if (req_id == d.req_id + 1 && pos == d.pos + 1) {
+        d.req_id = req_id;
+        d.pos = pos;
+        d.run++;
+    } else if (req_id > d.req_id) {
+        if (d.earlier.size() == DEDUP_RUNS) d.earlier.erase(d.earlier.begin());
+        d.earlier.push_back(DedupRun{d.req_id - d.run + 1, d.run, d.pos - d.run + 1});
+        d.req_id = req_id;
+        d.pos = pos;
+        d.run = 1;
+    } else if (req_id == d.req_id && pos != d.pos) {
+        d.pos = pos;
+        d.run = 1;
+    }
+}
+
+bool Sequencer::find_duplicate(uint64_t log_id, int client_id, int req_id, int64_t *pos) {
+    std::lock_guard<std::mutex> lk(mtx);
+    auto log = logs.find(log_id);
+    if (log == logs.end()) return false;
+    auto it = log->second.dedup.find(client_id);
+    if (it == log->second.dedup.end()) return false;
+    const DedupEntry &d = it->second;
+    if (req_id <= d.req_id && req_id > d.req_id - d.run) {
+        *pos = d.pos - (d.req_id - req_id);
+        return true;
+    }
+    for (const DedupRun &r : d.earlier) {
+        if (req_id >= r.first_req && req_id < r.first_req + r.count) {
+            *pos = r.first_pos + (req_id - r.first_req);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Sequencer::admit_log(uint64_t log_id) {
+    std::lock_guard<std::mutex> lk(mtx);
+    return max_logs <= 0 || logs.count(log_id) || (int)logs.size() < max_logs;
+}
+
+size_t Sequencer::log_count() {
+    std::lock_guard<std::mutex> lk(mtx);
+    return logs.size();
+}
+
+bool Sequencer::log_info(uint64_t log_id, int64_t *next_pos, int64_t *gc_pos, int64_t *clients) {
+    std::lock_guard<std::mutex> lk(mtx);
+    auto it = logs.find(log_id);
+    if (log_id == 0) {
+        *next_pos = next_global_pos.load();
+        *gc_pos = state.gc_gp;
+        *clients = it == logs.end() ? 0 : (int64_t)it->second.dedup.size();
+        return true;
+    }
+    if (it == logs.end()) return false;
+    *next_pos = it->second.next_pos;
+    *gc_pos = it->second.gc_pos;
+    *clients = (int64_t)it->second.dedup.size();
+    return true;
+}
+
+sequencer_internal::Checkpoint Sequencer::take_checkpoint() {
+    sequencer_internal::Checkpoint c;
+    struct Row {
+        uint64_t log_id;
+        int client_id;
+        DedupEntry entry;
+    };
+    std::vector<Row> changed;
+    std::vector<sequencer_internal::LogCounter> counters;
+    std::lock_guard<std::mutex> ckpt_lk(ckpt_mtx);
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        c.set_view(state.view);
+        c.set_last_ordered_gp(state.last_ordered_gp);
+        c.set_stable_gp(state.stable_gp);
+        c.set_next_global_pos(next_global_pos.load());
+        c.set_view_local_base(state.view_local_base);
+        c.set_view_gp_base(state.view_gp_base);
+        c.set_log_next_index(state.log.last_index() + 1);
+        c.set_gc_gp(state.gc_gp);
+        for (const auto &log : logs) {
+            if (log.first == 0) continue;
+            counters.emplace_back();
+            counters.back().set_log_id(log.first);
+            counters.back().set_next_pos(log.second.next_pos);
+            counters.back().set_gc_pos(log.second.gc_pos);
+        }
+        if (track_dedup_changes) {
+            for (const auto &d : dedup_dirty) {
+                const LogState &ls = logs[d.first];
+                for (int client : d.second)
+                    changed.push_back({d.first, client, ls.dedup.at(client)});
+            }
+            dedup_dirty.clear();
+        } else {
+            ckpt_dedup.clear();
+            for (const auto &log : logs)
+                for (const auto &kv : log.second.dedup)
+                    changed.push_back({log.first, kv.first, kv.second});
+        }
+    }
+    for (auto &row : changed) ckpt_dedup[row.log_id][row.client_id] = std::move(row.entry);
+
+    c.mutable_logs()->Reserve((int)counters.size());
+    for (auto &lc : counters) *c.add_logs() = std::move(lc);
+    for (const auto &log : ckpt_dedup) {
+        for (const auto &kv : log.second) {
+            const DedupEntry &d = kv.second;
+            sequencer_internal::DedupRecord *r = c.add_dedup();
+            r->set_log_id(log.first);
+            r->set_client_id(kv.first);
+            r->set_req_id(d.req_id);
+            r->set_global_pos(d.pos);
+            r->set_run(d.run);
+            for (const DedupRun &run : d.earlier) {
+                sequencer_internal::DedupRunRecord *er = r->add_earlier();
+                er->set_first_req(run.first_req);
+                er->set_count(run.count);
+                er->set_first_pos(run.first_pos);
+            }
+        }
+    }
+    c.set_taken_at_ms(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    return c;
+}
+
+void Sequencer::note_checkpoint_written(const sequencer_internal::Checkpoint &ckpt) {
+    checkpoint_gp.store(ckpt.last_ordered_gp());
+    set_gc_hold("checkpoint", ckpt.last_ordered_gp() + 1);
+}
+
+void Sequencer::restore_checkpoint(const sequencer_internal::Checkpoint &ckpt) {
+    std::lock_guard<std::mutex> ckpt_lk(ckpt_mtx);
+    std::lock_guard<std::mutex> lk(mtx);
+    state.view = std::max(state.view, ckpt.view());
+    state.last_ordered_gp = ckpt.last_ordered_gp();
+    state.stable_gp = ckpt.stable_gp();
+    state.view_local_base = ckpt.view_local_base();
+    state.view_gp_base = ckpt.view_gp_base();
+    state.gc_gp = ckpt.gc_gp();
+    state.log.reset(ckpt.log_next_index());
+    local_to_gp.clear();
+    next_global_pos.store(ckpt.next_global_pos());
+    logs.clear();
+    for (const auto &lc : ckpt.logs()) {
+        LogState &ls = logs[lc.log_id()];
+        ls.next_pos = lc.next_pos();
+        ls.gc_pos = lc.gc_pos();
+    }
+    ckpt_dedup.clear();
+    dedup_dirty.clear();
+    for (const auto &r : ckpt.dedup()) {
+        // run is 0 in checkpoints written before runs were kept
+        DedupEntry d{r.req_id(), r.global_pos(), std::max(r.run(), 1), {}};
+        for (const auto &er : r.earlier())
+            d.earlier.push_back(DedupRun{er.first_req(), er.count(), er.first_pos()});
+        logs[r.log_id()].dedup[r.client_id()] = d;
+        ckpt_dedup[r.log_id()][r.client_id()] = std::move(d);
+    }
+    // the log is empty, so the leader's index space is unknown until the
+    // first catch-up, which asks only for what the checkpoint lacks
+    leader_next_index = -1;
+    resume_gp = ckpt.last_ordered_gp() + 1;
+    checkpoint_gp.store(ckpt.last_ordered_gp());
+    std::cout << "[CKPT] restored view=" << state.view << " last_ordered_gp=" << state.last_ordered_gp
+              << " next_global_pos=" << ckpt.next_global_pos() << " logs=" << logs.size()
+              << " dedup=" << ckpt.dedup_size() << " clients\n";
+}
+
+std::vector<std::string> Sequencer::get_registered() {
+    std::lock_guard<std::mutex> lk(followers_mtx);
+    return registered;
+}
+
+void Sequencer::update_membership(const std::vector<std::string> &addrs) {
+    std::vector<std::string> joiners;
+    {
+        std::lock_guard<std::mutex> lk(followers_mtx);
+        if (addrs != registered) {
+            std::cout << "[MEMBER] registered replicas:";
+            for (const auto &a : addrs) std::cout << " " << a;
+            std::cout << "\n";
+        }
+        registered = addrs;
+        if (!is_leader.load()) return;
+
+        auto gone = std::remove_if(followers.begin(), followers.end(), [&](const std::string &f) {
+            return std::find(addrs.begin(), addrs.end(), f) == addrs.end();
+        });
+        for (auto it = gone; it != followers.end(); ++it)
+            std::cout << "[MEMBER] " << *it << " left, removed from follower set\n";
+        followers.erase(gone, followers.end());
+        has_followers.store(!followers.empty());
+
+        for (const auto &a : addrs) {
+            if (std::find(followers.begin(), followers.end(), a) != followers.end()) continue;
+            if (joining.insert(a).second) joiners.push_back(a);
+        }
+    }
+    for (const auto &a : joiners) spawn_background([this, a] { join_follower(a); });
+}
+
+/*
+  Bring a newly registered replica into the follower set without touching
+  the append path: connect its channel, then heartbeat it (which starts
+  its catch-up) until it is within JOIN_SLACK entries of our log end. Any
+  entries it still lacks are fetched on its first ReplicateAppend gap.
+*/
+void Sequencer::join_follower(const std::string &addr) {
+    const int64_t JOIN_SLACK = 64;
+    std::cout << "[MEMBER] " << addr << " registered, pre-warming\n";
+    auto still_wanted = [&] {
+        std::lock_guard<std::mutex> lk(followers_mtx);
+        return !stopping.load() && is_leader.load() &&
+               std::find(registered.begin(), registered.end(), addr) != registered.end();
+    };
+
+    bool joined = false;
+    while (!joined && still_wanted()) {
+        if (!prewarm(addr, 1000)) continue;
+        if (sealed.load()) {
+            // view change in progress; our view is not installed yet
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            continue;
+        }
+
+        sequencer_internal::HeartbeatRequest req;
+        req.set_leader_addr(self_addr);
+        int64_t last;
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            req.set_view(state.view);
+            last = state.log.last_index();
+            req.set_last_local_index(last);
+        }
+        sequencer_internal::HeartbeatReply reply;
+        grpc::ClientContext ctx;
+        ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(500));
+        grpc::Status st = stub_for(addr)->Heartbeat(&ctx, req, &reply);
+        if (st.ok() && reply.ok() && reply.next_index() >= 0 && last + 1 - reply.next_index() <= JOIN_SLACK) {
+            std::lock_guard<std::mutex> lk(followers_mtx);
+            if (is_leader.load() &&
+                std::find(registered.begin(), registered.end(), addr) != registered.end() &&
+                std::find(followers.begin(), followers.end(), addr) == followers.end()) {
+                followers.push_back(addr);
+                has_followers.store(true);
+                std::cout << "[MEMBER] " << addr << " caught up (next_index=" << reply.next_index()
+                          << "), joined follower set\n";
+            }
+            joined = true;
+        } else {
+            if (st.ok()) fence_if_superseded(reply.view());
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    }
+
+    std::lock_guard<std::mutex> lk(followers_mtx);
+    joining.erase(addr);
 }
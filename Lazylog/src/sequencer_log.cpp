@@ -1,16 +1,30 @@
 #include "sequencer_log.h"
 
 int SequencerLog::append(const Entry& e) {
-    log.push_back(e);
+    return append(Entry(e));
+}
+
+int SequencerLog::append(Entry&& e) {
+    record_bytes += e.record.size();
+    log.push_back(std::move(e));
     last_local_index++;
     return last_local_index;
 }
 
-SequencerLog::Entry SequencerLog::get(int index) {
-    return log[index];
+const SequencerLog::Entry& SequencerLog::get(int index) const {
+    return log[index - first_local_index];
 }
 
 void SequencerLog::gc_up_to(int index) {
-    if(index >= 0 && index < log.size())
-        log.erase(log.begin(), log.begin() + index + 1);
+    if (index < first_local_index || index > last_local_index) return;
+    for (int64_t i = 0; i <= index - first_local_index; ++i) record_bytes -= log[i].record.size();
+    log.erase(log.begin(), log.begin() + (index - first_local_index) + 1);
+    first_local_index = index + 1;
+}
+
+void SequencerLog::reset(int64_t first_index) {
+    log.clear();
+    record_bytes = 0;
+    first_local_index = first_index;
+    last_local_index = first_index - 1;
 }
@@ -6,8 +6,18 @@
 #include <string>
 #include <grpcpp/grpcpp.h>
 #include "sequencer.h"
-#include <zookeeper/zookeeper.h>
+#include "coordinator.h"
+#include "checkpoint.h"
+#include "arena_allocator.h"
+#include "uds_target.h"
+#include "shm_ingest.h"
 #include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <algorithm>
+#include <climits>
 #include "generated/sequencer.grpc.pb.h"
 #include "generated/sequencer.pb.h"
 #include "generated/sequencer_internal.grpc.pb.h"
@@ -26,85 +36,534 @@ void handle_seal_signal(int) {
 using grpc::Server;
 using grpc::ServerBuilder;
 using grpc::ServerContext;
+using grpc::ServerReaderWriter;
+using grpc::ServerWriter;
 using grpc::Status;
 
 using sequencer::SequencerService;
 using sequencer::AppendRequest;
 using sequencer::AppendReply;
+using sequencer::AppendBatch;
+using sequencer::AppendBatchReply;
+using sequencer::StatsRequest;
+using sequencer::StatsReply;
 
 using sequencer_internal::SequencerInternal;
 using sequencer_internal::ReplicateAppendRequest;
 using sequencer_internal::ReplicateAppendReply;
+using sequencer_internal::SealViewRequest;
+using sequencer_internal::SealViewReply;
+using sequencer_internal::NewViewRequest;
+using sequencer_internal::NewViewReply;
+using sequencer_internal::FetchEntriesRequest;
+using sequencer_internal::FetchEntriesReply;
+using sequencer_internal::SnapshotRequest;
+using sequencer_internal::SnapshotReply;
+using sequencer_internal::HeartbeatRequest;
+using sequencer_internal::HeartbeatReply;
 
-// Implementation of client-facing Append RPC (leader only; followers reject)
-// Implementation of client-facing Append RPC (leader only; followers reject)
+// reply messages come from shm_ring::status_message
+static_assert((int)sequencer::APPEND_DUPLICATE == shm_ring::DUPLICATE &&
+              (int)sequencer::APPEND_NOT_LEADER == shm_ring::NOT_LEADER &&
+              (int)sequencer::APPEND_SEALED == shm_ring::SEALED &&
+              (int)sequencer::APPEND_LEASE_EXPIRED == shm_ring::LEASE_EXPIRED &&
+              (int)sequencer::APPEND_TOO_MANY_LOGS == shm_ring::TOO_MANY_LOGS &&
+              (int)sequencer::APPEND_REPLICATION_FAILED == shm_ring::REPLICATION_FAILED,
+              "AppendStatus and shm_ring::Status must agree");
+
+// Fault injection for in-process clusters (LocalCluster). Every incoming
+// RPC and the heartbeat pump pass through pass(): it adds delay_ms and
+// blocks while paused, so a paused replica looks like one stuck in a long
+// stall to its peers. Callback handlers must not block a reactor thread,
+// so they hand their work to defer() instead, which runs it on the gate's
+// worker once it would have passed. With no fault set both cost one
+// atomic load. Shutdown opens the gate for good.
+struct FaultGate {
+    std::atomic<bool> enabled{false};   // a fault is set or work is deferred
+    std::atomic<int> delay_ms{0};
+    std::mutex mu;
+    std::condition_variable cv;
+    bool paused = false;
+    bool open = false;
+    // deferred work with the time its delay is up, in arrival order
+    std::deque<std::pair<std::chrono::steady_clock::time_point, std::function<void()>>> deferred;
+    std::thread worker;
+
+    ~FaultGate() { release(); }
+
+    void pass() {
+        if (!enabled.load()) return;
+        int d = delay_ms.load();
+        if (d > 0) std::this_thread::sleep_for(std::chrono::milliseconds(d));
+        std::unique_lock<std::mutex> lk(mu);
+        cv.wait(lk, [&] { return !paused || open; });
+    }
+
+    // fn runs now when no fault is set, else on the worker behind any
+    // earlier deferred work, so a follower still applies entries in order
+    void defer(std::function<void()> fn) {
+        if (enabled.load()) {
+            std::lock_guard<std::mutex> lk(mu);
+            if (!open) {
+                if (!worker.joinable()) worker = std::thread([this] { run_deferred(); });
+                auto due = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay_ms.load());
+                deferred.emplace_back(due, std::move(fn));
+                cv.notify_all();
+                return;
+            }
+        }
+        fn();
+    }
+
+    void set_paused(bool p) {
+        {
+            std::lock_guard<std::mutex> lk(mu);
+            paused = p;
+            update_locked();
+        }
+        cv.notify_all();
+    }
+
+    void set_delay(int ms) {
+        std::lock_guard<std::mutex> lk(mu);
+        delay_ms.store(ms);
+        update_locked();
+    }
+
+    // runs what is still deferred without waiting, then stops the worker
+    void release() {
+        {
+            std::lock_guard<std::mutex> lk(mu);
+            open = true;
+        }
+        cv.notify_all();
+        if (worker.joinable()) worker.join();
+    }
+
+    void update_locked() {
+        enabled.store(paused || delay_ms.load() > 0 || !deferred.empty());
+    }
+
+    void run_deferred() {
+        std::unique_lock<std::mutex> lk(mu);
+        while (true) {
+            cv.wait(lk, [&] { return open || !deferred.empty(); });
+            if (deferred.empty()) return;
+            auto due = deferred.front().first;
+            while (!open && std::chrono::steady_clock::now() < due) cv.wait_until(lk, due);
+            cv.wait(lk, [&] { return !paused || open; });
+            std::function<void()> fn = std::move(deferred.front().second);
+            deferred.pop_front();
+            lk.unlock();
+            fn();
+            lk.lock();
+            update_locked();
+        }
+    }
+};
+
+// the client's deadline on the steady clock (0 = none)
+static int64_t client_deadline_us(const ServerContext *context) {
+    auto deadline = context->deadline();
+    if (deadline == std::chrono::system_clock::time_point::max()) return 0;
+    auto left = std::chrono::duration_cast<std::chrono::microseconds>(
+        deadline - std::chrono::system_clock::now()).count();
+    return steady_now_us() + std::max<int64_t>(left, 0);
+}
+
+// Client-facing service: Append and AppendStream (leader only; followers
+// reject) and GetStats
 class SequencerServiceImpl final : public SequencerService::Service {
 public:
     // keep only reference to Sequencer (no copied flag)
-    SequencerServiceImpl(Sequencer &s) : seq_(s) {}
+    SequencerServiceImpl(Sequencer &s, FaultGate &g)
+        : seq_(s), gate_(g), started_us_(steady_now_us()), scraped_us_(started_us_) {}
 
     Status Append(ServerContext* context, const AppendRequest* req,
                   AppendReply* reply) override {
+        gate_.pass();
+        int64_t start_us = steady_now_us();
 
         // Reject if sealed
         if (seq_.sealed.load()) {
-            reply->set_success(false);
-            reply->set_global_pos(-1);
-            reply->set_message("View is sealed");
-            return Status::OK;
+            return reject(reply, sequencer::APPEND_SEALED);
         }
 
         // Use live state from Sequencer (not a copied bool)
         if (!seq_.is_leader.load()) {
-            reply->set_success(false);
-            reply->set_global_pos(-1);
-            reply->set_message("Not leader");
+            return reject(reply, sequencer::APPEND_NOT_LEADER);
+        }
+
+        // A leader that lost contact with its followers may already have
+        // been preempted by the next replica in line.
+        if (!seq_.lease_valid()) {
+            return reject(reply, sequencer::APPEND_LEASE_EXPIRED);
+        }
+
+        // a retry of an append that was already ordered gets its position again
+        int64_t dup_pos;
+        if (seq_.find_duplicate(req->log_id(), req->client_id(), req->req_id(), &dup_pos)) {
+            reply->set_success(true);
+            reply->set_global_pos(dup_pos);
+            reply->set_status(sequencer::APPEND_DUPLICATE);
+            reply->set_message(shm_ring::status_message(sequencer::APPEND_DUPLICATE));
             return Status::OK;
         }
 
+        if (!seq_.admit_log(req->log_id())) {
+            return reject(reply, sequencer::APPEND_TOO_MANY_LOGS);
+        }
+
+        // a client over its quota waits without slowing the others; only an
+        // append that is admitted as well spends its tokens
+        if (int64_t wait_us = seq_.quotas.take(req->client_id(), 1, (int64_t)req->record().size())) {
+            return over_quota(context, 1, wait_us);
+        }
+        // held until replication ended, so a slow follower backs clients off
+        AdmissionControl::Ticket admitted(seq_.admission, 1, (int64_t)req->record().size());
+        if (!admitted) {
+            seq_.quotas.give_back(req->client_id(), 1, (int64_t)req->record().size());
+            return overloaded(context, 1);
+        }
+
+        SequencerMetrics &m = seq_.metrics;
+        uint64_t trace_id = seq_.tracer.sample();
+
         // 1) append locally
-        int local_idx = seq_.append_local_entry(req->client_id(), req->req_id(), req->record());
+        int local_idx = seq_.append_local_entry(req->client_id(), req->req_id(), req->record(),
+                                                req->shard(), trace_id, req->log_id());
+        int64_t appended_us = steady_now_us();
+        m.local_append_us.record(appended_us - start_us);
 
-        // 2) replicate to followers
-        bool repl_ok = seq_.replicate_to_followers(local_idx);
+        // 2) replicate to followers, giving up when the client would
+        bool repl_ok = seq_.replicate_to_followers(local_idx, trace_id, client_deadline_us(context));
+        int64_t replicated_us = steady_now_us();
+        m.replicate_us.record(replicated_us - appended_us);
 
         if (!repl_ok) {
-            reply->set_success(false);
-            reply->set_global_pos(-1);
-            reply->set_message("Replication failed");
-            return Status::OK;
+            seq_.abandon_entries({local_idx});
+            seq_.tracer.span(trace_id, "Append", start_us, replicated_us, "replication failed");
+            return reject(reply, sequencer::APPEND_REPLICATION_FAILED);
         }
 
         // 3) assign global position
-        int64_t gp = seq_.assign_global_pos(local_idx);
+        int64_t pos = seq_.assign_global_pos(local_idx, trace_id);
+        int64_t done_us = steady_now_us();
+        if (trace_id) {
+            seq_.tracer.span(trace_id, "Append", start_us, done_us,
+                             "log=" + std::to_string(req->log_id()) + " client=" +
+                             std::to_string(req->client_id()) + " req=" +
+                             std::to_string(req->req_id()) + " pos=" + std::to_string(pos));
+        }
+        m.order_us.record(done_us - replicated_us);
+        m.append_us.record(done_us - start_us);
+        m.appends.add();
+        m.append_bytes.add(req->shard() ? req->record_size() : (int64_t)req->record().size());
 
         reply->set_success(true);
-        reply->set_global_pos(gp);
-        reply->set_message("Appended and replicated");
+        reply->set_global_pos(pos);
+        reply->set_message(shm_ring::status_message(sequencer::APPEND_OK));
+        return Status::OK;
+    }
+
+    Status AppendStream(ServerContext* context,
+                        ServerReaderWriter<AppendBatchReply, AppendBatch>* stream) override {
+        AppendBatch batch;
+        while (stream->Read(&batch)) {
+            gate_.pass();
+            AppendBatchReply reply;
+            Status refused;
+            bool ok = append_batch(context, batch, &reply, &refused);
+            if (!refused.ok()) return refused;
+            if (!stream->Write(reply) || !ok) break;
+        }
+        return Status::OK;
+    }
+
+    Status GetStats(ServerContext* context, const StatsRequest* req,
+                    StatsReply* reply) override {
+        gate_.pass();
+        SequencerMetrics &m = seq_.metrics;
+        int64_t now_us = steady_now_us();
+        int64_t appends = m.appends.value();
+        int64_t bytes = m.append_bytes.value();
+
+        reply->set_addr(seq_.self_addr);
+        reply->set_is_leader(seq_.is_leader.load());
+        reply->set_sealed(seq_.sealed.load());
+        reply->set_uptime_s((now_us - started_us_) / 1e6);
+        reply->set_appends_total(appends);
+        reply->set_append_bytes_total(bytes);
+        reply->set_append_failures_total(m.append_failures.value());
+        reply->set_overload_rejects_total(m.overload_rejects.value());
+        reply->set_quota_rejects_total(m.quota_rejects.value());
+        reply->set_quota_clients((int64_t)seq_.quotas.clients());
+        reply->set_inflight_entries(seq_.admission.entries());
+        reply->set_inflight_bytes(seq_.admission.bytes());
+        {
+            std::lock_guard<std::mutex> lk(scrape_mu_);
+            double window = std::max(now_us - scraped_us_, (int64_t)1) / 1e6;
+            reply->set_window_s(window);
+            reply->set_appends_per_sec((appends - scraped_appends_) / window);
+            reply->set_bytes_per_sec((bytes - scraped_bytes_) / window);
+            scraped_us_ = now_us;
+            scraped_appends_ = appends;
+            scraped_bytes_ = bytes;
+        }
+
+        add_latency(reply, "local_append", m.local_append_us.snapshot());
+        add_latency(reply, "replicate", m.replicate_us.snapshot());
+        add_latency(reply, "order", m.order_us.snapshot());
+        add_latency(reply, "append", m.append_us.snapshot());
+        add_latency(reply, "gc", m.gc_us.snapshot());
+        reply->set_gc_runs(m.gc_runs.value());
+        reply->set_gc_entries_total(m.gc_entries.value());
+        {
+            std::lock_guard<std::mutex> lk(seq_.mtx);
+            reply->set_gc_gp(seq_.state.gc_gp);
+        }
+        reply->set_checkpoint_gp(seq_.checkpoint_gp.load());
+
+        // only followers the leader currently replicates to
+        std::vector<std::string> followers = seq_.get_followers();
+        int64_t now_ms = steady_now_ms();
+        {
+            std::lock_guard<std::mutex> lk(m.followers_mtx);
+            for (const auto &addr : followers) {
+                auto *f = reply->add_followers();
+                f->set_addr(addr);
+                auto it = m.followers.find(addr);
+                if (it == m.followers.end()) {
+                    f->set_lag_entries(-1);
+                    f->set_rtt_us(-1);
+                    f->set_last_ack_age_ms(-1);
+                    continue;
+                }
+                f->set_lag_entries(it->second.lag_entries);
+                f->set_rtt_us(it->second.rtt_us);
+                f->set_rtt_p99_us(it->second.rtt_hist.value_at_percentile(99));
+                f->set_last_ack_age_ms(now_ms - it->second.last_ack_ms);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lk(seq_.mtx);
+            reply->set_view(seq_.state.view);
+            reply->set_last_ordered_gp(seq_.state.last_ordered_gp);
+            reply->set_stable_gp(seq_.state.stable_gp);
+            reply->set_log_entries(seq_.state.log.size());
+            reply->set_log_bytes(seq_.state.log.bytes());
+            reply->set_log_first_index(seq_.state.log.first_index());
+            reply->set_log_last_index(seq_.state.log.last_index());
+        }
+        reply->set_next_global_pos(seq_.next_global_pos.load());
+
+        reply->set_logs((int64_t)seq_.log_count());
+        int64_t next_pos, gc_pos, clients;
+        if (seq_.log_info(req->log_id(), &next_pos, &gc_pos, &clients)) {
+            auto *l = reply->mutable_log();
+            l->set_log_id(req->log_id());
+            l->set_next_pos(next_pos);
+            l->set_gc_pos(gc_pos);
+            l->set_clients(clients);
+        }
         return Status::OK;
     }
 
 private:
     Sequencer &seq_;
+    FaultGate &gate_;
+
+    // GetStats rate window
+    std::mutex scrape_mu_;
+    int64_t started_us_;
+    int64_t scraped_us_;
+    int64_t scraped_appends_ = 0;
+    int64_t scraped_bytes_ = 0;
+
+    // Append's checks and steps for every record of a batch, with one
+    // lock hold per step; records already ordered keep their positions.
+    // A batch over quota or past the in-flight limits ends the stream
+    // with *refused.
+    bool append_batch(ServerContext *context, const AppendBatch &batch, AppendBatchReply *reply,
+                      Status *refused) {
+        reply->set_first_req_id(batch.first_req_id());
+        sequencer::AppendStatus why = seq_.sealed.load() ? sequencer::APPEND_SEALED
+                                      : !seq_.is_leader.load() ? sequencer::APPEND_NOT_LEADER
+                                      : !seq_.lease_valid() ? sequencer::APPEND_LEASE_EXPIRED
+                                      : !seq_.admit_log(batch.log_id()) ? sequencer::APPEND_TOO_MANY_LOGS
+                                      : sequencer::APPEND_OK;
+        if (why != sequencer::APPEND_OK) return reject_batch(batch, reply, why);
+
+        std::vector<int64_t> positions(batch.records_size(), -1);
+        std::vector<Sequencer::BatchRecord> fresh;
+        std::vector<int> slots;
+        int64_t bytes = 0;
+        for (int i = 0; i < batch.records_size(); ++i) {
+            int req_id = batch.first_req_id() + i;
+            if (seq_.find_duplicate(batch.log_id(), batch.client_id(), req_id, &positions[i])) continue;
+            const std::string &rec = batch.records(i);
+            fresh.push_back(Sequencer::BatchRecord{batch.client_id(), req_id, batch.log_id(),
+                                                   rec.data(), rec.size()});
+            slots.push_back(i);
+            bytes += (int64_t)rec.size();
+        }
+        if (!fresh.empty()) {
+            // only the records still to be ordered count, as in Append
+            int n = (int)fresh.size();
+            if (int64_t wait_us = seq_.quotas.take(batch.client_id(), n, bytes)) {
+                *refused = over_quota(context, n, wait_us);
+                return false;
+            }
+            AdmissionControl::Ticket admitted(seq_.admission, n, bytes);
+            if (!admitted) {
+                seq_.quotas.give_back(batch.client_id(), n, bytes);
+                *refused = overloaded(context, n);
+                return false;
+            }
+            std::vector<int64_t> appended;
+            if (!seq_.append_batch(fresh, &appended, client_deadline_us(context))) {
+                return reject_batch(batch, reply, sequencer::APPEND_REPLICATION_FAILED);
+            }
+            for (size_t j = 0; j < slots.size(); ++j) positions[slots[j]] = appended[j];
+        }
+        reply->set_success(true);
+        reply->mutable_positions()->Add(positions.begin(), positions.end());
+        reply->set_status(fresh.empty() ? sequencer::APPEND_DUPLICATE : sequencer::APPEND_OK);
+        reply->set_message(shm_ring::status_message(reply->status()));
+        return true;
+    }
+
+    bool reject_batch(const AppendBatch &batch, AppendBatchReply *reply, sequencer::AppendStatus why) {
+        seq_.metrics.append_failures.add(batch.records_size());
+        reply->set_success(false);
+        reply->set_status(why);
+        reply->set_message(shm_ring::status_message(why));
+        reply->set_leader_addr(seq_.leader_hint());
+        reply->set_view(seq_.current_view());
+        return false;
+    }
+
+    // refused by admission control or a quota; the client retries after the hint
+    Status overloaded(ServerContext* context, int records) {
+        seq_.metrics.append_failures.add(records);
+        seq_.metrics.overload_rejects.add(records);
+        context->AddTrailingMetadata("retry-after-ms", std::to_string(seq_.admission.retry_after_ms()));
+        return Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "Too many appends in flight");
+    }
+
+    Status over_quota(ServerContext* context, int records, int64_t wait_us) {
+        seq_.metrics.append_failures.add(records);
+        seq_.metrics.quota_rejects.add(records);
+        context->AddTrailingMetadata("retry-after-ms", std::to_string((wait_us + 999) / 1000));
+        return Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "Client over quota");
+    }
+
+    Status reject(AppendReply* reply, sequencer::AppendStatus why) {
+        seq_.metrics.append_failures.add();
+        reply->set_success(false);
+        reply->set_global_pos(-1);
+        reply->set_status(why);
+        reply->set_message(shm_ring::status_message(why));
+        reply->set_leader_addr(seq_.leader_hint());
+        reply->set_view(seq_.current_view());
+        return Status::OK;
+    }
+
+    static void add_latency(StatsReply* reply, const char* stage, const HdrHistogram &h) {
+        auto *l = reply->add_latency();
+        l->set_stage(stage);
+        l->set_count(h.count());
+        l->set_p50_us(h.value_at_percentile(50));
+        l->set_p90_us(h.value_at_percentile(90));
+        l->set_p99_us(h.value_at_percentile(99));
+        l->set_p999_us(h.value_at_percentile(99.9));
+        l->set_max_us(h.max());
+        l->set_mean_us(h.mean());
+    }
 };
 
 // Implementation of internal service that followers expose
-class SequencerInternalImpl final : public SequencerInternal::Service {
+// ReplicateAppend, the per-append call, uses the callback API so its
+// messages come from an arena (see arena_allocator.h); it never blocks
+// beyond a short hold of the sequencer lock. The rest stay synchronous.
+class SequencerInternalImpl final
+    : public SequencerInternal::WithCallbackMethod_ReplicateAppend<SequencerInternal::Service> {
 public:
-    SequencerInternalImpl(Sequencer &s) : seq_(s) {}
+    SequencerInternalImpl(Sequencer &s, FaultGate &g) : seq_(s), gate_(g) {
+        SetMessageAllocatorFor_ReplicateAppend(&replicate_allocator_);
+    }
+
+    grpc::ServerUnaryReactor* ReplicateAppend(grpc::CallbackServerContext* context,
+                                              const ReplicateAppendRequest*,
+                                              ReplicateAppendReply* reply) override {
+        // Follower: place at the leader's local index (buffer past a gap) and
+        // ack. The request lives until Finish, so handle_replicate moves the
+        // record out of it whether this runs inline or deferred.
+        ReplicateAppendRequest* req = decltype(replicate_allocator_)::mutable_request(context);
+        grpc::ServerUnaryReactor* reactor = context->DefaultReactor();
+        gate_.defer([this, req, reply, reactor] {
+            seq_.handle_replicate(req, reply);
+            reactor->Finish(Status::OK);
+        });
+        return reactor;
+    }
 
-    Status ReplicateAppend(ServerContext* context, const ReplicateAppendRequest* req,
-                           ReplicateAppendReply* reply) override {
-        // Follower: append to local log and ack
-        int local_idx = seq_.append_local_entry(req->client_id(), req->req_id(), req->record());
-        std::cout << "[FOLLOWER] Received ReplicateAppend local_idx=" << local_idx << "\n";
+    Status Heartbeat(ServerContext* context, const HeartbeatRequest* req,
+                     HeartbeatReply* reply) override {
+        gate_.pass();
+        // a leader from an older view is fenced off; a newer one deposes us
+        if (seq_.is_leader.load()) seq_.fence_if_superseded(req->view());
+        bool current = seq_.accept_view(req->view());
+        reply->set_view(seq_.current_view());
+        // a node that believes it leads does not vouch for another leader
+        if (!current || seq_.is_leader.load()) {
+            reply->set_ok(false);
+            return Status::OK;
+        }
+        seq_.last_heartbeat_ms.store(steady_now_ms());
+        seq_.leader_gc_gp.store(req->gc_gp());
+        reply->set_next_index(seq_.note_leader_progress(req->leader_addr(), req->last_local_index()));
+        reply->set_repl_port(seq_.repl_port.load());
         reply->set_ok(true);
-        reply->set_message("OK");
+        return Status::OK;
+    }
+
+    Status FetchEntries(ServerContext* context, const FetchEntriesRequest* req,
+                        ServerWriter<FetchEntriesReply>* writer) override {
+        gate_.pass();
+        return seq_.serve_fetch(*req, writer);
+    }
+
+    Status GetSnapshot(ServerContext* context, const SnapshotRequest* req,
+                       SnapshotReply* reply) override {
+        gate_.pass();
+        seq_.fill_snapshot(*req, reply);
+        return Status::OK;
+    }
+
+    Status SealView(ServerContext* context, const SealViewRequest* req,
+                    SealViewReply* reply) override {
+        gate_.pass();
+        seq_.handle_seal_view(*req, reply);
+        // a new leader sealing us is alive even though it sends no
+        // heartbeats until its view change is done
+        if (reply->ok()) seq_.last_heartbeat_ms.store(steady_now_ms());
+        return Status::OK;
+    }
+
+    Status NewView(ServerContext* context, const NewViewRequest* req,
+                   NewViewReply* reply) override {
+        gate_.pass();
+        seq_.handle_new_view(*req, reply);
+        if (reply->ok()) seq_.last_heartbeat_ms.store(steady_now_ms());
         return Status::OK;
     }
 
 private:
     Sequencer &seq_;
+    FaultGate &gate_;
+    ArenaMessageAllocator<ReplicateAppendRequest, ReplicateAppendReply> replicate_allocator_;
 };
 
 // Utility: parse followers string "a:b,c:d"
@@ -119,59 +578,77 @@ static std::vector<std::string> parse_followers(const std::string &s) {
     return res;
 }
 
-// Connect to ZooKeeper and create an ephemeral znode for this replica.
-// The znode stays alive as long as this process stays connected.
-zhandle_t* zk_register_replica(const std::string& zk_addr,
-                               const std::string& znode_path,
-                               const std::string& data)
-{
-    int timeout_ms = 30000;
-    zhandle_t* zh = zookeeper_init(zk_addr.c_str(), nullptr, timeout_ms, 0, nullptr, 0);
-    if (!zh) {
-        std::cerr << "[ZK] ERROR: Could not connect to ZooKeeper at " << zk_addr << "\n";
-        return nullptr;
+// Wake-up channel between coordinator watch callbacks (its event thread)
+// and the election thread. A watch is one-shot, so every notification just
+// marks the election as dirty and the election thread re-evaluates and
+// re-arms. stop is set by SequencerServer::Shutdown.
+struct ElectionWatch {
+    std::mutex mu;
+    std::condition_variable cv;
+    bool changed = false;
+    bool stop = false;
+    int64_t deleted_at_ms = 0;   // when a watched node was seen deleted
+
+    void notify(CoordEvent type, const std::string &path) {
+        if (type == CoordEvent::SESSION_EXPIRED) {
+            std::cerr << "[ZK] Session expired; election node is gone.\n";
+        } else if (type == CoordEvent::DELETED) {
+            std::cout << "[ELECTION] watched node deleted: " << path << "\n";
+        }
+        {
+            std::lock_guard<std::mutex> lk(mu);
+            changed = true;
+            if (type == CoordEvent::DELETED) deleted_at_ms = steady_now_ms();
+        }
+        cv.notify_one();
     }
+};
 
+// Create a persistent node, ignoring one that already exists.
+static void ensure_path(Coordinator* coord, const std::string &path) {
+    CoordRc rc = coord->create(path, "", Coordinator::PERSISTENT);
+    if (rc != CoordRc::OK && rc != CoordRc::NODE_EXISTS) {
+        std::cerr << "[ZK] Warning: Cannot create " << path << ": " << coord_rc_str(rc) << "\n";
+    }
+}
+
+// Create an ephemeral znode for this replica. The znode stays alive as long
+// as the coordinator session does.
+static bool register_replica(Coordinator* coord, const std::string& znode_path,
+                             const std::string& data)
+{
     // Retry create (session may take a short time to become CONNECTED)
     const int MAX_ATTEMPTS = 5;
-    int rc = ZCONNECTIONLOSS;
+    CoordRc rc = CoordRc::ERROR;
     for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
-        rc = zoo_create(zh,
-                        znode_path.c_str(),
-                        data.c_str(),
-                        data.size(),
-                        &ZOO_OPEN_ACL_UNSAFE,
-                        ZOO_EPHEMERAL,
-                        nullptr,
-                        0);
-        if (rc == ZOK) {
+        rc = coord->create(znode_path, data, Coordinator::EPHEMERAL);
+        if (rc == CoordRc::OK) {
             std::cout << "[ZK] Registered replica at " << znode_path << "\n";
             break;
         }
-        if (rc == ZNODEEXISTS) {
+        if (rc == CoordRc::NODE_EXISTS) {
             // for a quick demo: try delete and recreate once
             std::cerr << "[ZK] Warning: znode already exists at " << znode_path
                       << " (attempt " << attempt << "), trying delete+recreate\n";
-            int d = zoo_delete(zh, znode_path.c_str(), -1);
-            if (d != ZOK) {
-                std::cerr << "[ZK] Warning: failed to delete existing znode rc=" << d << "\n";
+            CoordRc d = coord->remove(znode_path);
+            if (d != CoordRc::OK) {
+                std::cerr << "[ZK] Warning: failed to delete existing znode: " << coord_rc_str(d) << "\n";
                 // fallthrough to retry which may succeed later
             } else {
                 std::this_thread::sleep_for(std::chrono::milliseconds(50));
                 continue; // try create again immediately
             }
         } else {
-            std::cerr << "[ZK] create attempt " << attempt << " failed rc=" << rc << "\n";
+            std::cerr << "[ZK] create attempt " << attempt << " failed: " << coord_rc_str(rc) << "\n";
         }
         std::this_thread::sleep_for(std::chrono::milliseconds(200));
     }
 
-    if (rc != ZOK) {
+    if (rc != CoordRc::OK) {
         std::cerr << "[ZK] ERROR: Failed to create ephemeral znode " << znode_path
-                  << " rc=" << rc << "\n";
+                  << ": " << coord_rc_str(rc) << "\n";
     }
-
-    return zh;   // keep the handle alive!
+    return rc == CoordRc::OK;
 }
 
 
@@ -180,7 +657,7 @@ zhandle_t* zk_register_replica(const std::string& zk_addr,
 // Create ephemeral sequential znode under base_path (e.g. "/lazylog/election")
 // returns full created path on success, empty string on failure.
 // out_node_name will contain just the last path component (e.g. "node-0000000003")
-static std::string zk_create_ephemeral_sequential(zhandle_t* zh,
+static std::string zk_create_ephemeral_sequential(Coordinator* coord,
                                                   const std::string &base_path,
                                                   const std::string &data,
                                                   std::string &out_node_name)
@@ -190,21 +667,12 @@ static std::string zk_create_ephemeral_sequential(zhandle_t* zh,
     if (prefix.back() == '/') prefix.pop_back();
     prefix += "/node-";
 
-    char created_path[512];
-    int buf_len = sizeof(created_path);
-    int rc = zoo_create(zh,
-                        prefix.c_str(),
-                        data.c_str(),
-                        data.size(),
-                        &ZOO_OPEN_ACL_UNSAFE,
-                        ZOO_EPHEMERAL | ZOO_SEQUENCE,
-                        created_path,
-                        buf_len);
-    if (rc != ZOK) {
-        std::cerr << "[ZK] ERROR: create sequential node failed rc=" << rc << "\n";
+    std::string full;
+    CoordRc rc = coord->create(prefix, data, Coordinator::EPHEMERAL | Coordinator::SEQUENTIAL, &full);
+    if (rc != CoordRc::OK) {
+        std::cerr << "[ZK] ERROR: create sequential node failed: " << coord_rc_str(rc) << "\n";
         return "";
     }
-    std::string full(created_path);
     // extract last component
     size_t pos = full.find_last_of('/');
     if (pos == std::string::npos) out_node_name = full;
@@ -214,22 +682,82 @@ static std::string zk_create_ephemeral_sequential(zhandle_t* zh,
 }
 
 // List children of a path into a vector<string>. Returns true on success.
-static bool zk_list_children(zhandle_t* zh, const std::string &path, std::vector<std::string> &out_children)
+static bool zk_list_children(Coordinator* coord, const std::string &path, std::vector<std::string> &out_children)
 {
-    struct String_vector sv;
-    int rc = zoo_get_children(zh, path.c_str(), 0, &sv);
-    if (rc != ZOK) {
-        std::cerr << "[ZK] ERROR: get_children " << path << " rc=" << rc << "\n";
+    CoordRc rc = coord->children(path, &out_children);
+    if (rc != CoordRc::OK) {
+        std::cerr << "[ZK] ERROR: get_children " << path << ": " << coord_rc_str(rc) << "\n";
         return false;
     }
-    out_children.clear();
-    for (int i = 0; i < sv.count; ++i) {
-        out_children.emplace_back(sv.data[i]);
+    return true;
+}
+
+// Addresses stored as data of the children of path (each replica's znode
+// holds its address), excluding self_addr.
+static std::vector<std::string> zk_read_members(Coordinator* coord, const std::string &path,
+                                                const std::vector<std::string> &children,
+                                                const std::string &self_addr)
+{
+    std::vector<std::string> out;
+    for (const auto &child : children) {
+        std::string addr;
+        if (coord->get(path + "/" + child, &addr) != CoordRc::OK || addr.empty()) continue;
+        if (addr == self_addr) continue;
+        if (std::find(out.begin(), out.end(), addr) == out.end()) out.push_back(addr);
+    }
+    return out;
+}
+
+struct MembershipWatch {
+    std::mutex mu;
+    std::condition_variable cv;
+    bool changed = false;
+    bool stop = false;
+
+    void notify() {
+        {
+            std::lock_guard<std::mutex> lk(mu);
+            changed = true;
+        }
+        cv.notify_one();
     }
-    deallocate_String_vector(&sv); // free memory allocated by ZK client
+};
+
+// One listing of replicas_path that also (re)arms the child watch.
+static bool zk_sync_membership(Coordinator* coord, Sequencer* seq_ptr, const std::string &replicas_path,
+                               MembershipWatch* watch) {
+    std::vector<std::string> children;
+    CoordRc rc = coord->children(replicas_path, &children,
+                                 [watch](CoordEvent, const std::string &) { watch->notify(); });
+    if (rc != CoordRc::OK) {
+        std::cerr << "[ZK] ERROR: wget_children " << replicas_path << ": " << coord_rc_str(rc) << "\n";
+        return false;
+    }
+    seq_ptr->update_membership(zk_read_members(coord, replicas_path, children, seq_ptr->self_addr));
     return true;
 }
 
+// Membership loop: keeps the Sequencer's view of the registered replicas
+// (/lazylog/replicas) current with a child watch, so replicas can be added
+// or replaced while the leader keeps serving. Only ZK events wake it.
+static void membership_loop(Coordinator* coord, Sequencer* seq_ptr, const std::string &replicas_path,
+                            MembershipWatch* watch_ptr) {
+    MembershipWatch &watch = *watch_ptr;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lk(watch.mu);
+            watch.cv.wait(lk, [&] { return watch.changed || watch.stop; });
+            if (watch.stop) return;
+            watch.changed = false;
+        }
+        while (!zk_sync_membership(coord, seq_ptr, replicas_path, &watch)) {
+            if (coord->session_expired()) return;
+            std::unique_lock<std::mutex> lk(watch.mu);
+            if (watch.cv.wait_for(lk, std::chrono::milliseconds(500), [&] { return watch.stop; })) return;
+        }
+    }
+}
+
 // Helper that returns numeric suffix of a sequential node like "node-0000000003" -> 3.
 // If parse fails returns a large value.
 static unsigned long parse_seq_suffix(const std::string &name) {
@@ -247,45 +775,129 @@ static unsigned long parse_seq_suffix(const std::string &name) {
     }
 }
 
-// Election loop: create sequential znode and repeatedly check smallest child.
-// If this node is smallest -> become leader, else follower.
-// Runs until process exits.
-static void election_loop(zhandle_t* zh, Sequencer* seq_ptr, const std::string &election_path, const std::string &my_node_name, int poll_ms=500) {
-    if (!zh || !seq_ptr) return;
+// Election loop (herd-free recipe): list children once, sort by sequence
+// number and, unless we are the smallest, set a one-shot watch on our
+// immediate predecessor only. The thread then sleeps until that watch fires,
+// so an idle cluster generates no ZK reads and a leader crash only wakes the
+// single replica next in line.
+//
+// Fast failover: when the predecessor is the leader and leases are enabled,
+// the wait is bounded and the follower checks the leader's heartbeats. After
+// lease_ms of silence it deletes the leader's node itself instead of waiting
+// for the ZK session to expire. A live-but-partitioned leader sees its own
+// node disappear, steps down and rejoins at the back of the line.
+// Runs until the server shuts down (watch.stop).
+static void election_loop(Coordinator* coord, Sequencer* seq_ptr, ElectionWatch* watch_ptr,
+                          const std::string &election_path, const std::string &my_node_name,
+                          const std::string &node_data, int view_change_timeout_ms) {
+    if (!coord || !seq_ptr) return;
 
     std::string my_node = my_node_name; // e.g. node-0000000003
+    ElectionWatch &watch = *watch_ptr;
+    auto on_event = [watch_ptr](CoordEvent type, const std::string &path) {
+        watch_ptr->notify(type, path);
+    };
+    coord->on_session_expired([watch_ptr] { watch_ptr->notify(CoordEvent::SESSION_EXPIRED, ""); });
+
+    const int retry_ms = 200;
+    std::string watched;
+    bool expired = false;
+
+    // failover timeline (steady-clock ms, 0 = unknown)
+    int64_t leader_last_alive = 0;   // last heartbeat seen from the old leader
+    int64_t detected_at = 0;         // old leader found dead (watch or lease)
+    bool leader_silent = false;      // re-listed because heartbeats stopped
+
+    auto stopped_after = [&](int ms) {
+        std::unique_lock<std::mutex> lk(watch.mu);
+        return watch.cv.wait_for(lk, std::chrono::milliseconds(ms), [&] { return watch.stop; });
+    };
 
     while (true) {
+        {
+            std::lock_guard<std::mutex> lk(watch.mu);
+            if (watch.stop) return;
+        }
+        if (coord->session_expired()) {
+            // ZK already deleted our ephemeral node and a successor may be
+            // leading: fence ourselves and stop taking part in the election.
+            if (!expired) {
+                if (seq_ptr->is_leader.load()) {
+                    seq_ptr->become_follower();
+                    std::cout << "[ELECTION] stepping down (node=" << my_node << ")\n";
+                }
+                seq_ptr->seal_view();
+                std::cerr << "[ELECTION] session expired, leaving election.\n";
+                expired = true;
+            }
+            std::unique_lock<std::mutex> lk(watch.mu);
+            watch.cv.wait(lk, [&] { return watch.changed || watch.stop; });
+            watch.changed = false;
+            continue;
+        }
+
         std::vector<std::string> children;
-        bool ok = zk_list_children(zh, election_path, children);
-        if (!ok) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(poll_ms));
+        if (!zk_list_children(coord, election_path, children)) {
+            if (stopped_after(retry_ms)) return;
             continue;
         }
 
-        // DEBUG: print children seen by this node
-        std::cout << "[ELECTION][DEBUG] children under " << election_path << ":";
-        for (auto &c : children) std::cout << " " << c;
-        std::cout << "\n";
+        std::sort(children.begin(), children.end(),
+                  [](const std::string &a, const std::string &b) {
+                      return parse_seq_suffix(a) < parse_seq_suffix(b);
+                  });
 
-        // find smallest by numeric suffix
-        unsigned long min_val = ULONG_MAX;
-        std::string min_node;
-        for (auto &c : children) {
-            unsigned long v = parse_seq_suffix(c);
-            if (v < min_val) {
-                min_val = v;
-                min_node = c;
-            }
-        }
+        auto me = std::find(children.begin(), children.end(), my_node);
+        std::string to_watch;
 
-        if (!min_node.empty() && min_node == my_node) {
-            // I'm the leader
+        if (me == children.end()) {
+            // our node was deleted while the session is alive (preempted by
+            // a successor or removed by an admin): step down and rejoin.
+            std::cerr << "[ELECTION] own node " << my_node
+                      << " missing under " << election_path << ", rejoining\n";
+            if (seq_ptr->is_leader.load()) {
+                seq_ptr->become_follower();
+                std::cout << "[ELECTION] stepping down (node=" << my_node << ")\n";
+            }
+            seq_ptr->seal_view();
+            std::string new_node;
+            if (zk_create_ephemeral_sequential(coord, election_path, node_data, new_node).empty()) {
+                if (stopped_after(retry_ms)) return;
+            } else {
+                my_node = new_node;
+            }
+            continue;
+        } else if (me == children.begin()) {
+            // I'm the leader; watch my own node so an external delete
+            // (admin or lease expiry) makes this node step down.
             if (!seq_ptr->is_leader.load()) {
-                seq_ptr->become_leader();   // will unseal
+                int64_t elected_at = steady_now_ms();
+                seq_ptr->become_leader();
+                // replicate to every registered replica, recover the old
+                // view's tail from them, then open for appends
+                seq_ptr->set_followers(seq_ptr->get_registered());
+                // the election sequence is our epoch: it only grows, so
+                // every later leader opens a strictly higher view
+                seq_ptr->run_view_change((int64_t)parse_seq_suffix(my_node) + 1,
+                                         view_change_timeout_ms);
                 seq_ptr->unseal_view();
+                int64_t unsealed_at = steady_now_ms();
                 std::cout << "[ELECTION] elected leader (node=" << my_node << ")\n";
+
+                if (detected_at > 0) {
+                    FailoverStats f;
+                    f.detect_ms = leader_last_alive > 0 ? detected_at - leader_last_alive : -1;
+                    f.elect_ms = elected_at - detected_at;
+                    f.seal_ms = unsealed_at - elected_at;
+                    f.total_ms = unsealed_at - (leader_last_alive > 0 ? leader_last_alive : detected_at);
+                    seq_ptr->record_failover(f);
+                    std::cout << "[FAILOVER] detect_ms=" << f.detect_ms
+                              << " elect_ms=" << f.elect_ms
+                              << " seal_ms=" << f.seal_ms
+                              << " total_ms=" << f.total_ms << "\n";
+                }
             }
+            to_watch = my_node;
         } else {
             // I'm a follower
             if (seq_ptr->is_leader.load()) {
@@ -293,47 +905,245 @@ static void election_loop(zhandle_t* zh, Sequencer* seq_ptr, const std::string &
                 seq_ptr->become_follower();
                 seq_ptr->seal_view();
                 std::cout << "[ELECTION] stepping down (node=" << my_node << ")\n";
-            } else {
+            } else if (!seq_ptr->sealed.load()) {
                 // ensure follower is sealed
                 seq_ptr->seal_view();
             }
+            to_watch = *(me - 1);
         }
+        detected_at = 0;
+        leader_last_alive = 0;
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(poll_ms));
+        int64_t watch_since = steady_now_ms();
+        // re-listed after the leader went quiet: it has heartbeated us
+        // before, so arm the lease check now and give it one more lease
+        bool heard_leader = leader_silent;
+        leader_silent = false;
+        if (!to_watch.empty()) {
+            std::string watch_path = election_path + "/" + to_watch;
+            CoordRc rc = coord->exists(watch_path, on_event);
+            if (rc == CoordRc::NO_NODE) {
+                // predecessor went away between list and watch: re-evaluate now
+                continue;
+            }
+            if (rc != CoordRc::OK) {
+                std::cerr << "[ZK] ERROR: wexists " << watch_path << ": " << coord_rc_str(rc) << "\n";
+                if (stopped_after(retry_ms)) return;
+                continue;
+            }
+            if (to_watch != watched) {
+                std::cout << "[ELECTION] watching " << watch_path << "\n";
+                watched = to_watch;
+            }
+        }
+
+        // predecessor is the leader: we are responsible for detecting its death
+        bool guard_leader = (seq_ptr->lease_ms > 0 && me != children.begin() &&
+                             (me - 1) == children.begin());
+
+        // further back in line we are only woken by our predecessor's watch,
+        // which misses the predecessor becoming leader through a failover
+        // we took no part in; if the leader then goes quiet, re-list so the
+        // replica now next in line starts guarding it
+        bool watch_silence = (seq_ptr->lease_ms > 0 && !guard_leader && me != children.begin());
+
+        std::unique_lock<std::mutex> lk(watch.mu);
+        while (!watch.changed && !watch.stop) {
+            if (!guard_leader && !watch_silence) {
+                watch.cv.wait(lk);
+                continue;
+            }
+            int poll_ms = guard_leader ? std::max(seq_ptr->lease_ms / 4, 10) : seq_ptr->lease_ms;
+            watch.cv.wait_for(lk, std::chrono::milliseconds(poll_ms));
+            if (watch.changed || watch.stop) break;
+
+            // only armed once this leader has heartbeated us at least once,
+            // so a leader that does not know about us is never preempted
+            int64_t hb = seq_ptr->last_heartbeat_ms.load();
+            int64_t now = steady_now_ms();
+            if (watch_silence) {
+                if (hb > watch_since && now - hb > seq_ptr->lease_ms) {
+                    leader_silent = true;
+                    break;
+                }
+                continue;
+            }
+            if ((hb > watch_since || heard_leader) &&
+                now - std::max(hb, watch_since) > seq_ptr->lease_ms) {
+                lk.unlock();
+                std::string leader_path = election_path + "/" + to_watch;
+                std::cout << "[FAILOVER] no heartbeat from leader for " << (now - hb)
+                          << " ms, deleting " << leader_path << "\n";
+                leader_last_alive = hb;
+                detected_at = now;
+                CoordRc rc = coord->remove(leader_path);
+                if (rc != CoordRc::OK && rc != CoordRc::NO_NODE) {
+                    std::cerr << "[ZK] ERROR: delete " << leader_path << ": " << coord_rc_str(rc) << "\n";
+                }
+                lk.lock();
+                guard_leader = false;   // the deletion fires our watch
+            }
+        }
+        watch.changed = false;
+        if (detected_at == 0 && watch.deleted_at_ms > 0) {
+            // predecessor vanished through ZK session expiry
+            detected_at = watch.deleted_at_ms;
+            leader_last_alive = seq_ptr->last_heartbeat_ms.load();
+            if (leader_last_alive < watch_since) leader_last_alive = 0;
+        }
+        watch.deleted_at_ms = 0;
     }
 }
 
+// Leader-side heartbeat pump; idle on followers and while a new leader is
+// still sealed in its view change (followers already sealed into the new
+// view would answer with a view we have not installed yet and fence us).
+// Runs until stop is set.
+static void heartbeat_loop(Sequencer* seq_ptr, int interval_ms, FaultGate* gate,
+                           std::atomic<bool>* stop) {
+    while (!stop->load()) {
+        gate->pass();
+        if (seq_ptr->is_leader.load() && !seq_ptr->sealed.load() && !stop->load()) {
+            seq_ptr->heartbeat_followers(interval_ms);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    }
+}
 
+// Background GC, on leader and followers alike. Each round truncates up
+// to gc_safe_gp in bounded steps and releases mtx between them; a sealed
+// leader waits until its view change is done. Runs until stop is set.
+static void gc_loop(Sequencer* seq_ptr, int interval_ms, int step_entries, int retain_entries,
+                    FaultGate* gate, std::atomic<bool>* stop) {
+    while (!stop->load()) {
+        // short naps so Shutdown is not held up by a long interval
+        for (int slept = 0; slept < interval_ms && !stop->load(); slept += 50) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(std::min(50, interval_ms - slept)));
+        }
+        gate->pass();
+        if (stop->load() || (seq_ptr->is_leader.load() && seq_ptr->sealed.load())) continue;
+        int64_t gp = seq_ptr->gc_safe_gp(retain_entries);
+        int64_t dropped = 0;
+        int n;
+        while (!stop->load() && (n = seq_ptr->gc_step(gp, step_entries)) > 0) {
+            dropped += n;
+            if (n < step_entries) break;
+            std::this_thread::yield();
+        }
+        if (dropped > 0) {
+            std::cout << "[GC] dropped " << dropped << " entries up to gp " << gp << "\n";
+        }
+    }
+}
 
+// Periodic checkpoint of the sequencer metadata to path. Skips rounds in
+// which nothing it records has moved. Runs until stop is set.
+static void checkpoint_loop(Sequencer* seq_ptr, std::string path, int interval_ms,
+                            std::atomic<bool>* stop) {
+    int64_t last_gp = LLONG_MIN, last_view = -1, last_gc = LLONG_MIN;
+    while (!stop->load()) {
+        for (int slept = 0; slept < interval_ms && !stop->load(); slept += 50) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(std::min(50, interval_ms - slept)));
+        }
+        if (stop->load()) break;
+        int64_t start_us = steady_now_us();
+        sequencer_internal::Checkpoint ckpt = seq_ptr->take_checkpoint();
+        if (ckpt.last_ordered_gp() == last_gp && ckpt.view() == last_view &&
+            ckpt.gc_gp() == last_gc) {
+            continue;
+        }
+        if (!write_checkpoint_file(path, ckpt)) continue;
+        seq_ptr->note_checkpoint_written(ckpt);
+        last_gp = ckpt.last_ordered_gp();
+        last_view = ckpt.view();
+        last_gc = ckpt.gc_gp();
+        std::cout << "[CKPT] wrote " << path << ": view=" << ckpt.view()
+                  << " last_ordered_gp=" << ckpt.last_ordered_gp() << " dedup="
+                  << ckpt.dedup_size() << " in " << steady_now_us() - start_us << " us\n";
+    }
+}
 
-
-void SequencerServer::Run(const std::string& role, int port, const std::vector<std::string>& followers) {
-    std::string addr = "0.0.0.0:" + std::to_string(port);
+struct SequencerServer::Impl {
+    ServerConfig cfg;
     Sequencer seq;
-    GLOBAL_SEQ_PTR = &seq;
-    signal(SIGUSR1, handle_seal_signal);
+    FaultGate gate;
+    std::unique_ptr<Coordinator> coord;
+    std::unique_ptr<SequencerServiceImpl> service;
+    std::unique_ptr<SequencerInternalImpl> internal_service;
+    std::unique_ptr<Server> server;
+    int port = 0;
+    std::unique_ptr<TcpReplicationServer> repl_server;   // repl_transport = "tcp"
+    std::unique_ptr<ShmIngest> shm;                      // shm_name set
 
-    // follower list
-    if (!followers.empty()) seq.followers = followers;
-    bool is_leader = (role == "leader");   // only used for initial boot
+    // background loops; watched objects outlive the coordinator session
+    ElectionWatch election_watch;
+    MembershipWatch membership_watch;
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    bool shut_down = false;
+};
 
-    // -----------------------------------------
-    // ---- ZooKeeper registration for replica ----
-    // -----------------------------------------
-    std::string zk_addr = "127.0.0.1:2181";
-    std::string replica_path = "/lazylog/replicas/replica-" + std::to_string(port);
-    std::string replica_data = "127.0.0.1:" + std::to_string(port);
+SequencerServer::SequencerServer() : impl_(new Impl()) {}
 
-    zhandle_t* zk_handle = zk_register_replica(zk_addr, replica_path, replica_data);
-    if (!zk_handle) {
-        std::cerr << "[ZK] WARNING: Replica registration failed (continuing without ZK)\n";
+SequencerServer::~SequencerServer() { Shutdown(); }
+
+Sequencer& SequencerServer::sequencer() { return impl_->seq; }
+
+int SequencerServer::port() const { return impl_->port; }
+
+std::string SequencerServer::address() const { return impl_->seq.self_addr; }
+
+void SequencerServer::Pause() {
+    std::cout << "[FAULT] " << address() << " paused\n";
+    impl_->gate.set_paused(true);
+}
+
+void SequencerServer::Resume() {
+    std::cout << "[FAULT] " << address() << " resumed\n";
+    impl_->gate.set_paused(false);
+}
+
+void SequencerServer::SetDelay(int ms) { impl_->gate.set_delay(ms); }
+
+void SequencerServer::Run(const ServerConfig& cfg) {
+    GLOBAL_SEQ_PTR = &impl_->seq;
+    signal(SIGUSR1, handle_seal_signal);
+    if (!Start(cfg)) return;
+    Wait();
+}
+
+bool SequencerServer::Start(const ServerConfig& cfg, std::unique_ptr<Coordinator> coord) {
+    Impl &s = *impl_;
+    s.cfg = cfg;
+    Sequencer &seq = s.seq;
+    const std::string &role = cfg.role;
+
+    // follower list
+    // static seed; replaced by /lazylog/replicas once ZK is reachable
+    seq.set_followers(cfg.followers);
+    seq.update_membership(cfg.followers);
+    seq.lease_ms = cfg.lease_ms;
+    seq.max_logs = cfg.max_logs;
+    seq.repl_timeout_ms = cfg.repl_timeout_ms;
+    seq.admission.max_entries = cfg.max_inflight_entries;
+    seq.admission.max_bytes = cfg.max_inflight_bytes;
+    seq.admission.wait_ms = cfg.admission_wait_ms;
+    std::unordered_map<int32_t, ClientQuotas::Rates> quota_overrides;
+    if (!ClientQuotas::parse_overrides(cfg.client_quotas, &quota_overrides)) {
+        std::cerr << "[QUOTA] ignoring malformed --client_quotas=" << cfg.client_quotas << "\n";
+        quota_overrides.clear();
     }
+    seq.quotas.configure(ClientQuotas::Rates{cfg.client_records_per_s, cfg.client_bytes_per_s},
+                         cfg.client_burst_ms, cfg.quota_slots, std::move(quota_overrides));
+    seq.set_repl_hedge(cfg.repl_hedge);
+    bool is_leader = (role == "leader");   // only used for initial boot
 
     // -----------------------------------------
     // ---- Initial explicit role state ----
     // -----------------------------------------
     if (is_leader) {
-        seq.become_leader();  // unseals
+        seq.become_leader();
+        seq.unseal_view();
         std::cout << "[INIT] Node started as LEADER (temporary), view unsealed.\n";
     } else {
         seq.become_follower();
@@ -342,36 +1152,125 @@ void SequencerServer::Run(const std::string& role, int port, const std::vector<s
     }
 
     // -----------------------------------------
-    // ---- Leader Election Setup (ZK sequential) ----
+    // ---- Recover from this replica's checkpoint ----
     // -----------------------------------------
-    if (zk_handle) {
-        std::string election_path = "/lazylog/election";
+    // before serving, so no peer sees the pre-recovery state; a replica on
+    // a fresh ephemeral port has no past to recover
+    if (!cfg.checkpoint_dir.empty() && cfg.port != 0) {
+        sequencer_internal::Checkpoint ckpt;
+        std::string path = cfg.checkpoint_dir + "/checkpoint-" + std::to_string(cfg.port);
+        if (read_checkpoint_file(path, &ckpt)) seq.restore_checkpoint(ckpt);
+    }
+    // from here on every dedup change is marked, so checkpoints copy only those
+    seq.track_dedup_changes = !cfg.checkpoint_dir.empty() && cfg.checkpoint_interval_ms > 0;
 
-        // Ensure election path exists (ignore error if exists)
-        int mk_rc = zoo_create(zk_handle, election_path.c_str(), "",
-                               0, &ZOO_OPEN_ACL_UNSAFE, 0, nullptr, 0);
+    // -----------------------------------------
+    // ---- Start gRPC server ----
+    // -----------------------------------------
+    // bound before registering so the advertised address is reachable;
+    // port 0 asks the OS for a free port
+    std::string addr = "0.0.0.0:" + std::to_string(cfg.port);
+    s.service.reset(new SequencerServiceImpl(seq, s.gate));
+    s.internal_service.reset(new SequencerInternalImpl(seq, s.gate));
 
-        if (mk_rc != ZOK && mk_rc != ZNODEEXISTS) {
-            std::cerr << "[ZK] Warning: Cannot create " << election_path << " rc=" << mk_rc << "\n";
+    ServerBuilder builder;
+    builder.AddListeningPort(addr, grpc::InsecureServerCredentials(), &s.port);
+    int uds_bound = 0;
+    if (!cfg.uds.empty()) {
+        builder.AddListeningPort(uds_target(cfg.uds), grpc::InsecureServerCredentials(), &uds_bound);
+    }
+    builder.RegisterService(s.service.get());
+    builder.RegisterService(s.internal_service.get());
+
+    s.server = builder.BuildAndStart();
+    if (!s.server || s.port == 0 || (!cfg.uds.empty() && uds_bound == 0)) {
+        std::cerr << "[" << role << "] ERROR: cannot listen on " << addr
+                  << (cfg.uds.empty() ? "" : " and " + uds_target(cfg.uds)) << "\n";
+        return false;
+    }
+    seq.self_addr = "127.0.0.1:" + std::to_string(s.port);
+    std::cout << "[" << role << "] Server listening on 0.0.0.0:" << s.port
+              << (cfg.uds.empty() ? "" : " and " + uds_target(cfg.uds)) << "\n";
+
+    if (cfg.repl_transport == "tcp") {
+        s.repl_server.reset(new TcpReplicationServer(
+            [&s](ReplicateAppendRequest *req, ReplicateAppendReply *reply) {
+                s.gate.pass();
+                s.seq.handle_replicate(req, reply);
+            }));
+        int repl_port = s.repl_server->start(cfg.repl_tcp_port);
+        if (repl_port == 0) return false;
+        seq.repl_port.store(repl_port);
+        seq.tcp_transport.reset(new TcpReplicationClient(cfg.repl_tcp_timeout_ms));
+        std::cout << "[REPL] TCP replication on port " << repl_port << "\n";
+    }
+
+    if (!cfg.shm_name.empty()) {
+        s.shm.reset(new ShmIngest(seq, [&s] { s.gate.pass(); }));
+        if (!s.shm->start(cfg.shm_name, std::max(cfg.shm_rings, 1), std::max(cfg.shm_ring_bytes, 0))) {
+            return false;
         }
+    }
+
+    if (cfg.trace_sample > 0) {
+        seq.tracer.open(cfg.trace_dir + "/lazylog-trace-" + std::to_string(s.port) + ".json",
+                        cfg.trace_sample, s.port, "replica " + seq.self_addr);
+    }
+
+    // -----------------------------------------
+    // ---- ZooKeeper registration for replica ----
+    // -----------------------------------------
+    std::string replica_path = "/lazylog/replicas/replica-" + std::to_string(s.port);
+    std::string replica_data = seq.self_addr;
+
+    s.coord = coord ? std::move(coord) : make_zk_coordinator(cfg.zk_addr, cfg.zk_session_timeout_ms);
+    if (s.coord) {
+        ensure_path(s.coord.get(), "/lazylog");
+        ensure_path(s.coord.get(), "/lazylog/replicas");
+        if (!register_replica(s.coord.get(), replica_path, replica_data)) {
+            std::cerr << "[ZK] WARNING: Replica registration failed\n";
+        }
+    } else {
+        std::cerr << "[ZK] WARNING: Replica registration failed (continuing without ZK)\n";
+    }
+
+    // -----------------------------------------
+    // ---- Replica membership (/lazylog/replicas) ----
+    // -----------------------------------------
+    // list once before joining the election so a leader elected right away
+    // already replicates to the registered replicas, then follow changes
+    if (s.coord) {
+        std::string replicas_path = "/lazylog/replicas";
+        zk_sync_membership(s.coord.get(), &seq, replicas_path, &s.membership_watch);
+        s.threads.emplace_back(membership_loop, s.coord.get(), &seq, replicas_path,
+                               &s.membership_watch);
+    }
+
+    // -----------------------------------------
+    // ---- Leader Election Setup (ZK sequential) ----
+    // -----------------------------------------
+    if (s.coord) {
+        std::string election_path = "/lazylog/election";
+        ensure_path(s.coord.get(), election_path);
 
         // Create ephemeral sequential znode
         std::string my_node_name;
         std::string created_path =
-            zk_create_ephemeral_sequential(zk_handle, election_path, replica_data, my_node_name);
+            zk_create_ephemeral_sequential(s.coord.get(), election_path, replica_data, my_node_name);
 
         if (!created_path.empty()) {
             std::cout << "[ELECTION] My election node: " << created_path << "\n";
             std::cout << "[ELECTION][DEBUG] my_node_name (last component): " << my_node_name << "\n";
 
             // Start election loop in background
-            std::thread(election_loop,
-                        zk_handle,
-                        &seq,
-                        election_path,
-                        my_node_name,
-                        500      // poll every 500ms
-            ).detach();
+            s.threads.emplace_back(election_loop,
+                                   s.coord.get(),
+                                   &seq,
+                                   &s.election_watch,
+                                   election_path,
+                                   my_node_name,
+                                   replica_data,
+                                   cfg.view_change_timeout_ms);
         } else {
             std::cerr << "[ELECTION] ERROR: Election node creation failed; no failover.\n";
         }
@@ -379,30 +1278,58 @@ void SequencerServer::Run(const std::string& role, int port, const std::vector<s
         std::cerr << "[ELECTION] ZooKeeper handle null, skipping election setup.\n";
     }
 
-    // -----------------------------------------
-    // ---- Start gRPC server ----
-    // -----------------------------------------
-    SequencerServiceImpl service(seq);
-    SequencerInternalImpl internal_service(seq);
-
-    ServerBuilder builder;
-    builder.AddListeningPort(addr, grpc::InsecureServerCredentials());
-    builder.RegisterService(&service);
-    builder.RegisterService(&internal_service);
-
-    std::unique_ptr<Server> server(builder.BuildAndStart());
-    std::cout << "[" << role << "] Server listening on " << addr << "\n";
-
     if (is_leader) {
         std::cout << "[LEADER] followers:";
-        for (auto &f : seq.followers) std::cout << " " << f;
+        for (auto &f : seq.get_followers()) std::cout << " " << f;
         std::cout << "\n";
     }
 
-    server->Wait();
-
-    // (Optional) Clean-up code could go here, e.g. zookeeper_close(zk_handle) etc.
+    if (cfg.heartbeat_ms > 0) {
+        s.threads.emplace_back(heartbeat_loop, &seq, cfg.heartbeat_ms, &s.gate, &s.stop);
+    }
+    if (!cfg.checkpoint_dir.empty() && cfg.checkpoint_interval_ms > 0) {
+        s.threads.emplace_back(checkpoint_loop, &seq,
+                               cfg.checkpoint_dir + "/checkpoint-" + std::to_string(s.port),
+                               cfg.checkpoint_interval_ms, &s.stop);
+    }
+    if (cfg.gc_interval_ms > 0) {
+        s.threads.emplace_back(gc_loop, &seq, cfg.gc_interval_ms, std::max(cfg.gc_step_entries, 1),
+                               std::max(cfg.gc_retain_entries, 0), &s.gate, &s.stop);
+    }
+    return true;
 }
 
+void SequencerServer::Wait() {
+    if (impl_->server) impl_->server->Wait();
+}
 
+// Stops like a crash as far as peers can tell: in-flight RPCs are
+// cancelled, heartbeats stop and the coordinator session (hence this
+// replica's registration and election node) ends.
+void SequencerServer::Shutdown() {
+    Impl &s = *impl_;
+    if (s.shut_down || !s.server) return;
+    s.shut_down = true;
 
+    s.stop.store(true);
+    s.gate.release();
+    if (s.shm) s.shm->stop();
+    s.server->Shutdown(std::chrono::system_clock::now());
+    {
+        std::lock_guard<std::mutex> lk(s.election_watch.mu);
+        s.election_watch.stop = true;
+    }
+    s.election_watch.cv.notify_all();
+    {
+        std::lock_guard<std::mutex> lk(s.membership_watch.mu);
+        s.membership_watch.stop = true;
+    }
+    s.membership_watch.cv.notify_all();
+    s.seq.stop_background();
+    for (auto &t : s.threads) t.join();
+    s.threads.clear();
+    if (s.repl_server) s.repl_server->stop();
+    s.seq.tcp_transport.reset();
+    if (s.coord) s.coord->close();
+    s.seq.tracer.close();
+}
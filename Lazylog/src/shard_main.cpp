@@ -0,0 +1,31 @@
+// shard_server: one replica of a record shard (see proto/shard.proto).
+//
+//   shard_server --port=50061 --backups=127.0.0.1:50062,127.0.0.1:50063   (primary)
+//   shard_server --port=50062                                             (backup)
+#include "shard_server.h"
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv) {
+    ShardConfig cfg;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        if (a.rfind("--port=", 0) == 0) cfg.port = std::stoi(a.substr(7));
+        if (a.rfind("--replicate_timeout_ms=", 0) == 0) cfg.replicate_timeout_ms = std::stoi(a.substr(23));
+        if (a.rfind("--backups=", 0) == 0) {
+            std::string list = a.substr(10);
+            size_t start = 0, end;
+            while ((end = list.find(',', start)) != std::string::npos) {
+                cfg.backups.push_back(list.substr(start, end - start));
+                start = end + 1;
+            }
+            if (start < list.size()) cfg.backups.push_back(list.substr(start));
+        }
+    }
+
+    ShardServer server;
+    if (!server.Start(cfg)) return 1;
+    server.Wait();
+    return 0;
+}
@@ -0,0 +1,184 @@
+#include "shard_server.h"
+#include "sequencer_log.h"
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <grpcpp/grpcpp.h>
+#include "generated/shard.grpc.pb.h"
+
+using grpc::Server;
+using grpc::ServerBuilder;
+using grpc::ServerContext;
+using grpc::Status;
+
+using shard::ShardService;
+using shard::WriteRequest;
+using shard::WriteReply;
+using shard::ReadRequest;
+using shard::ReadReply;
+
+// The shard's log: records in arrival order, plus an index per log by
+// (client_id, req_id) for reads and idempotent retries.
+class ShardStore {
+public:
+    // returns the record's index; an existing key keeps its first copy
+    int64_t put(const WriteRequest &req) {
+        std::lock_guard<std::mutex> lk(mu_);
+        auto &index = index_[req.log_id()];
+        auto it = index.find(key(req.client_id(), req.req_id()));
+        if (it != index.end()) return it->second;
+        int64_t idx = log_.append({req.client_id(), req.req_id(), req.record()});
+        index.emplace(key(req.client_id(), req.req_id()), idx);
+        return idx;
+    }
+
+    bool get(uint64_t log_id, int client_id, int req_id, std::string *record) {
+        std::lock_guard<std::mutex> lk(mu_);
+        auto log = index_.find(log_id);
+        if (log == index_.end()) return false;
+        auto it = log->second.find(key(client_id, req_id));
+        if (it == log->second.end()) return false;
+        *record = log_.get((int)it->second).record;
+        return true;
+    }
+
+    int64_t size() {
+        std::lock_guard<std::mutex> lk(mu_);
+        return log_.size();
+    }
+
+    int64_t bytes() {
+        std::lock_guard<std::mutex> lk(mu_);
+        return log_.bytes();
+    }
+
+private:
+    static uint64_t key(int client_id, int req_id) {
+        return ((uint64_t)(uint32_t)client_id << 32) | (uint32_t)req_id;
+    }
+
+    std::mutex mu_;
+    SequencerLog log_;
+    std::unordered_map<uint64_t, std::unordered_map<uint64_t, int64_t>> index_;   // log_id -> key -> index
+};
+
+class ShardServiceImpl final : public ShardService::Service {
+public:
+    ShardServiceImpl(ShardStore &store, const ShardConfig &cfg) : store_(store), cfg_(cfg) {
+        for (const auto &addr : cfg.backups) {
+            backups_.emplace_back(ShardService::NewStub(
+                grpc::CreateChannel(addr, grpc::InsecureChannelCredentials())));
+        }
+    }
+
+    // Applied locally first, so a retry after a failed replication finds
+    // the record and only re-replicates it (backups ignore duplicates).
+    Status Write(ServerContext* context, const WriteRequest* req, WriteReply* reply) override {
+        int64_t idx = store_.put(*req);
+        std::string err = replicate(*req);
+        reply->set_ok(err.empty());
+        reply->set_index(idx);
+        reply->set_message(err.empty() ? "OK" : err);
+        return Status::OK;
+    }
+
+    Status Replicate(ServerContext* context, const WriteRequest* req, WriteReply* reply) override {
+        reply->set_index(store_.put(*req));
+        reply->set_ok(true);
+        return Status::OK;
+    }
+
+    Status Read(ServerContext* context, const ReadRequest* req, ReadReply* reply) override {
+        reply->set_ok(store_.get(req->log_id(), req->client_id(), req->req_id(), reply->mutable_record()));
+        return Status::OK;
+    }
+
+private:
+    // to all backups in parallel; empty on success, else the first failure
+    std::string replicate(const WriteRequest &req) {
+        if (backups_.empty()) return "";
+        struct Call {
+            grpc::ClientContext ctx;
+            WriteReply reply;
+            Status status;
+        };
+        std::vector<Call> calls(backups_.size());
+        std::mutex mu;
+        std::condition_variable cv;
+        size_t pending = calls.size();
+        auto deadline = std::chrono::system_clock::now() +
+                        std::chrono::milliseconds(cfg_.replicate_timeout_ms);
+        for (size_t i = 0; i < calls.size(); ++i) {
+            Call *c = &calls[i];
+            c->ctx.set_deadline(deadline);
+            backups_[i]->async()->Replicate(&c->ctx, &req, &c->reply, [&, c](Status st) {
+                std::lock_guard<std::mutex> lk(mu);
+                c->status = st;
+                if (--pending == 0) cv.notify_one();
+            });
+        }
+        std::unique_lock<std::mutex> lk(mu);
+        cv.wait(lk, [&] { return pending == 0; });
+        for (size_t i = 0; i < calls.size(); ++i) {
+            if (!calls[i].status.ok() || !calls[i].reply.ok()) {
+                return "replication to " + cfg_.backups[i] + " failed: " +
+                       (calls[i].status.ok() ? calls[i].reply.message() : calls[i].status.error_message());
+            }
+        }
+        return "";
+    }
+
+    ShardStore &store_;
+    const ShardConfig &cfg_;
+    std::vector<std::unique_ptr<ShardService::Stub>> backups_;
+};
+
+struct ShardServer::Impl {
+    ShardConfig cfg;
+    ShardStore store;
+    std::unique_ptr<ShardServiceImpl> service;
+    std::unique_ptr<Server> server;
+    int port = 0;
+};
+
+ShardServer::ShardServer() : impl_(new Impl()) {}
+
+ShardServer::~ShardServer() { Shutdown(); }
+
+int ShardServer::port() const { return impl_->port; }
+
+std::string ShardServer::address() const { return "127.0.0.1:" + std::to_string(impl_->port); }
+
+int64_t ShardServer::size() const { return impl_->store.size(); }
+
+int64_t ShardServer::bytes() const { return impl_->store.bytes(); }
+
+bool ShardServer::Start(const ShardConfig& cfg) {
+    Impl &s = *impl_;
+    s.cfg = cfg;
+    s.service.reset(new ShardServiceImpl(s.store, s.cfg));
+
+    std::string addr = "0.0.0.0:" + std::to_string(cfg.port);
+    ServerBuilder builder;
+    builder.AddListeningPort(addr, grpc::InsecureServerCredentials(), &s.port);
+    builder.RegisterService(s.service.get());
+    s.server = builder.BuildAndStart();
+    if (!s.server || s.port == 0) {
+        std::cerr << "[SHARD] ERROR: cannot listen on " << addr << "\n";
+        return false;
+    }
+    std::cout << "[SHARD] listening on 0.0.0.0:" << s.port << " with " << cfg.backups.size()
+              << " backups\n";
+    return true;
+}
+
+void ShardServer::Wait() {
+    if (impl_->server) impl_->server->Wait();
+}
+
+void ShardServer::Shutdown() {
+    if (!impl_->server) return;
+    impl_->server->Shutdown(std::chrono::system_clock::now());
+    impl_->server.reset();
+}
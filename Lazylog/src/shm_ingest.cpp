@@ -0,0 +1,240 @@
+#include "shm_ingest.h"
+#include "sequencer.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace shm_ring;
+
+// records per batch, across all rings
+static const size_t MAX_BATCH = 512;
+// bytes of credit a ring with records waiting gets per round of a batch
+static const int64_t QUANTUM = 4096;
+// empty polls before the drain thread starts sleeping between polls
+static const int IDLE_SPINS = 2000;
+
+ShmIngest::ShmIngest(Sequencer &seq, std::function<void()> before_batch)
+    : seq_(seq), before_batch_(std::move(before_batch)) {}
+
+ShmIngest::~ShmIngest() { stop(); }
+
+bool ShmIngest::start(const std::string &name, int rings, size_t ring_bytes) {
+    uint64_t data_cap = 4096;
+    while (data_cap < ring_bytes) data_cap <<= 1;
+    uint64_t comp_cap = std::max<uint64_t>(data_cap / 64, 64);
+    map_len_ = segment_size(data_cap, comp_cap);
+    name_ = name;
+
+    for (int k = 0; k < rings; ++k) {
+        std::string seg = segment_name(name, k);
+        shm_unlink(seg.c_str());   // left over from a replica that crashed
+        int fd = shm_open(seg.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+        void *p = MAP_FAILED;
+        if (fd >= 0 && ftruncate(fd, map_len_) == 0) {
+            p = mmap(nullptr, map_len_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        if (fd >= 0) close(fd);
+        if (p == MAP_FAILED) {
+            std::cerr << "[SHM] cannot create " << seg << ": " << std::strerror(errno) << "\n";
+            stop();
+            return false;
+        }
+        // fresh segments are zero-filled: indices 0, owner free
+        auto *h = static_cast<RingHeader *>(p);
+        h->magic = MAGIC;
+        h->version = VERSION;
+        h->data_capacity = data_cap;
+        h->comp_capacity = comp_cap;
+        h->server_up.store(1, std::memory_order_release);
+        rings_.push_back(h);
+    }
+    thread_ = std::thread([this] { loop(); });
+    std::cout << "[SHM] " << rings << " rings /dev/shm" << segment_name(name, 0) << ".. of "
+              << data_cap << " bytes\n";
+    return true;
+}
+
+void ShmIngest::stop() {
+    stop_.store(true);
+    if (thread_.joinable()) thread_.join();
+    for (size_t k = 0; k < rings_.size(); ++k) {
+        rings_[k]->server_up.store(0, std::memory_order_release);
+        munmap(rings_[k], map_len_);
+        shm_unlink(segment_name(name_, (int)k).c_str());
+    }
+    rings_.clear();
+}
+
+void ShmIngest::loop() {
+    int idle = 0;
+    int64_t reclaim_at_ms = steady_now_ms() + 1000;
+    while (!stop_.load(std::memory_order_relaxed)) {
+        if (drain_once()) {
+            idle = 0;
+        } else if (++idle > IDLE_SPINS) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        if (steady_now_ms() >= reclaim_at_ms) {
+            reclaim_abandoned();
+            reclaim_at_ms = steady_now_ms() + 1000;
+        }
+    }
+}
+
+// a producer that died without detaching keeps its ring; free it once
+// everything it queued has been answered
+void ShmIngest::reclaim_abandoned() {
+    for (auto *h : rings_) {
+        uint32_t pid = h->owner.load(std::memory_order_acquire);
+        if (pid == 0 || kill((pid_t)pid, 0) == 0 || errno != ESRCH) continue;
+        if (h->req_tail.load() != h->req_head.load(std::memory_order_acquire)) continue;
+        if (h->owner.compare_exchange_strong(pid, 0)) {
+            std::cout << "[SHM] reclaimed ring of exited producer " << pid << "\n";
+        }
+    }
+}
+
+// Deficit round robin over the rings: each round, every ring with records
+// waiting gets QUANTUM bytes of credit and gives up records while its
+// credit covers them, so a producer with a full ring gets the same share of
+// a batch as one sending a trickle, and large records the same byte share
+// as small ones. A ring whose client is over its quota stops at that
+// record, which waits in the ring; the producer is not answered until then.
+// Tokens taken for a record that is then refused or answered as a
+// duplicate are given back.
+bool ShmIngest::drain_once() {
+    std::vector<Pending> pend;
+    std::vector<Sequencer::BatchRecord> batch;
+    const size_t n_rings = rings_.size();
+    std::vector<uint64_t> tails(n_rings), heads(n_rings);
+    std::vector<char> stalled(n_rings, 0);   // over quota for this batch
+    if (deficit_.size() != n_rings) deficit_.assign(n_rings, 0);
+
+    for (size_t k = 0; k < n_rings; ++k) {
+        tails[k] = rings_[k]->req_tail.load(std::memory_order_relaxed);
+        heads[k] = rings_[k]->req_head.load(std::memory_order_acquire);
+    }
+    bool waiting = true;
+    while (waiting && batch.size() < MAX_BATCH) {
+        waiting = false;
+        for (size_t n = 0; n < n_rings && batch.size() < MAX_BATCH; ++n) {
+            size_t k = (next_ring_ + n) % n_rings;
+            uint64_t &tail = tails[k];
+            uint64_t head = heads[k];
+            if (tail == head) {
+                deficit_[k] = 0;   // credit is not saved up while idle
+                continue;
+            }
+            if (stalled[k]) continue;
+            deficit_[k] += QUANTUM;
+            RingHeader *h = rings_[k];
+            uint64_t cap = h->data_capacity;
+            // the producer keeps at most comp_capacity records unanswered, so
+            // every record found here has a completion slot
+            const char *data = ring_data(h);
+            while (tail < head && batch.size() < MAX_BATCH) {
+                size_t off = tail & (cap - 1);
+                RecordHeader rh;
+                std::memcpy(&rh, data + off, sizeof(uint32_t));
+                if (rh.len == WRAP) {
+                    tail += cap - off;
+                    continue;
+                }
+                std::memcpy(&rh, data + off, sizeof(rh));
+                if (rh.len > max_record(cap) || record_size(rh.len) > head - tail ||
+                    off + record_size(rh.len) > cap) {
+                    // nothing after a bad header can be parsed; drop the rest
+                    std::cerr << "[SHM] malformed record in ring " << k << ", dropping "
+                              << head - tail << " bytes\n";
+                    pend.push_back(Pending{h, rh.client_id, rh.req_id, BAD_RECORD, -1, -1});
+                    tail = head;
+                    break;
+                }
+                if ((int64_t)record_size(rh.len) > deficit_[k]) break;   // next round
+                if (seq_.quotas.take(rh.client_id, 1, rh.len)) {
+                    stalled[k] = 1;
+                    deficit_[k] = 0;
+                    break;
+                }
+                deficit_[k] -= (int64_t)record_size(rh.len);
+                pend.push_back(Pending{h, rh.client_id, rh.req_id, OK, -1, (int)batch.size()});
+                batch.push_back(Sequencer::BatchRecord{rh.client_id, rh.req_id, rh.log_id,
+                                                       data + off + sizeof(rh), rh.len});
+                tail += record_size(rh.len);
+            }
+            if (tail < head && !stalled[k]) waiting = true;
+        }
+    }
+    if (pend.empty()) return false;
+    next_ring_ = (next_ring_ + 1) % n_rings;
+
+    before_batch_();
+    SequencerMetrics &m = seq_.metrics;
+
+    // Append's checks, leadership and lease once for the batch
+    int32_t refused = seq_.sealed.load() ? SEALED
+                      : !seq_.is_leader.load() ? NOT_LEADER
+                      : !seq_.lease_valid() ? LEASE_EXPIRED : OK;
+    std::vector<Sequencer::BatchRecord> admitted;
+    std::vector<size_t> admitted_pend;
+    for (size_t i = 0; i < pend.size(); ++i) {
+        Pending &p = pend[i];
+        if (p.batch_slot < 0) continue;
+        const Sequencer::BatchRecord &r = batch[p.batch_slot];
+        if (refused != OK) {
+            p.status = refused;
+        } else if (seq_.find_duplicate(r.log_id, r.client_id, r.req_id, &p.pos)) {
+            p.status = DUPLICATE;
+        } else if (!seq_.admit_log(r.log_id)) {
+            p.status = TOO_MANY_LOGS;
+        } else {
+            admitted.push_back(r);
+            admitted_pend.push_back(i);
+            continue;
+        }
+        seq_.quotas.give_back(r.client_id, 1, (int64_t)r.len);
+    }
+
+    if (!admitted.empty()) {
+        // admission control as for an AppendStream batch, held until
+        // replication ended
+        int64_t bytes = 0;
+        for (const auto &r : admitted) bytes += (int64_t)r.len;
+        AdmissionControl::Ticket ticket(seq_.admission, (int64_t)admitted.size(), bytes);
+        if (!ticket) {
+            m.overload_rejects.add((int64_t)admitted.size());
+            for (size_t j = 0; j < admitted_pend.size(); ++j) {
+                pend[admitted_pend[j]].status = OVERLOADED;
+                seq_.quotas.give_back(admitted[j].client_id, 1, (int64_t)admitted[j].len);
+            }
+        } else {
+            std::vector<int64_t> positions;
+            bool repl_ok = seq_.append_batch(admitted, &positions);
+            for (size_t j = 0; j < admitted_pend.size(); ++j) {
+                Pending &p = pend[admitted_pend[j]];
+                p.status = repl_ok ? OK : REPLICATION_FAILED;
+                p.pos = repl_ok ? positions[j] : -1;
+            }
+        }
+    }
+
+    // answer in request order, then release the request bytes; a producer
+    // attaching to a ring relies on req_tail == req_head meaning answered
+    for (const Pending &p : pend) {
+        if (p.status != OK && p.status != DUPLICATE) m.append_failures.add();
+        RingHeader *h = p.ring;
+        uint64_t slot = h->comp_head.load(std::memory_order_relaxed);
+        Completion &c = ring_completions(h)[slot & (h->comp_capacity - 1)];
+        c = Completion{p.client_id, p.req_id, p.status, 0, p.pos};
+        h->comp_head.store(slot + 1, std::memory_order_release);
+    }
+    for (size_t k = 0; k < n_rings; ++k) {
+        if (tails[k]) rings_[k]->req_tail.store(tails[k], std::memory_order_release);
+    }
+    return true;
+}
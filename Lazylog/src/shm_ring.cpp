@@ -0,0 +1,110 @@
+#include "shm_ring.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace shm_ring;
+
+const char *shm_ring::status_message(int32_t status) {
+    switch (status) {
+    case OK: return "Appended and replicated";
+    case DUPLICATE: return "Duplicate request, already appended";
+    case NOT_LEADER: return "Not leader";
+    case SEALED: return "View is sealed";
+    case LEASE_EXPIRED: return "Leader lease expired";
+    case TOO_MANY_LOGS: return "Too many logs";
+    case REPLICATION_FAILED: return "Replication failed";
+    case BAD_RECORD: return "Malformed record";
+    case OVERLOADED: return "Too many appends in flight";
+    }
+    return "Unknown status";
+}
+
+bool ShmProducer::attach(const std::string &shm_name) {
+    detach();
+    for (int k = 0;; ++k) {
+        int fd = shm_open(segment_name(shm_name, k).c_str(), O_RDWR, 0);
+        if (fd < 0) return false;   // past the last ring
+        struct stat st;
+        void *p = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(RingHeader)) {
+            p = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (p == MAP_FAILED) continue;
+        auto *h = static_cast<RingHeader *>(p);
+        uint32_t free_owner = 0;
+        if (h->magic != MAGIC || h->version != VERSION || !h->server_up.load(std::memory_order_acquire) ||
+            (size_t)st.st_size < segment_size(h->data_capacity, h->comp_capacity) ||
+            !h->owner.compare_exchange_strong(free_owner, (uint32_t)getpid())) {
+            munmap(p, st.st_size);
+            continue;
+        }
+        // a previous owner may have left records the sequencer has not
+        // acked yet; their acks would look like ours
+        if (h->req_tail.load(std::memory_order_acquire) != h->req_head.load(std::memory_order_acquire)) {
+            h->owner.store(0, std::memory_order_release);
+            munmap(p, st.st_size);
+            continue;
+        }
+        hdr_ = h;
+        map_len_ = st.st_size;
+        head_ = h->req_head.load(std::memory_order_relaxed);
+        completed_ = submitted_ = h->comp_head.load(std::memory_order_acquire);
+        h->comp_tail.store(completed_, std::memory_order_release);
+        return true;
+    }
+}
+
+void ShmProducer::detach() {
+    if (!hdr_) return;
+    hdr_->owner.store(0, std::memory_order_release);
+    munmap(hdr_, map_len_);
+    hdr_ = nullptr;
+    submitted_ = completed_ = 0;
+}
+
+size_t ShmProducer::max_record() const { return hdr_ ? shm_ring::max_record(hdr_->data_capacity) : 0; }
+
+bool ShmProducer::server_up() const { return hdr_ && hdr_->server_up.load(std::memory_order_acquire); }
+
+bool ShmProducer::try_append(int client_id, int req_id, const void *data, size_t len, uint64_t log_id) {
+    if (!hdr_ || len > max_record()) return false;
+    if (submitted_ - completed_ >= hdr_->comp_capacity) return false;
+
+    uint64_t cap = hdr_->data_capacity;
+    uint64_t tail = hdr_->req_tail.load(std::memory_order_acquire);
+    size_t need = record_size(len);
+    size_t off = head_ & (cap - 1);
+    size_t skip = cap - off < need ? cap - off : 0;   // bytes wasted to wrap
+    if (head_ + skip + need - tail > cap) return false;
+
+    char *base = ring_data(hdr_);
+    if (skip) {
+        uint32_t wrap = WRAP;
+        std::memcpy(base + off, &wrap, sizeof(wrap));
+        off = 0;
+    }
+    RecordHeader rh{(uint32_t)len, client_id, req_id, 0, log_id};
+    std::memcpy(base + off, &rh, sizeof(rh));
+    std::memcpy(base + off + sizeof(rh), data, len);
+    head_ += skip + need;
+    submitted_++;
+    hdr_->req_head.store(head_, std::memory_order_release);
+    return true;
+}
+
+size_t ShmProducer::poll(Ack *out, size_t max) {
+    if (!hdr_) return 0;
+    uint64_t head = hdr_->comp_head.load(std::memory_order_acquire);
+    const Completion *ring = ring_completions(hdr_);
+    size_t n = 0;
+    for (; completed_ < head && n < max; ++completed_, ++n) {
+        const Completion &c = ring[completed_ & (hdr_->comp_capacity - 1)];
+        out[n] = Ack{c.client_id, c.req_id, c.status, c.pos};
+    }
+    if (n) hdr_->comp_tail.store(completed_, std::memory_order_release);
+    return n;
+}
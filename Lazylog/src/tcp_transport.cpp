@@ -0,0 +1,541 @@
+#include "tcp_transport.h"
+#include "sequencer.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "generated/sequencer_internal.pb.h"
+
+using namespace tcp_repl;
+
+static void set_nonblocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+static void set_nodelay(int fd) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+static void wake(int fd) {
+    uint64_t one = 1;
+    ssize_t n = ::write(fd, &one, sizeof(one));
+    (void)n;
+}
+
+// ---------------------------------------------------------------------------
+// Leader side
+// ---------------------------------------------------------------------------
+
+// Waiters of one begin(): one ack slot per follower.
+struct TcpReplicationClient::CallState {
+    std::mutex mu;
+    std::condition_variable cv;
+    int pending = 0;
+    std::vector<ReplicateAck> acks;
+    std::vector<bool> done;
+
+    void complete(size_t i, bool ok, int64_t view, const std::string &error) {
+        std::lock_guard<std::mutex> lk(mu);
+        if (done[i]) return;
+        done[i] = true;
+        acks[i].ok = ok;
+        acks[i].view = view;
+        acks[i].error = error;
+        acks[i].done_us = steady_now_us();
+        if (--pending == 0) cv.notify_all();
+    }
+};
+
+struct TcpReplicationClient::Peer {
+    std::string addr;
+    std::string host;
+    int port = 0;
+    int64_t retry_after_ms = 0;   // connect backoff
+
+    std::mutex mu;                // guards everything below
+    int fd = -1;
+    std::string out;              // bytes the socket did not take yet
+    size_t out_off = 0;
+    std::string in;
+    struct Waiter {
+        std::shared_ptr<CallState> call;
+        size_t slot;
+    };
+    std::unordered_map<uint64_t, Waiter> waiting;   // by seq
+};
+
+class TcpReplicationCall : public ReplicationCall {
+public:
+    TcpReplicationCall(TcpReplicationClient *client, std::shared_ptr<TcpReplicationClient::CallState> st)
+        : client_(client), st_(std::move(st)) {}
+
+    // the frames went out in begin(); only the bound is left to set
+    void send(int64_t deadline_us) override { deadline_us_ = deadline_us; }
+
+    std::vector<ReplicateAck> wait() override {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(client_->timeout_ms_);
+        if (deadline_us_) {
+            deadline = std::min(deadline, std::chrono::steady_clock::time_point(
+                                              std::chrono::microseconds(deadline_us_)));
+        }
+        std::vector<size_t> late;
+        {
+            std::unique_lock<std::mutex> lk(st_->mu);
+            st_->cv.wait_until(lk, deadline, [&] { return st_->pending == 0; });
+            for (size_t i = 0; i < st_->done.size(); ++i) {
+                if (!st_->done[i]) late.push_back(i);
+            }
+        }
+        // forget the late ones (outside st_->mu: the epoll thread takes the
+        // peer lock first, then ours) so a late ack finds no waiter
+        for (size_t i : late) {
+            auto peer = client_->find_peer(st_->acks[i].addr);
+            if (peer) {
+                std::lock_guard<std::mutex> lk(peer->mu);
+                for (auto it = peer->waiting.begin(); it != peer->waiting.end();) {
+                    if (it->second.call == st_) it = peer->waiting.erase(it);
+                    else ++it;
+                }
+            }
+            st_->complete(i, false, 0, "timed out");
+        }
+        std::lock_guard<std::mutex> lk(st_->mu);
+        return st_->acks;
+    }
+
+private:
+    TcpReplicationClient *client_;
+    std::shared_ptr<TcpReplicationClient::CallState> st_;
+    int64_t deadline_us_ = 0;
+};
+
+TcpReplicationClient::TcpReplicationClient(int timeout_ms) : timeout_ms_(timeout_ms) {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.ptr = nullptr;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+    thread_ = std::thread([this] { loop(); });
+}
+
+TcpReplicationClient::~TcpReplicationClient() {
+    stop_.store(true);
+    wake(wake_fd_);
+    thread_.join();
+    std::lock_guard<std::mutex> lk(peers_mu_);
+    for (auto &kv : peers_) {
+        std::lock_guard<std::mutex> plk(kv.second->mu);
+        fail_peer_locked(kv.second.get(), "transport closed");
+    }
+    close(wake_fd_);
+    close(epoll_fd_);
+}
+
+std::shared_ptr<TcpReplicationClient::Peer> TcpReplicationClient::find_peer(const std::string &addr) {
+    std::lock_guard<std::mutex> lk(peers_mu_);
+    auto it = peers_.find(addr);
+    return it == peers_.end() ? nullptr : it->second;
+}
+
+void TcpReplicationClient::set_route(const std::string &addr, int port) {
+    std::lock_guard<std::mutex> lk(peers_mu_);
+    auto &p = peers_[addr];
+    if (!p) {
+        p = std::make_shared<Peer>();
+        p->addr = addr;
+        p->host = addr.substr(0, addr.rfind(':'));
+    }
+    if (p->port == port) return;
+    std::lock_guard<std::mutex> plk(p->mu);
+    p->port = port;
+    p->retry_after_ms = 0;
+    fail_peer_locked(p.get(), "route changed");
+}
+
+bool TcpReplicationClient::connect(const std::string &addr) {
+    auto p = find_peer(addr);
+    if (!p) return false;
+    std::lock_guard<std::mutex> lk(p->mu);
+    if (p->fd >= 0) return true;
+    if (p->port == 0 || steady_now_ms() < p->retry_after_ms) return false;
+
+    sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons((uint16_t)p->port);
+    int fd = -1;
+    bool ok = inet_pton(AF_INET, p->host.c_str(), &sa.sin_addr) == 1;
+    if (ok) {
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        set_nonblocking(fd);
+        int rc = ::connect(fd, (sockaddr *)&sa, sizeof(sa));
+        if (rc != 0 && errno == EINPROGRESS) {
+            pollfd pfd{fd, POLLOUT, 0};
+            int err = 0;
+            socklen_t len = sizeof(err);
+            rc = (poll(&pfd, 1, 200) == 1 && getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) == 0 &&
+                  err == 0) ? 0 : -1;
+        }
+        ok = rc == 0;
+    }
+    if (!ok) {
+        if (fd >= 0) close(fd);
+        p->retry_after_ms = steady_now_ms() + 500;
+        return false;
+    }
+    set_nodelay(fd);
+    p->fd = fd;
+    p->in.clear();
+    p->out.clear();
+    p->out_off = 0;
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.ptr = p.get();
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+    std::cout << "[REPL] TCP connection to " << addr << " (port " << p->port << ")\n";
+    return true;
+}
+
+void TcpReplicationClient::fail_peer_locked(Peer *p, const std::string &why) {
+    if (p->fd >= 0) {
+        close(p->fd);   // also leaves the epoll set
+        p->fd = -1;
+        std::cerr << "[REPL] TCP connection to " << p->addr << " closed: " << why << "\n";
+    }
+    p->out.clear();
+    p->out_off = 0;
+    p->in.clear();
+    for (auto &kv : p->waiting) kv.second.call->complete(kv.second.slot, false, 0, why);
+    p->waiting.clear();
+}
+
+std::unique_ptr<ReplicationCall> TcpReplicationClient::begin(const std::vector<std::string> &addrs,
+                                                             int64_t local_index,
+                                                             const SequencerLog::Entry &e,
+                                                             int64_t view, uint64_t trace_id) {
+    auto st = std::make_shared<CallState>();
+    st->pending = (int)addrs.size();
+    st->acks.resize(addrs.size());
+    st->done.assign(addrs.size(), false);
+
+    EntryHeader eh{};
+    eh.local_index = local_index;
+    eh.global_pos = e.global_pos;
+    eh.view = view;
+    eh.log_pos = e.log_pos;
+    eh.trace_id = trace_id;
+    eh.log_id = e.log_id;
+    eh.client_id = e.client_id;
+    eh.req_id = e.req_id;
+    eh.shard = e.shard;
+    eh.record_len = (uint32_t)e.record.size();
+    FrameHeader fh{MAGIC, ENTRIES, 1, (uint32_t)(sizeof(eh) + e.record.size())};
+
+    for (size_t i = 0; i < addrs.size(); ++i) {
+        st->acks[i].addr = addrs[i];
+        st->acks[i].attempts = 1;
+        st->acks[i].start_us = steady_now_us();
+        auto p = find_peer(addrs[i]);
+        if (!p) {
+            st->complete(i, false, 0, "no route");
+            continue;
+        }
+        std::lock_guard<std::mutex> lk(p->mu);
+        if (p->fd < 0) {
+            st->complete(i, false, 0, "not connected");
+            continue;
+        }
+        eh.seq = next_seq_.fetch_add(1);
+        p->waiting[eh.seq] = Peer::Waiter{st, i};
+
+        iovec iov[3] = {{&fh, sizeof(fh)}, {&eh, sizeof(eh)},
+                        {const_cast<char *>(e.record.data()), e.record.size()}};
+        size_t total = sizeof(fh) + sizeof(eh) + e.record.size();
+        size_t sent = 0;
+        if (p->out.size() == p->out_off) {
+            // nothing queued ahead of us: straight from the log entry
+            ssize_t n = writev(p->fd, iov, e.record.empty() ? 2 : 3);
+            if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                fail_peer_locked(p.get(), std::strerror(errno));
+                continue;
+            }
+            sent = n > 0 ? (size_t)n : 0;
+        }
+        if (sent < total) {
+            // keep the unsent tail (a copy) for the epoll thread
+            bool was_idle = p->out.size() == p->out_off;
+            size_t skip = sent;
+            for (const iovec &v : iov) {
+                if (skip >= v.iov_len) {
+                    skip -= v.iov_len;
+                    continue;
+                }
+                p->out.append((const char *)v.iov_base + skip, v.iov_len - skip);
+                skip = 0;
+            }
+            if (was_idle) {
+                epoll_event ev{};
+                ev.events = EPOLLIN | EPOLLOUT;
+                ev.data.ptr = p.get();
+                epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, p->fd, &ev);
+            }
+        }
+    }
+    return std::unique_ptr<ReplicationCall>(new TcpReplicationCall(this, st));
+}
+
+void TcpReplicationClient::on_writable(Peer *p) {
+    std::lock_guard<std::mutex> lk(p->mu);
+    if (p->fd < 0) return;
+    while (p->out_off < p->out.size()) {
+        ssize_t n = ::write(p->fd, p->out.data() + p->out_off, p->out.size() - p->out_off);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        if (n <= 0) {
+            fail_peer_locked(p, n < 0 ? std::strerror(errno) : "closed");
+            return;
+        }
+        p->out_off += (size_t)n;
+    }
+    p->out.clear();
+    p->out_off = 0;
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.ptr = p;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, p->fd, &ev);
+}
+
+void TcpReplicationClient::on_readable(Peer *p) {
+    std::lock_guard<std::mutex> lk(p->mu);
+    if (p->fd < 0) return;
+    char buf[16384];
+    while (true) {
+        ssize_t n = ::read(p->fd, buf, sizeof(buf));
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (n <= 0) {
+            fail_peer_locked(p, n < 0 ? std::strerror(errno) : "closed by follower");
+            return;
+        }
+        p->in.append(buf, (size_t)n);
+    }
+
+    size_t off = 0;
+    while (p->in.size() - off >= sizeof(FrameHeader)) {
+        FrameHeader fh;
+        std::memcpy(&fh, p->in.data() + off, sizeof(fh));
+        if (fh.magic != MAGIC || fh.kind != ACKS || fh.body_len != fh.count * sizeof(AckRecord)) {
+            fail_peer_locked(p, "bad ack frame");
+            return;
+        }
+        if (p->in.size() - off < sizeof(fh) + fh.body_len) break;
+        const char *body = p->in.data() + off + sizeof(fh);
+        for (uint32_t k = 0; k < fh.count; ++k) {
+            AckRecord a;
+            std::memcpy(&a, body + k * sizeof(a), sizeof(a));
+            auto it = p->waiting.find(a.seq);
+            if (it == p->waiting.end()) continue;   // its caller timed out
+            it->second.call->complete(it->second.slot, a.ok != 0, a.view,
+                                      a.ok ? "" : "rejected by follower");
+            p->waiting.erase(it);
+        }
+        off += sizeof(fh) + fh.body_len;
+    }
+    p->in.erase(0, off);
+}
+
+void TcpReplicationClient::loop() {
+    epoll_event events[64];
+    while (!stop_.load()) {
+        int n = epoll_wait(epoll_fd_, events, 64, 100);
+        for (int i = 0; i < n; ++i) {
+            Peer *p = (Peer *)events[i].data.ptr;
+            if (!p) {
+                uint64_t v;
+                ssize_t r = ::read(wake_fd_, &v, sizeof(v));
+                (void)r;
+                continue;
+            }
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) on_readable(p);
+            if (events[i].events & EPOLLOUT) on_writable(p);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Follower side
+// ---------------------------------------------------------------------------
+
+struct TcpReplicationServer::Conn {
+    int fd = -1;
+    std::string in;
+    std::string out;
+    size_t out_off = 0;
+};
+
+TcpReplicationServer::TcpReplicationServer(Handler handler) : handler_(std::move(handler)) {}
+
+TcpReplicationServer::~TcpReplicationServer() { stop(); }
+
+int TcpReplicationServer::start(int port) {
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    int one = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = htonl(INADDR_ANY);
+    sa.sin_port = htons((uint16_t)port);
+    socklen_t len = sizeof(sa);
+    if (bind(listen_fd_, (sockaddr *)&sa, sizeof(sa)) != 0 || listen(listen_fd_, 16) != 0 ||
+        getsockname(listen_fd_, (sockaddr *)&sa, &len) != 0) {
+        std::cerr << "[REPL] cannot listen for TCP replication on port " << port << ": "
+                  << std::strerror(errno) << "\n";
+        close(listen_fd_);
+        listen_fd_ = -1;
+        return 0;
+    }
+    set_nonblocking(listen_fd_);
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listen_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &ev);
+    ev.data.fd = wake_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+    thread_ = std::thread([this] { loop(); });
+    return ntohs(sa.sin_port);
+}
+
+void TcpReplicationServer::stop() {
+    if (!thread_.joinable()) return;
+    stop_.store(true);
+    wake(wake_fd_);
+    thread_.join();
+    for (auto &kv : conns_) close(kv.first);
+    conns_.clear();
+    close(listen_fd_);
+    close(wake_fd_);
+    close(epoll_fd_);
+}
+
+// write what is queued; false if the connection broke
+bool TcpReplicationServer::flush(Conn *c) {
+    while (c->out_off < c->out.size()) {
+        ssize_t n = ::write(c->fd, c->out.data() + c->out_off, c->out.size() - c->out_off);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (n <= 0) return false;
+        c->out_off += (size_t)n;
+    }
+    bool drained = c->out_off == c->out.size();
+    if (drained) {
+        c->out.clear();
+        c->out_off = 0;
+    }
+    epoll_event ev{};
+    ev.events = drained ? EPOLLIN : EPOLLIN | EPOLLOUT;
+    ev.data.fd = c->fd;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, c->fd, &ev);
+    return true;
+}
+
+// read and apply every complete frame; false if the connection broke
+bool TcpReplicationServer::on_readable(Conn *c) {
+    char buf[65536];
+    while (true) {
+        ssize_t n = ::read(c->fd, buf, sizeof(buf));
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (n <= 0) return false;
+        c->in.append(buf, (size_t)n);
+    }
+
+    size_t off = 0;
+    while (c->in.size() - off >= sizeof(FrameHeader)) {
+        FrameHeader fh;
+        std::memcpy(&fh, c->in.data() + off, sizeof(fh));
+        if (fh.magic != MAGIC || fh.kind != ENTRIES || fh.body_len > MAX_FRAME) {
+            std::cerr << "[REPL] bad TCP replication frame, dropping the connection\n";
+            return false;
+        }
+        if (c->in.size() - off < sizeof(fh) + fh.body_len) break;
+
+        const char *p = c->in.data() + off + sizeof(fh);
+        const char *end = p + fh.body_len;
+        FrameHeader ah{MAGIC, ACKS, fh.count, (uint32_t)(fh.count * sizeof(AckRecord))};
+        c->out.append((const char *)&ah, sizeof(ah));
+        for (uint32_t k = 0; k < fh.count; ++k) {
+            EntryHeader eh;
+            if (end - p < (ptrdiff_t)sizeof(eh)) return false;
+            std::memcpy(&eh, p, sizeof(eh));
+            p += sizeof(eh);
+            if (end - p < (ptrdiff_t)eh.record_len) return false;
+
+            sequencer_internal::ReplicateAppendRequest req;
+            req.set_client_id(eh.client_id);
+            req.set_req_id(eh.req_id);
+            req.set_record(p, eh.record_len);
+            req.set_local_index(eh.local_index);
+            req.set_global_pos(eh.global_pos);
+            req.set_view(eh.view);
+            req.set_trace_id(eh.trace_id);
+            req.set_shard(eh.shard);
+            req.set_log_id(eh.log_id);
+            req.set_log_pos(eh.log_pos);
+            p += eh.record_len;
+
+            sequencer_internal::ReplicateAppendReply reply;
+            handler_(&req, &reply);
+            AckRecord a{eh.seq, reply.view(), reply.ok() ? 1u : 0u, 0};
+            c->out.append((const char *)&a, sizeof(a));
+        }
+        off += sizeof(fh) + fh.body_len;
+    }
+    c->in.erase(0, off);
+    return flush(c);
+}
+
+void TcpReplicationServer::loop() {
+    epoll_event events[64];
+    while (!stop_.load()) {
+        int n = epoll_wait(epoll_fd_, events, 64, 100);
+        for (int i = 0; i < n && !stop_.load(); ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wake_fd_) continue;
+            if (fd == listen_fd_) {
+                int cfd;
+                while ((cfd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    set_nodelay(cfd);
+                    std::unique_ptr<Conn> c(new Conn());
+                    c->fd = cfd;
+                    epoll_event ev{};
+                    ev.events = EPOLLIN;
+                    ev.data.fd = cfd;
+                    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, cfd, &ev);
+                    conns_[cfd] = std::move(c);
+                }
+                continue;
+            }
+            auto it = conns_.find(fd);
+            if (it == conns_.end()) continue;
+            Conn *c = it->second.get();
+            bool alive = true;
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) alive = on_readable(c);
+            if (alive && (events[i].events & EPOLLOUT)) alive = flush(c);
+            if (!alive) {
+                close(fd);
+                conns_.erase(it);
+            }
+        }
+    }
+}
@@ -8,4 +8,5 @@ int main() {
     std::cout << "Size after append: " << log.size() << "\n"; // 1000
     log.gc_up_to(499);
     std::cout << "Size after GC 500: " << log.size() << "\n"; // 500
+    if (log.size() != 500 || log.get(500).req_id != 500) return 1;
 }
@@ -0,0 +1,126 @@
+#include "trace.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+
+// spans held between writer passes; beyond this they are dropped rather
+// than letting a stuck disk grow the heap
+static const size_t TRACE_BUFFER_MAX = 1 << 18;
+static const int TRACE_FLUSH_MS = 250;
+
+static int64_t wall_now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static int64_t steady_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// small per-thread number for the tid field (Chrome nests spans per tid)
+static int trace_tid() {
+    static std::atomic<int> next{1};
+    thread_local int tid = next.fetch_add(1, std::memory_order_relaxed);
+    return tid;
+}
+
+static std::string json_escape(const std::string &s) {
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        if ((unsigned char)c < 0x20) continue;
+        out += c;
+    }
+    return out;
+}
+
+bool Tracer::open(const std::string &path, int sample_every, int pid, const std::string &label) {
+    close();
+    std::FILE *f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        std::cerr << "[TRACE] cannot open " << path << "\n";
+        return false;
+    }
+    std::fprintf(f, "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"%s\"}},\n",
+                 pid, json_escape(label).c_str());
+    std::fflush(f);
+
+    out_ = f;
+    pid_ = pid;
+    sample_every_ = sample_every;
+    wall_offset_us_ = wall_now_us() - steady_us();
+    // random base so ids from successive leaders do not collide
+    id_base_ = std::random_device{}() | ((uint64_t)std::random_device{}() << 32);
+    stop_ = false;
+    enabled_.store(true);
+    writer_ = std::thread(&Tracer::writer_loop, this);
+    std::cout << "[TRACE] writing spans to " << path << " (1 in " << sample_every
+              << " appends)\n";
+    return true;
+}
+
+void Tracer::close() {
+    if (!writer_.joinable()) return;
+    enabled_.store(false);
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        stop_ = true;
+    }
+    cv_.notify_one();
+    writer_.join();
+    // last element has no trailing comma, so a cleanly closed file is strict JSON
+    std::fprintf(out_, "{\"name\":\"trace_dropped\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"spans\":%lld}}\n]\n",
+                 pid_, (long long)dropped());
+    std::fclose(out_);
+    out_ = nullptr;
+}
+
+uint64_t Tracer::sample() {
+    if (!enabled() || sample_every_ <= 0) return 0;
+    uint64_t n = sampled_.fetch_add(1, std::memory_order_relaxed);
+    if (n % sample_every_ != 0) return 0;
+    uint64_t id = id_base_ + n / sample_every_;
+    return id ? id : 1;
+}
+
+void Tracer::span(uint64_t trace_id, const char *name, int64_t start_us, int64_t end_us,
+                  const std::string &detail) {
+    if (!trace_id || !enabled()) return;
+    std::lock_guard<std::mutex> lk(mu_);
+    if (buffer_.size() >= TRACE_BUFFER_MAX) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer_.push_back({trace_id, name, start_us, end_us - start_us, trace_tid(), detail});
+}
+
+void Tracer::writer_loop() {
+    std::vector<Event> batch;
+    std::unique_lock<std::mutex> lk(mu_);
+    while (true) {
+        cv_.wait_for(lk, std::chrono::milliseconds(TRACE_FLUSH_MS), [&] { return stop_; });
+        batch.swap(buffer_);
+        bool last = stop_;
+        lk.unlock();
+        write_events(batch);
+        batch.clear();
+        if (last) return;
+        lk.lock();
+    }
+}
+
+void Tracer::write_events(const std::vector<Event> &events) {
+    if (events.empty()) return;
+    for (const Event &e : events) {
+        std::fprintf(out_,
+                     "{\"name\":\"%s\",\"cat\":\"append\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,"
+                     "\"pid\":%d,\"tid\":%d,\"args\":{\"trace_id\":\"%016llx\"",
+                     e.name, (long long)(e.start_us + wall_offset_us_), (long long)e.dur_us, pid_,
+                     e.tid, (unsigned long long)e.trace_id);
+        if (!e.detail.empty()) std::fprintf(out_, ",\"detail\":\"%s\"", json_escape(e.detail).c_str());
+        std::fputs("}},\n", out_);
+    }
+    std::fflush(out_);
+}
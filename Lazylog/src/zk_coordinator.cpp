@@ -0,0 +1,154 @@
+#include "coordinator.h"
+#include <zookeeper/zookeeper.h>
+#include <iostream>
+#include <mutex>
+
+const char *coord_rc_str(CoordRc rc) {
+    switch (rc) {
+    case CoordRc::OK: return "ok";
+    case CoordRc::NO_NODE: return "no node";
+    case CoordRc::NODE_EXISTS: return "node exists";
+    case CoordRc::NOT_EMPTY: return "not empty";
+    case CoordRc::SESSION_EXPIRED: return "session expired";
+    default: return "error";
+    }
+}
+
+static CoordRc from_zk(int rc) {
+    switch (rc) {
+    case ZOK: return CoordRc::OK;
+    case ZNONODE: return CoordRc::NO_NODE;
+    case ZNODEEXISTS: return CoordRc::NODE_EXISTS;
+    case ZNOTEMPTY: return CoordRc::NOT_EMPTY;
+    case ZSESSIONEXPIRED:
+    case ZINVALIDSTATE: return CoordRc::SESSION_EXPIRED;
+    default: return CoordRc::ERROR;
+    }
+}
+
+static CoordEvent event_from_zk(int type) {
+    if (type == ZOO_CREATED_EVENT) return CoordEvent::CREATED;
+    if (type == ZOO_DELETED_EVENT) return CoordEvent::DELETED;
+    if (type == ZOO_CHANGED_EVENT) return CoordEvent::CHANGED;
+    if (type == ZOO_CHILD_EVENT) return CoordEvent::CHILD;
+    return CoordEvent::SESSION_EXPIRED;
+}
+
+class ZkCoordinator : public Coordinator {
+public:
+    ZkCoordinator(const std::string &hosts, int session_timeout_ms) {
+        zh_ = zookeeper_init(hosts.c_str(), &ZkCoordinator::session_watcher, session_timeout_ms,
+                             nullptr, this, 0);
+    }
+
+    ~ZkCoordinator() override { close(); }
+
+    bool ok() const { return zh_ != nullptr; }
+
+    CoordRc create(const std::string &path, const std::string &data, int flags,
+                   std::string *created_path) override {
+        int mode = 0;
+        if (flags & EPHEMERAL) mode |= ZOO_EPHEMERAL;
+        if (flags & SEQUENTIAL) mode |= ZOO_SEQUENCE;
+        char buf[512];
+        int rc = zoo_create(zh_, path.c_str(), data.data(), (int)data.size(), &ZOO_OPEN_ACL_UNSAFE,
+                            mode, buf, sizeof(buf));
+        if (rc == ZOK && created_path) *created_path = buf;
+        return from_zk(rc);
+    }
+
+    CoordRc remove(const std::string &path) override {
+        return from_zk(zoo_delete(zh_, path.c_str(), -1));
+    }
+
+    CoordRc get(const std::string &path, std::string *data) override {
+        char buf[1024];
+        int len = sizeof(buf);
+        int rc = zoo_get(zh_, path.c_str(), 0, buf, &len, nullptr);
+        if (rc == ZOK && data) data->assign(buf, len > 0 ? len : 0);
+        return from_zk(rc);
+    }
+
+    CoordRc exists(const std::string &path, CoordWatch watch) override {
+        if (!watch) return from_zk(zoo_exists(zh_, path.c_str(), 0, nullptr));
+        auto *ctx = new CoordWatch(std::move(watch));
+        int rc = zoo_wexists(zh_, path.c_str(), &ZkCoordinator::watch_trampoline, ctx, nullptr);
+        // ZNONODE still leaves an exists-watch armed for the node's creation
+        if (rc != ZOK && rc != ZNONODE) delete ctx;
+        return from_zk(rc);
+    }
+
+    CoordRc children(const std::string &path, std::vector<std::string> *out,
+                     CoordWatch watch) override {
+        struct String_vector sv;
+        int rc;
+        CoordWatch *ctx = nullptr;
+        if (watch) {
+            ctx = new CoordWatch(std::move(watch));
+            rc = zoo_wget_children(zh_, path.c_str(), &ZkCoordinator::watch_trampoline, ctx, &sv);
+            if (rc != ZOK) delete ctx;
+        } else {
+            rc = zoo_get_children(zh_, path.c_str(), 0, &sv);
+        }
+        if (rc != ZOK) return from_zk(rc);
+        out->clear();
+        for (int i = 0; i < sv.count; ++i) out->emplace_back(sv.data[i]);
+        deallocate_String_vector(&sv);
+        return CoordRc::OK;
+    }
+
+    bool session_expired() override {
+        return !zh_ || zoo_state(zh_) == ZOO_EXPIRED_SESSION_STATE;
+    }
+
+    void on_session_expired(std::function<void()> fn) override {
+        std::lock_guard<std::mutex> lk(mu_);
+        expired_fn_ = std::move(fn);
+    }
+
+    void close() override {
+        zhandle_t *zh;
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            zh = zh_;
+            zh_ = nullptr;
+            expired_fn_ = nullptr;
+        }
+        if (zh) zookeeper_close(zh);
+    }
+
+private:
+    zhandle_t *zh_ = nullptr;
+    std::mutex mu_;
+    std::function<void()> expired_fn_;
+
+    static void session_watcher(zhandle_t *, int type, int state, const char *, void *ctx) {
+        auto *self = static_cast<ZkCoordinator *>(ctx);
+        if (!self || type != ZOO_SESSION_EVENT || state != ZOO_EXPIRED_SESSION_STATE) return;
+        std::function<void()> fn;
+        {
+            std::lock_guard<std::mutex> lk(self->mu_);
+            fn = self->expired_fn_;
+        }
+        std::cerr << "[ZK] Session expired.\n";
+        if (fn) fn();
+    }
+
+    // per-call watches carry their callback as ctx; the client invokes each
+    // watcher exactly once (event, or session expiry/close), so free it here
+    static void watch_trampoline(zhandle_t *, int type, int state, const char *path, void *ctx) {
+        auto *w = static_cast<CoordWatch *>(ctx);
+        if (type == ZOO_SESSION_EVENT && state != ZOO_EXPIRED_SESSION_STATE) return;
+        (*w)(event_from_zk(type), path ? path : "");
+        delete w;
+    }
+};
+
+std::unique_ptr<Coordinator> make_zk_coordinator(const std::string &hosts, int session_timeout_ms) {
+    std::unique_ptr<ZkCoordinator> c(new ZkCoordinator(hosts, session_timeout_ms));
+    if (!c->ok()) {
+        std::cerr << "[ZK] ERROR: Could not connect to ZooKeeper at " << hosts << "\n";
+        return nullptr;
+    }
+    return std::unique_ptr<Coordinator>(c.release());
+}